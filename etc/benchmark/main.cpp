@@ -39,12 +39,27 @@
 //  statement from your version.
 //
 
-#include <hayai/hayai.hpp>
+#include "main.h"
+
+#include <hayai/hayai_main.hpp>
 
 BENCHMARK( libcasm_ir, main, 0, 0 )
 {
 }
 
+int main( int argc, char** argv )
+{
+    libcasm_ir_operation_benchmarks();
+
+    hayai::MainRunner runner;
+    const auto result = runner.ParseArgs( argc, argv );
+    if( result != 0 )
+    {
+        return result;
+    }
+    return runner.Run();
+}
+
 //
 //  Local variables:
 //  mode: c++
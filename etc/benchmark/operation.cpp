@@ -0,0 +1,396 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "main.h"
+
+#include <libcasm-ir/SymbolicExecutionEnvironment>
+
+#include <algorithm>
+#include <deque>
+#include <iostream>
+
+using namespace libcasm_ir;
+
+// Registers one benchmark per annotated relation of every side effect free
+// instruction and builtin, for defined, undef and symbolic operand mixes and
+// for the direct 'execute' of a pre-created operation object as well as the
+// 'Operation::execute( Value::ID, ... )' dispatch. The fixture name is the
+// Value::ID token and the test name encodes the relation type kinds, the
+// operand mix and the path, a table per Value::ID x Type::Kind is produced by
+// running the benchmark with '--output json:<file>'. Defined operands are
+// fixed small samples per type, so every run computes the same results.
+// Symbolic operands are created in a fresh environment for every run of a
+// single iteration, because a repeated term is only a hash-consing lookup.
+
+using Kernel = std::function< void( Constant& res, const Constant* reg ) >;
+
+static Type::Ptr sampleType( const Type::Kind kind )
+{
+    switch( kind )
+    {
+        case Type::Kind::BOOLEAN:   // [fallthrough]
+        case Type::Kind::INTEGER:   // [fallthrough]
+        case Type::Kind::RATIONAL:  // [fallthrough]
+        case Type::Kind::DECIMAL:   // [fallthrough]
+        case Type::Kind::STRING:
+        {
+            return Type::fromID( kind );
+        }
+        case Type::Kind::BINARY:
+        {
+            return libstdhl::Memory::get< BinaryType >( 48 );
+        }
+        default:
+        {
+            return nullptr;
+        }
+    }
+}
+
+template < typename T >
+static Kernel unary( const Type::Ptr& type )
+{
+    const auto operation = libstdhl::Memory::make< T >( type );
+    return [ operation ]( Constant& res, const Constant* reg ) {
+        operation->execute( res, reg[ 0 ] );
+    };
+}
+
+template < typename T >
+static Kernel binary( const Type::Ptr& type )
+{
+    const auto operation = libstdhl::Memory::make< T >( type );
+    return [ operation ]( Constant& res, const Constant* reg ) {
+        operation->execute( res, reg[ 0 ], reg[ 1 ] );
+    };
+}
+
+static Kernel direct( const Value::ID id, const Type::Ptr& type, const std::size_t size )
+{
+    switch( id )
+    {
+        case Value::INV_INSTRUCTION:
+            return unary< InvInstruction >( type );
+        case Value::NOT_INSTRUCTION:
+            return unary< NotInstruction >( type );
+        case Value::ADD_INSTRUCTION:
+            return binary< AddInstruction >( type );
+        case Value::SUB_INSTRUCTION:
+            return binary< SubInstruction >( type );
+        case Value::MUL_INSTRUCTION:
+            return binary< MulInstruction >( type );
+        case Value::DIV_INSTRUCTION:
+            return binary< DivInstruction >( type );
+        case Value::POW_INSTRUCTION:
+            return binary< PowInstruction >( type );
+        case Value::MOD_INSTRUCTION:
+            return binary< ModInstruction >( type );
+        case Value::EQU_INSTRUCTION:
+            return binary< EquInstruction >( type );
+        case Value::NEQ_INSTRUCTION:
+            return binary< NeqInstruction >( type );
+        case Value::LTH_INSTRUCTION:
+            return binary< LthInstruction >( type );
+        case Value::LEQ_INSTRUCTION:
+            return binary< LeqInstruction >( type );
+        case Value::GTH_INSTRUCTION:
+            return binary< GthInstruction >( type );
+        case Value::GEQ_INSTRUCTION:
+            return binary< GeqInstruction >( type );
+        case Value::OR_INSTRUCTION:
+            return binary< OrInstruction >( type );
+        case Value::XOR_INSTRUCTION:
+            return binary< XorInstruction >( type );
+        case Value::AND_INSTRUCTION:
+            return binary< AndInstruction >( type );
+        case Value::IMP_INSTRUCTION:
+            return binary< ImpInstruction >( type );
+        default:
+        {
+            if( id <= Value::BUILTIN )
+            {
+                return nullptr;
+            }
+
+            const auto builtin = Builtin::create( id, type );
+            return [ builtin, size ]( Constant& res, const Constant* reg ) {
+                builtin->execute( res, reg, size );
+            };
+        }
+    }
+}
+
+static Kernel dispatch( const Value::ID id, const Type::Ptr& type, const std::size_t size )
+{
+    return [ id, type, size ]( Constant& res, const Constant* reg ) {
+        Operation::execute( id, type, res, reg, size );
+    };
+}
+
+static Constant sample( const Type::Ptr& type, const std::size_t position )
+{
+    const auto first = position % 2 == 0;
+
+    switch( type->kind() )
+    {
+        case Type::Kind::BOOLEAN:
+        {
+            return BooleanConstant( first );
+        }
+        case Type::Kind::INTEGER:
+        {
+            return IntegerConstant( first ? 7 : 3 );
+        }
+        case Type::Kind::RATIONAL:
+        {
+            return RationalConstant( std::string( first ? "7" : "3" ) );
+        }
+        case Type::Kind::DECIMAL:
+        {
+            return DecimalConstant( first ? 7.5 : 3.0 );
+        }
+        case Type::Kind::STRING:
+        {
+            return StringConstant( std::string( first ? "sample" : "operand" ) );
+        }
+        case Type::Kind::BINARY:
+        {
+            const auto binaryType = std::static_pointer_cast< BinaryType >( type );
+            return BinaryConstant( binaryType, first ? 0x2a : 0x07 );
+        }
+        default:
+        {
+            return Constant::undef( type );
+        }
+    }
+}
+
+static std::vector< Constant > operands(
+    const std::vector< Type::Ptr >& types,
+    const std::string& mix,
+    SymbolicExecutionEnvironment& environment )
+{
+    std::vector< Constant > operands;
+    for( const auto& type : types )
+    {
+        if( mix == "undef" )
+        {
+            operands.emplace_back( Constant::undef( type ) );
+        }
+        else if( mix == "symbolic" and operands.empty() )
+        {
+            operands.emplace_back(
+                SymbolicConstant( type, environment.generateSymbolName(), environment ) );
+        }
+        else
+        {
+            operands.emplace_back( sample( type, operands.size() ) );
+        }
+    }
+    return operands;
+}
+
+class OperationKernel final : public ::hayai::Test
+{
+  public:
+    OperationKernel(
+        const Kernel& kernel, const std::vector< Type::Ptr >& types, const std::string& mix )
+    : m_kernel( kernel )
+    , m_types( types )
+    , m_mix( mix )
+    {
+    }
+
+  protected:
+    void SetUp( void ) override
+    {
+        m_environment = libstdhl::Memory::make< SymbolicExecutionEnvironment >();
+        m_operands = operands( m_types, m_mix, *m_environment );
+    }
+
+    void TearDown( void ) override
+    {
+        m_operands.clear();
+        m_environment.reset();
+    }
+
+    void TestBody( void ) override
+    {
+        Constant res;
+        m_kernel( res, m_operands.data() );
+    }
+
+  private:
+    const Kernel& m_kernel;
+    const std::vector< Type::Ptr >& m_types;
+    const std::string& m_mix;
+    SymbolicExecutionEnvironment::Ptr m_environment;
+    std::vector< Constant > m_operands;
+};
+
+class OperationKernelFactory final : public ::hayai::TestFactory
+{
+  public:
+    OperationKernelFactory(
+        const Kernel& kernel, const std::vector< Type::Ptr >& types, const std::string& mix )
+    : m_kernel( kernel )
+    , m_types( types )
+    , m_mix( mix )
+    {
+    }
+
+    ::hayai::Test* CreateTest( void ) override
+    {
+        return new OperationKernel( m_kernel, m_types, m_mix );
+    }
+
+  private:
+    const Kernel m_kernel;
+    const std::vector< Type::Ptr > m_types;
+    const std::string m_mix;
+};
+
+void libcasm_ir_operation_benchmarks( void )
+{
+    static std::deque< std::string > names;
+
+    for( u8 value = 0; value < Value::_SIZE_; value++ )
+    {
+        const auto id = static_cast< Value::ID >( value );
+
+        const Annotation* annotation = nullptr;
+        try
+        {
+            annotation = &Annotation::find( id );
+        }
+        catch( const std::domain_error& e )
+        {
+            continue;
+        }
+
+        if( not annotation->properties().isSet( Property::SIDE_EFFECT_FREE ) )
+        {
+            continue;
+        }
+
+        for( const auto& relation : annotation->relations() )
+        {
+            auto kinds = Type::token( relation.result ) + "__";
+            std::vector< Type::Ptr > argumentTypes;
+            for( const auto& argument : relation.argument )
+            {
+                kinds += "_" + Type::token( argument );
+                argumentTypes.emplace_back( sampleType( argument ) );
+            }
+
+            const auto resultType = sampleType( relation.result );
+            if( not resultType or
+                std::any_of( argumentTypes.begin(), argumentTypes.end(), []( const Type::Ptr& t ) {
+                    return not t;
+                } ) )
+            {
+                continue;
+            }
+
+            Types types;
+            for( const auto& argumentType : argumentTypes )
+            {
+                types.add( argumentType );
+            }
+            const auto type = libstdhl::Memory::get< RelationType >( resultType, types );
+            const auto size = argumentTypes.size();
+
+            for( const auto& mix : { "defined", "undef", "symbolic" } )
+            {
+                for( const auto& path : { "direct", "dispatch" } )
+                {
+                    try
+                    {
+                        const auto kernel = std::string( path ) == "direct"
+                                                ? direct( id, type, size )
+                                                : dispatch( id, type, size );
+                        if( not kernel )
+                        {
+                            continue;
+                        }
+
+                        // operations which are not implemented for a relation
+                        // or operand mix are reported and not part of the matrix
+                        SymbolicExecutionEnvironment environment;
+                        const auto values = operands( argumentTypes, mix, environment );
+                        Constant res;
+                        kernel( res, values.data() );
+
+                        names.emplace_back( Value::token( id ) );
+                        const auto& fixture = names.back();
+                        names.emplace_back( kinds + "__" + mix + "__" + path );
+                        const auto& test = names.back();
+
+                        const auto symbolic = std::string( mix ) == "symbolic";
+
+                        ::hayai::Benchmarker::RegisterTest(
+                            fixture.c_str(),
+                            test.c_str(),
+                            symbolic ? 1000 : 10,
+                            symbolic ? 1 : 1000,
+                            new OperationKernelFactory( kernel, argumentTypes, mix ),
+                            ::hayai::TestParametersDescriptor() );
+                    }
+                    catch( const std::exception& e )
+                    {
+                        std::cerr << "[ SKIPPED  ] " << Value::token( id ) << "." << kinds
+                                  << "__" << mix << "__" << path << ": " << e.what() << "\n";
+                    }
+                }
+            }
+        }
+    }
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
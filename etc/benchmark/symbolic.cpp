@@ -0,0 +1,212 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "main.h"
+
+#include <libcasm-ir/SymbolicExecutionEnvironment>
+
+#include <iostream>
+#include <set>
+
+using namespace libcasm_ir;
+
+static const auto INTEGER = libstdhl::Memory::get< IntegerType >();
+static const auto BOOLEAN = libstdhl::Memory::get< BooleanType >();
+
+static const auto ARITHMETIC =
+    libstdhl::Memory::get< RelationType >( INTEGER, Types( { INTEGER, INTEGER } ) );
+
+static const auto FUNCTION = libstdhl::Memory::get< RelationType >( INTEGER, Types( { INTEGER } ) );
+
+class SymbolicExecution : public ::hayai::Fixture
+{
+  public:
+    void SetUp( void ) override
+    {
+        m_environment = libstdhl::Memory::make< SymbolicExecutionEnvironment >();
+        m_environment->addFunctionDeclaration( "f", *FUNCTION );
+        m_size = m_environment->size();
+        m_units = 0;
+    }
+
+    void TearDown( void ) override
+    {
+        // the formulae retained by the environment are reported once per
+        // benchmark instance, they do not depend on the run
+        static std::set< std::string > reported;
+
+        if( m_units > 0 )
+        {
+            const auto name = std::string( m_name ) + "/" + std::to_string( m_parameter );
+            if( reported.emplace( name ).second )
+            {
+                const auto size = m_environment->size() - m_size;
+                std::cout << "[ formulae/unit ] " << name << " "
+                          << ( static_cast< double >( size ) / m_units ) << "\n";
+            }
+        }
+        m_environment.reset();
+    }
+
+  protected:
+    SymbolicConstant symbol( const Type::Ptr& type )
+    {
+        return SymbolicConstant( type, m_environment->generateSymbolName(), *m_environment );
+    }
+
+    /**
+       records the units of work of one iteration, an iteration repeats the
+       benchmark body on the same environment
+     */
+    void record( const char* name, const std::size_t parameter, const std::size_t units )
+    {
+        m_name = name;
+        m_parameter = parameter;
+        m_units += units;
+    }
+
+    SymbolicExecutionEnvironment::Ptr m_environment;
+    const char* m_name;
+    std::size_t m_parameter;
+    std::size_t m_units;
+    std::size_t m_size;
+};
+
+BENCHMARK_F( SymbolicExecution, create_symbolic_constant, 10, 1000 )
+{
+    symbol( INTEGER );
+    record( "create_symbolic_constant", 0, 1 );
+}
+
+BENCHMARK_P_F( SymbolicExecution, arithmetic_chain, 10, 10, ( std::size_t depth ) )
+{
+    const AddInstruction add( ARITHMETIC );
+    const MulInstruction mul( ARITHMETIC );
+
+    Constant value = symbol( INTEGER );
+    const Constant other = symbol( INTEGER );
+
+    for( std::size_t i = 0; i < depth; i++ )
+    {
+        Constant tmp;
+        add.execute( tmp, value, IntegerConstant( static_cast< i64 >( i + 2 ) ) );
+        mul.execute( value, tmp, other );
+    }
+    record( "arithmetic_chain", depth, depth );
+}
+
+BENCHMARK_P_INSTANCE( SymbolicExecution, arithmetic_chain, ( 1 ) );
+BENCHMARK_P_INSTANCE( SymbolicExecution, arithmetic_chain, ( 10 ) );
+BENCHMARK_P_INSTANCE( SymbolicExecution, arithmetic_chain, ( 100 ) );
+BENCHMARK_P_INSTANCE( SymbolicExecution, arithmetic_chain, ( 1000 ) );
+
+BENCHMARK_P_F( SymbolicExecution, merge_symbol_paths, 10, 100, ( std::size_t nesting ) )
+{
+    std::vector< SymbolicExecutionEnvironment::ScopedEnvironment::Ptr > scopes;
+    for( std::size_t i = 0; i < nesting; i++ )
+    {
+        const auto condition = m_environment->tptpAtomFromConstant( symbol( BOOLEAN ) );
+        scopes.emplace_back( m_environment->makeEnvironment( condition ) );
+    }
+
+    const auto condition = m_environment->tptpAtomFromConstant( symbol( BOOLEAN ) );
+    m_environment->mergeSymbolPaths( condition, symbol( INTEGER ), symbol( INTEGER ) );
+    record( "merge_symbol_paths", nesting, 1 );
+}
+
+BENCHMARK_P_INSTANCE( SymbolicExecution, merge_symbol_paths, ( 0 ) );
+BENCHMARK_P_INSTANCE( SymbolicExecution, merge_symbol_paths, ( 4 ) );
+BENCHMARK_P_INSTANCE( SymbolicExecution, merge_symbol_paths, ( 16 ) );
+BENCHMARK_P_INSTANCE( SymbolicExecution, merge_symbol_paths, ( 64 ) );
+
+BENCHMARK_P_F( SymbolicExecution, location_get_set, 10, 10, ( std::size_t locations ) )
+{
+    for( std::size_t i = 0; i < locations; i++ )
+    {
+        const std::vector< Constant > arguments = { IntegerConstant( static_cast< i64 >( i ) ) };
+        const auto value = m_environment->get( "f", FUNCTION, arguments );
+        m_environment->set( "f", FUNCTION, arguments, value.name() );
+    }
+    record( "location_get_set", locations, locations );
+}
+
+BENCHMARK_P_INSTANCE( SymbolicExecution, location_get_set, ( 10 ) );
+BENCHMARK_P_INSTANCE( SymbolicExecution, location_get_set, ( 100 ) );
+BENCHMARK_P_INSTANCE( SymbolicExecution, location_get_set, ( 1000 ) );
+BENCHMARK_P_INSTANCE( SymbolicExecution, location_get_set, ( 10000 ) );
+
+BENCHMARK_P_F( SymbolicExecution, trace_finalize, 10, 1, ( std::size_t steps ) )
+{
+    const AddInstruction add( ARITHMETIC );
+
+    for( std::size_t step = 0; step < steps; step++ )
+    {
+        for( std::size_t i = 0; i < 8; i++ )
+        {
+            const std::vector< Constant > arguments = {
+                IntegerConstant( static_cast< i64 >( i ) ),
+            };
+            const auto value = m_environment->get( "f", FUNCTION, arguments );
+
+            Constant next;
+            add.execute( next, value, IntegerConstant( 1 ) );
+            m_environment->set( "f", FUNCTION, arguments, next.name() );
+        }
+        m_environment->incrementTime();
+    }
+    record( "trace_finalize", steps, steps );
+
+    m_environment->finalize();
+}
+
+BENCHMARK_P_INSTANCE( SymbolicExecution, trace_finalize, ( 10 ) );
+BENCHMARK_P_INSTANCE( SymbolicExecution, trace_finalize, ( 100 ) );
+BENCHMARK_P_INSTANCE( SymbolicExecution, trace_finalize, ( 1000 ) );
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
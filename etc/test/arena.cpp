@@ -0,0 +1,120 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "main.h"
+
+using namespace libcasm_ir;
+using namespace libstdhl;
+
+static const auto VOID = Memory::make< VoidType >();
+
+TEST( libcasm_ir__arena, allocate_aligned )
+{
+    Arena arena( 64 );
+
+    for( std::size_t i = 1; i < 100; i++ )
+    {
+        const auto ptr = arena.allocate( i, alignof( u64 ) );
+        EXPECT_EQ( reinterpret_cast< std::uintptr_t >( ptr ) % alignof( u64 ), 0 );
+    }
+
+    EXPECT_GT( arena.chunks(), 1 );
+}
+
+TEST( libcasm_ir__arena, specification_nodes )
+{
+    auto arena = Memory::make< Arena >();
+    std::weak_ptr< Arena > observer = arena;
+
+    Statement::Ptr stmt;
+    {
+        auto specification = Memory::make< Specification >( TEST_NAME );
+        specification->setArena( arena );
+        arena.reset();
+
+        const Arena::Scope scope( specification->arena() );
+
+        auto rule = specification->add< Rule >( TEST_NAME, VOID );
+        rule->setContext( ParallelBlock::create() );
+
+        stmt = rule->context()->add< TrivialStatement >();
+        stmt->add< SkipInstruction >();
+
+        EXPECT_GT( specification->arena()->size(), 0 );
+    }
+
+    EXPECT_FALSE( observer.expired() );
+    EXPECT_EQ( stmt->instructions().size(), 1 );
+
+    stmt.reset();
+    EXPECT_TRUE( observer.expired() );
+}
+
+TEST( libcasm_ir__arena, nested_scopes )
+{
+    const auto outer = Memory::make< Arena >();
+    const auto inner = Memory::make< Arena >();
+
+    EXPECT_EQ( Arena::active(), nullptr );
+    {
+        const Arena::Scope outerScope( outer );
+        EXPECT_EQ( Arena::active(), outer );
+        {
+            const Arena::Scope innerScope( inner );
+            EXPECT_EQ( Arena::active(), inner );
+
+            const Arena::Scope heapScope( nullptr );
+            EXPECT_EQ( Arena::active(), nullptr );
+        }
+        EXPECT_EQ( Arena::active(), outer );
+    }
+    EXPECT_EQ( Arena::active(), nullptr );
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -112,6 +112,49 @@ TEST( libcasm_ir__constant_string, create_foobarqux )
     libcasm_ir__constant_string_test( "foobarqux" );
 }
 
+TEST( libcasm_ir__constant_string, concat_short )
+{
+    const StringConstant foo( "foo" );
+    const StringConstant bar( "bar" );
+
+    const auto v = foo.concat( bar );
+
+    EXPECT_STREQ( v.name().c_str(), "foobar" );
+    EXPECT_EQ( v.length(), (std::size_t)6 );
+    EXPECT_TRUE( v == StringConstant( "foobar" ) );
+    EXPECT_EQ( v.hash(), StringConstant( "foobar" ).hash() );
+    EXPECT_STREQ( foo.name().c_str(), "foo" );
+}
+
+TEST( libcasm_ir__constant_string, concat_accumulate )
+{
+    std::string expected = "";
+    StringConstant v( expected );
+
+    for( std::size_t index = 0; index < 1000; index++ )
+    {
+        const auto line = "line " + std::to_string( index ) + "\n";
+        expected += line;
+        v = v.concat( StringConstant( line ) );
+    }
+
+    const StringConstant flat( expected );
+
+    EXPECT_EQ( v.length(), expected.size() );
+    EXPECT_TRUE( v.value() == expected );
+    EXPECT_TRUE( v == flat );
+    EXPECT_TRUE( flat == v );
+    EXPECT_EQ( v.hash(), flat.hash() );
+
+    const Constant copy = v;
+    EXPECT_TRUE( copy == flat );
+
+    const auto other = v.concat( StringConstant( "!" ) );
+    EXPECT_FALSE( other == flat );
+    EXPECT_NE( other.hash(), flat.hash() );
+    EXPECT_TRUE( v == flat );
+}
+
 //
 //  Local variables:
 //  mode: c++
@@ -0,0 +1,198 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "main.h"
+
+using namespace libcasm_ir;
+using namespace libstdhl;
+
+static std::vector< Constant > collect( const Type& type )
+{
+    std::vector< Constant > constants;
+    type.foreach(
+        [&constants]( const Constant& constant ) { constants.emplace_back( constant ); } );
+    return constants;
+}
+
+static std::vector< Constant > collect( DomainCursor& cursor, std::size_t& chunks )
+{
+    std::vector< Constant > constants;
+    chunks = 0;
+
+    while( cursor.next() )
+    {
+        chunks++;
+        for( const auto& constant : cursor )
+        {
+            constants.emplace_back( constant );
+        }
+    }
+
+    return constants;
+}
+
+static RangeType::Ptr range( const i64 from, const i64 to )
+{
+    const auto a = Memory::make< IntegerConstant >( from );
+    const auto b = Memory::make< IntegerConstant >( to );
+    return Memory::make< RangeType >( Memory::make< Range >( a, b ) );
+}
+
+TEST( libcasm_ir_DomainCursor, ranged_integer )
+{
+    const auto type = Memory::make< IntegerType >( range( -4, 13 ) );
+
+    DomainCursor cursor( type, 5 );
+    std::size_t chunks = 0;
+    const auto constants = collect( cursor, chunks );
+
+    EXPECT_EQ( chunks, 4 );
+    EXPECT_EQ( constants, collect( *type ) );
+    ASSERT_EQ( constants.size(), 18 );
+    EXPECT_EQ( constants.front(), IntegerConstant( -4 ) );
+    EXPECT_EQ( constants.back(), IntegerConstant( 13 ) );
+    EXPECT_FALSE( cursor.next() );
+    EXPECT_EQ( cursor.size(), 0 );
+}
+
+TEST( libcasm_ir_DomainCursor, range_upper_limit )
+{
+    const auto max = std::numeric_limits< i64 >::max();
+    const auto type = range( max - 2, max );
+
+    DomainCursor cursor( type, 2 );
+    std::size_t chunks = 0;
+    const auto constants = collect( cursor, chunks );
+
+    EXPECT_EQ( chunks, 2 );
+    EXPECT_EQ( constants, collect( *type ) );
+    ASSERT_EQ( constants.size(), 3 );
+    EXPECT_EQ( constants.back(), IntegerConstant( max ) );
+}
+
+TEST( libcasm_ir_DomainCursor, enumeration )
+{
+    const std::vector< std::string > elements = { "foo", "bar", "baz" };
+    const auto type =
+        Memory::make< EnumerationType >( Memory::make< Enumeration >( "example", elements ) );
+
+    DomainCursor cursor( type );
+    std::size_t chunks = 0;
+    const auto constants = collect( cursor, chunks );
+
+    EXPECT_EQ( chunks, 1 );
+    EXPECT_EQ( constants, collect( *type ) );
+    ASSERT_EQ( constants.size(), elements.size() );
+    for( std::size_t index = 0; index < elements.size(); index++ )
+    {
+        EXPECT_EQ( constants[ index ], EnumerationConstant( type, elements[ index ] ) );
+    }
+}
+
+TEST( libcasm_ir_DomainCursor, split )
+{
+    const auto type = range( -4, 13 );
+    const DomainCursor cursor( type, 4 );
+    ASSERT_TRUE( cursor.countable() );
+    EXPECT_EQ( cursor.count(), 18 );
+
+    auto parts = cursor.split( 4 );
+    ASSERT_EQ( parts.size(), 4 );
+
+    std::vector< Constant > constants;
+    for( auto& part : parts )
+    {
+        std::size_t chunks = 0;
+        const auto partition = collect( part, chunks );
+        EXPECT_EQ( partition.size(), part.count() );
+        EXPECT_GE( part.count(), 4 );
+        EXPECT_LE( part.count(), 5 );
+        constants.insert( constants.end(), partition.begin(), partition.end() );
+    }
+
+    EXPECT_EQ( constants, collect( *type ) );
+    EXPECT_EQ( cursor.split( 100 ).size(), 18 );
+}
+
+TEST( libcasm_ir_DomainCursor, split_enumeration_domain )
+{
+    const std::vector< std::string > elements = { "foo", "bar", "baz" };
+    const auto type =
+        Memory::make< EnumerationType >( Memory::make< Enumeration >( "example", elements ) );
+    const DomainConstant domain( type );
+
+    const DomainCursor cursor( domain );
+    auto parts = cursor.split( 2 );
+    ASSERT_EQ( parts.size(), 2 );
+
+    std::size_t chunks = 0;
+    const auto first = collect( parts[ 0 ], chunks );
+    const auto second = collect( parts[ 1 ], chunks );
+    ASSERT_EQ( first.size(), 2 );
+    ASSERT_EQ( second.size(), 1 );
+    EXPECT_EQ( second[ 0 ], EnumerationConstant( type, "baz" ) );
+}
+
+TEST( libcasm_ir_DomainCursor, reset )
+{
+    const auto type = Memory::make< BooleanType >();
+
+    DomainCursor cursor( type, 1 );
+    ASSERT_TRUE( cursor.next() );
+    EXPECT_EQ( cursor[ 0 ], BooleanConstant( false ) );
+    ASSERT_TRUE( cursor.next() );
+    EXPECT_EQ( cursor[ 0 ], BooleanConstant( true ) );
+    EXPECT_FALSE( cursor.next() );
+
+    cursor.reset();
+    ASSERT_TRUE( cursor.next() );
+    EXPECT_EQ( cursor[ 0 ], BooleanConstant( false ) );
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -0,0 +1,121 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "main.h"
+
+using namespace libcasm_ir;
+using namespace libstdhl;
+
+static const auto INTEGER = Memory::get< IntegerType >();
+
+static Derived::Ptr derived( const std::string& name )
+{
+    auto type = Memory::make< RelationType >( INTEGER, Types( { INTEGER } ) );
+    auto derived = Memory::make< Derived >( name, type );
+    auto stmt = Memory::make< TrivialStatement >();
+    derived->setContext( stmt );
+    return derived;
+}
+
+TEST( libcasm_ir_MemoTable, memoizable )
+{
+    auto pure = derived( "pure" );
+    const auto cst = Memory::make< IntegerConstant >( 1 );
+    pure->context()->add< AddInstruction >( cst, cst );
+    EXPECT_TRUE( MemoTable::memoizable( *pure ) );
+
+    auto print = derived( "print" );
+    const auto type = Memory::make< RelationType >(
+        Memory::get< VoidType >(), Types( { Memory::get< StringType >() } ) );
+    print->context()->add< CallInstruction >(
+        Builtin::create( Value::PRINTLN_BUILTIN, type ),
+        std::vector< Value::Ptr >{ Memory::make< StringConstant >( "foo" ) } );
+    EXPECT_FALSE( MemoTable::memoizable( *print ) );
+
+    auto caller = derived( "caller" );
+    caller->context()->add< CallInstruction >( print );
+    EXPECT_FALSE( MemoTable::memoizable( *caller ) );
+}
+
+TEST( libcasm_ir_MemoTable, evaluate_and_invalidate )
+{
+    MemoTable memo;
+    auto d = derived( "d" );
+
+    std::size_t computed = 0;
+    const auto compute = [&computed]( void ) -> Constant {
+        computed++;
+        return IntegerConstant( 42 );
+    };
+
+    const Constant one = IntegerConstant( 1 );
+    const Constant two = IntegerConstant( 2 );
+
+    EXPECT_EQ( memo.lookup( *d, &one, 1 ), nullptr );
+    EXPECT_TRUE( memo.evaluate( *d, &one, 1, compute ) == IntegerConstant( 42 ) );
+    EXPECT_TRUE( memo.evaluate( *d, &one, 1, compute ) == IntegerConstant( 42 ) );
+    EXPECT_TRUE( memo.evaluate( *d, &two, 1, compute ) == IntegerConstant( 42 ) );
+
+    EXPECT_EQ( computed, 2 );
+    EXPECT_EQ( memo.hits(), 1 );
+    EXPECT_EQ( memo.misses(), 2 );
+    EXPECT_EQ( memo.size(), 2 );
+    ASSERT_NE( memo.lookup( *d, &one, 1 ), nullptr );
+
+    memo.invalidate();
+
+    EXPECT_EQ( memo.step(), 1 );
+    EXPECT_EQ( memo.size(), 0 );
+    EXPECT_EQ( memo.lookup( *d, &one, 1 ), nullptr );
+
+    memo.evaluate( *d, &one, 1, compute );
+    EXPECT_EQ( computed, 3 );
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
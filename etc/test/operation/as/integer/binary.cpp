@@ -55,6 +55,15 @@ static const auto id = Value::ID::AS_INTEGER_BUILTIN;
         Constant res;                                                   \
         Operation::execute( id, *type, res, &arg, 1 );                  \
         EXPECT_TRUE( res == IntegerConstant( TO ) );                    \
+        const auto builtin = Builtin::create( id, type );               \
+        ASSERT_TRUE( builtin->kernel() != nullptr );                    \
+        Constant builtinRes;                                            \
+        builtin->execute( builtinRes, &arg, 1 );                        \
+        EXPECT_TRUE( builtinRes == res );                               \
+        const CallInstruction call( builtin, {} );                      \
+        Constant callRes;                                               \
+        call.execute( callRes, &arg, 1 );                               \
+        EXPECT_TRUE( callRes == res );                                  \
     }
 
 TEST_( undef_at_undef, 1, , ( 1 ) );
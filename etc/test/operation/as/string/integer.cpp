@@ -63,6 +63,7 @@ TEST_( pos1__at_pos1, "1", 1 );
 TEST_( neg1__at_neg1, "-1", -1 );
 TEST_( posX__at_posX, "123456789", 123456789 );
 TEST_( negX__at_negX, "123456789", 123456789 );
+TEST_( max___at_max_, "9223372036854775807", ( i64 )( 0x7fffffffffffffff ) );
 
 //
 //  Local variables:
@@ -0,0 +1,92 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "../main.h"
+
+using namespace libcasm_ir;
+
+static const auto type = libstdhl::Memory::get< RelationType >(
+    libstdhl::Memory::get< StringType >(), Types( { libstdhl::Memory::get< IntegerType >() } ) );
+
+#define TEST_( NAME, KIND, TO, FROM )                                                          \
+    TEST( libcasm_ir__builtin_stringify, NAME )                                                \
+    {                                                                                          \
+        const auto arg = IntegerConstant( FROM );                                              \
+        Constant res;                                                                          \
+        Operation::execute( Value::ID::KIND, *type, res, &arg, 1 );                            \
+        EXPECT_STREQ( res.description().c_str(), StringConstant( TO ).description().c_str() ); \
+        const auto builtin = Builtin::create( Value::ID::KIND, type );                         \
+        ASSERT_TRUE( builtin->kernel() != nullptr );                                           \
+        Constant builtinRes;                                                                   \
+        builtin->execute( builtinRes, &arg, 1 );                                               \
+        EXPECT_TRUE( builtinRes == res );                                                      \
+        const CallInstruction call( builtin, {} );                                             \
+        Constant callRes;                                                                      \
+        call.execute( callRes, &arg, 1 );                                                      \
+        EXPECT_TRUE( callRes == res );                                                         \
+    }
+
+TEST_( dec_undef, DEC_BUILTIN, , );
+TEST_( dec_zero, DEC_BUILTIN, "0", 0 );
+TEST_( dec_pos, DEC_BUILTIN, "1234567", 1234567 );
+TEST_( dec_neg, DEC_BUILTIN, "-42", -42 );
+
+TEST_( hex_zero, HEX_BUILTIN, "0", 0 );
+TEST_( hex_pos, HEX_BUILTIN, "123", 0x123 );
+TEST_( hex_large, HEX_BUILTIN, "1234567890123", 0x1234567890123 );
+
+TEST_( oct_zero, OCT_BUILTIN, "0", 0 );
+TEST_( oct_pos, OCT_BUILTIN, "10", 8 );
+TEST_( oct_large, OCT_BUILTIN, "1234567", 01234567 );
+
+TEST_( bin_zero, BIN_BUILTIN, "0", 0 );
+TEST_( bin_pos, BIN_BUILTIN, "101", 5 );
+TEST_( bin_large, BIN_BUILTIN, "1000000000000000000000000000000000000000", ( (i64)1 << 39 ) );
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
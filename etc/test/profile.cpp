@@ -0,0 +1,193 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "main.h"
+
+#include <sstream>
+
+using namespace libcasm_ir;
+using namespace libstdhl;
+
+static const auto VOID = Memory::get< VoidType >();
+static const auto INTEGER = Memory::get< IntegerType >();
+
+static Rule::Ptr rule( const std::string& name )
+{
+    auto rule = Memory::make< Rule >( name, Memory::make< RelationType >( VOID ) );
+    rule->setContext( ParallelBlock::create() );
+    return rule;
+}
+
+TEST( libcasm_ir_Profile, instruction_counter )
+{
+    Profile profile;
+
+    auto r = rule( TEST_NAME );
+    auto stmt = r->context()->add< TrivialStatement >();
+    auto add = stmt->add< AddInstruction >(
+        Memory::make< IntegerConstant >( 1 ), Memory::make< IntegerConstant >( 2 ) );
+    auto skip = stmt->add< SkipInstruction >();
+
+    EXPECT_EQ( profile.find( *add ), nullptr );
+    EXPECT_EQ( profile.heat( *add ), 0.0 );
+
+    auto& counter = profile.counter( *add );
+    EXPECT_EQ( &profile.counter( *add ), &counter );
+
+    for( u64 c = 0; c < 4; c++ )
+    {
+        counter.record( 10 );
+    }
+    profile.counter( *skip ).record( 5 );
+
+    EXPECT_EQ( profile.size(), (std::size_t)2 );
+    EXPECT_EQ( profile.find( *add ), &counter );
+    EXPECT_EQ( counter.executions(), (u64)4 );
+    EXPECT_EQ( counter.cycles(), (u64)40 );
+    EXPECT_EQ( profile.maximum(), (u64)4 );
+    EXPECT_EQ( profile.heat( *add ), 1.0 );
+    EXPECT_EQ( profile.heat( *skip ), 0.25 );
+    EXPECT_STREQ(
+        profile.annotation( *skip, profile.maximum() ).c_str(),
+        "heat = 0.25, executions = 1, cycles = 5" );
+
+    profile.clear();
+    EXPECT_EQ( profile.size(), (std::size_t)0 );
+    EXPECT_EQ( profile.find( *add ), nullptr );
+}
+
+TEST( libcasm_ir_Profile, branch_histogram )
+{
+    Profile profile;
+
+    auto r = rule( TEST_NAME );
+    auto br = r->context()->add< BranchStatement >();
+    br->add( ParallelBlock::create() )->add< TrivialStatement >()->add< SkipInstruction >();
+    br->add( ParallelBlock::create() )->add< TrivialStatement >()->add< SkipInstruction >();
+
+    auto& counter = profile.counter( *br );
+    ASSERT_EQ( counter.targets(), (std::size_t)3 );
+
+    counter.record( 0 );
+    counter.record( 0 );
+    counter.record( 2 );
+
+    EXPECT_EQ( counter.counter().executions(), (u64)3 );
+    EXPECT_EQ( counter.taken( 0 ), (u64)2 );
+    EXPECT_EQ( counter.taken( 1 ), (u64)0 );
+    EXPECT_EQ( counter.taken( 2 ), (u64)1 );
+    EXPECT_EQ( profile.heat( *br ), 1.0 );
+    EXPECT_STREQ(
+        profile.annotation( *br, 6 ).c_str(),
+        "heat = 0.50, executions = 3, cycles = 0, taken = {2, 0, 1}" );
+}
+
+TEST( libcasm_ir_Profile, sample_and_scope )
+{
+    Profile profile;
+
+    auto r = rule( TEST_NAME );
+    auto skip = r->context()->add< TrivialStatement >()->add< SkipInstruction >();
+
+    EXPECT_EQ( Profile::active(), nullptr );
+    {
+        Profile::Scope scope( profile );
+        EXPECT_EQ( Profile::active(), &profile );
+
+        Profile::Sample sample( Profile::active()->counter( *skip ) );
+    }
+    EXPECT_EQ( Profile::active(), nullptr );
+
+    EXPECT_EQ( profile.find( *skip )->executions(), (u64)1 );
+}
+
+TEST( libcasm_ir_Profile, call_instruction )
+{
+    Profile profile;
+
+    const auto type = Memory::get< RelationType >(
+        INTEGER, Types( { Memory::get< BooleanType >() } ) );
+    const CallInstruction call( Builtin::create( Value::AS_INTEGER_BUILTIN, type ), {} );
+
+    const BooleanConstant arg( true );
+    Constant res;
+
+    call.execute( res, &arg, 1 );
+    EXPECT_EQ( profile.find( call ), nullptr );
+
+    {
+        Profile::Scope scope( profile );
+        call.execute( res, &arg, 1 );
+        call.execute( res, &arg, 1 );
+    }
+
+    ASSERT_NE( profile.find( call ), nullptr );
+    EXPECT_EQ( profile.find( call )->executions(), (u64)2 );
+    EXPECT_TRUE( res == IntegerConstant( 1 ) );
+}
+
+TEST( libcasm_ir_Profile, dump_heat )
+{
+    Profile profile;
+
+    auto r = rule( TEST_NAME );
+    auto skip = r->context()->add< TrivialStatement >()->add< SkipInstruction >();
+    profile.counter( *skip ).record();
+
+    std::ostringstream stream;
+    {
+        IRDumpSourceVisitor dump( stream );
+        dump.setProfile( &profile );
+        dump.visit( *r );
+    }
+
+    EXPECT_NE( stream.str().find( "heat = 1.00, executions = 1" ), std::string::npos );
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
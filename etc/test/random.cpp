@@ -0,0 +1,195 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "main.h"
+
+using namespace libcasm_ir;
+using namespace libstdhl;
+
+static RangeType::Ptr range( const i64 from, const i64 to )
+{
+    const auto a = Memory::make< IntegerConstant >( from );
+    const auto b = Memory::make< IntegerConstant >( to );
+    return Memory::make< RangeType >( Memory::make< Range >( a, b ) );
+}
+
+TEST( libcasm_ir_RandomStream, same_seed_reproduces_sequence )
+{
+    RandomStream a( 42 );
+    RandomStream b( 42 );
+    RandomStream c( 43 );
+
+    u1 different = false;
+    for( std::size_t index = 0; index < 100; index++ )
+    {
+        const auto value = a.next();
+        EXPECT_EQ( value, b.next() );
+        different |= ( value != c.next() );
+    }
+
+    EXPECT_TRUE( different );
+    EXPECT_EQ( a.counter(), (u64)100 );
+}
+
+TEST( libcasm_ir_RandomStream, fork_is_independent )
+{
+    RandomStream stream( 42 );
+    auto first = stream.fork( 0 );
+    auto second = stream.fork( 1 );
+
+    EXPECT_EQ( first.seed(), stream.seed() );
+    EXPECT_NE( first.stream(), second.stream() );
+    EXPECT_NE( first.next(), second.next() );
+
+    auto again = stream.fork( 1 );
+    EXPECT_EQ( again.at( 0 ), second.at( 0 ) );
+    EXPECT_EQ( stream.counter(), (u64)0 );
+}
+
+TEST( libcasm_ir_RandomStream, fork_differs_from_parent )
+{
+    for( const u64 id : { 0, 1, 42 } )
+    {
+        RandomStream parent( 7, id );
+        auto child = parent.fork( 0 );
+
+        EXPECT_NE( child.stream(), parent.stream() );
+        EXPECT_NE( child.at( 0 ), parent.at( 0 ) );
+        EXPECT_NE( child.fork( 0 ).stream(), child.stream() );
+    }
+}
+
+TEST( libcasm_ir_RandomStream, fill_equals_sequential_next )
+{
+    RandomStream batch( 7 );
+    RandomStream sequential( 7 );
+
+    std::vector< u64 > values( 33 );
+    batch.fill( values.data(), values.size() );
+
+    for( const auto value : values )
+    {
+        EXPECT_EQ( value, sequential.next() );
+    }
+
+    EXPECT_EQ( batch.counter(), sequential.counter() );
+    EXPECT_EQ( batch.next(), sequential.next() );
+}
+
+TEST( libcasm_ir_RandomStream, uniform_respects_bounds )
+{
+    RandomStream stream( 1 );
+
+    std::vector< i64 > values( 1000 );
+    stream.uniform( -3, 3, values.data(), values.size() );
+
+    for( const auto value : values )
+    {
+        EXPECT_GE( value, -3 );
+        EXPECT_LE( value, 3 );
+    }
+
+    EXPECT_EQ( stream.uniform( 5, 5 ), 5 );
+    EXPECT_LT( stream.uniform( (u64)10 ), 10 );
+
+    const auto real = stream.real();
+    EXPECT_GE( real, 0.0 );
+    EXPECT_LT( real, 1.0 );
+}
+
+TEST( libcasm_ir_RandomStream, choose_under_scope_is_reproducible )
+{
+    const auto type = range( -10, 10 );
+
+    std::vector< Constant > first;
+    std::vector< Constant > second;
+
+    for( auto* results : { &first, &second } )
+    {
+        RandomStream stream( 1234 );
+        RandomStream::Scope scope( stream );
+
+        for( std::size_t index = 0; index < 50; index++ )
+        {
+            results->emplace_back( type->choose() );
+        }
+    }
+
+    EXPECT_EQ( RandomStream::active(), nullptr );
+    ASSERT_EQ( first.size(), second.size() );
+
+    for( std::size_t index = 0; index < first.size(); index++ )
+    {
+        EXPECT_TRUE( first[ index ] == second[ index ] );
+
+        i64 value = 0;
+        ASSERT_TRUE( DomainCursor::native( first[ index ], value ) );
+        EXPECT_GE( value, -10 );
+        EXPECT_LE( value, 10 );
+    }
+}
+
+TEST( libcasm_ir_RandomStream, batch_choose_enumeration )
+{
+    const std::vector< std::string > elements = { "red", "green", "blue" };
+    const auto type =
+        Memory::make< EnumerationType >( Memory::make< Enumeration >( "color", elements ) );
+
+    RandomStream stream( 99 );
+
+    std::vector< Constant > results( 64, VoidConstant() );
+    stream.choose( *type, results.data(), results.size() );
+
+    for( const auto& result : results )
+    {
+        EXPECT_TRUE( isa< EnumerationConstant >( result ) );
+    }
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -0,0 +1,139 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "main.h"
+
+#include <sstream>
+
+using namespace libcasm_ir;
+
+static const auto type = libstdhl::Memory::get< RelationType >(
+    libstdhl::Memory::get< VoidType >(), Types( { libstdhl::Memory::get< StringType >() } ) );
+
+static void print( const Value::ID id, const std::string& text )
+{
+    const auto arg = StringConstant( text );
+    Constant res;
+    Operation::execute( id, *type, res, &arg, 1 );
+    EXPECT_TRUE( res == VoidConstant() );
+}
+
+TEST( libcasm_ir_OutputSink, capture_print_builtins )
+{
+    std::ostringstream capture;
+    OutputSink sink( capture );
+
+    testing::internal::CaptureStdout();
+    {
+        OutputSink::Scope scope( sink );
+        EXPECT_EQ( OutputSink::active(), &sink );
+
+        print( Value::PRINT_BUILTIN, "foo" );
+        print( Value::PRINTLN_BUILTIN, "bar" );
+    }
+    const auto output = testing::internal::GetCapturedStdout();
+
+    EXPECT_EQ( OutputSink::active(), nullptr );
+    EXPECT_STREQ( output.c_str(), "" );
+    EXPECT_EQ( sink.size(), (std::size_t)7 );
+    EXPECT_STREQ( capture.str().c_str(), "" );
+
+    sink.flush();
+    EXPECT_EQ( sink.size(), (std::size_t)0 );
+    EXPECT_STREQ( capture.str().c_str(), "foobar\n" );
+}
+
+TEST( libcasm_ir_OutputSink, flush_in_order )
+{
+    std::ostringstream capture;
+    OutputSink sink( capture );
+
+    for( const u64 order : { 2, 0, 1, 0 } )
+    {
+        OutputSink::Scope scope( sink, order );
+        print( Value::PRINT_BUILTIN, std::to_string( order ) );
+    }
+
+    sink.flush();
+    EXPECT_STREQ( capture.str().c_str(), "0012" );
+}
+
+TEST( libcasm_ir_OutputSink, redirect )
+{
+    std::ostringstream first;
+    std::ostringstream second;
+    OutputSink sink( first );
+
+    sink.write( "foo" );
+    sink.redirect( second );
+    sink.write( "bar" );
+    sink.flush();
+
+    EXPECT_STREQ( first.str().c_str(), "foo" );
+    EXPECT_STREQ( second.str().c_str(), "bar" );
+    EXPECT_EQ( &sink.stream(), &second );
+}
+
+TEST( libcasm_ir_OutputSink, write_string_rope )
+{
+    std::ostringstream capture;
+    OutputSink sink( capture );
+
+    const auto text = StringConstant( std::string( 100, 'a' ) ).concat( StringConstant( "b" ) );
+
+    sink.write( text );
+    sink.write( StringConstant() );
+    EXPECT_EQ( sink.size(), text.length() + StringConstant().toString().size() );
+
+    sink.flush();
+    const auto expected = text.toString() + StringConstant().toString();
+    EXPECT_STREQ( capture.str().c_str(), expected.c_str() );
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -0,0 +1,406 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "main.h"
+
+#include <libcasm-ir/SymbolicExecutionEnvironment>
+
+using namespace libcasm_ir;
+using namespace libstdhl;
+
+static const auto INTEGER = Memory::get< IntegerType >();
+static const auto BOOLEAN = Memory::get< BooleanType >();
+
+static const auto ARITHMETIC =
+    Memory::get< RelationType >( INTEGER, Types( { INTEGER, INTEGER } ) );
+static const auto FUNCTION = Memory::get< RelationType >( INTEGER, Types( { INTEGER } ) );
+static const auto NULLARY = Memory::get< RelationType >( INTEGER, Types() );
+static const auto LOGICAL = Memory::get< RelationType >( BOOLEAN, Types( { BOOLEAN, BOOLEAN } ) );
+
+static SymbolicConstant symbol( SymbolicExecutionEnvironment& env, const Type::Ptr& type )
+{
+    return SymbolicConstant( type, env.generateSymbolName(), env );
+}
+
+TEST( libcasm_ir_SymbolicExecutionEnvironment, simplify_arithmetic_identities )
+{
+    SymbolicExecutionEnvironment env;
+    const Constant x = symbol( env, INTEGER );
+    const auto size = env.size();
+
+    const AddInstruction add( ARITHMETIC );
+    const SubInstruction sub( ARITHMETIC );
+    const MulInstruction mul( ARITHMETIC );
+
+    Constant res;
+    add.execute( res, x, IntegerConstant( 0 ) );
+    EXPECT_TRUE( res == x );
+    add.execute( res, IntegerConstant( 0 ), x );
+    EXPECT_TRUE( res == x );
+    sub.execute( res, x, x );
+    EXPECT_TRUE( res == IntegerConstant( 0 ) );
+    mul.execute( res, IntegerConstant( 1 ), x );
+    EXPECT_TRUE( res == x );
+    mul.execute( res, x, IntegerConstant( 0 ) );
+    EXPECT_TRUE( res == IntegerConstant( 0 ) );
+
+    EXPECT_EQ( env.size(), size );
+}
+
+TEST( libcasm_ir_SymbolicExecutionEnvironment, simplify_logical_identities )
+{
+    SymbolicExecutionEnvironment env;
+    const Constant p = symbol( env, BOOLEAN );
+    const auto size = env.size();
+
+    const AndInstruction land( LOGICAL );
+    const OrInstruction lor( LOGICAL );
+    const XorInstruction lxor( LOGICAL );
+
+    Constant res;
+    land.execute( res, p, BooleanConstant( false ) );
+    EXPECT_TRUE( res == BooleanConstant( false ) );
+    land.execute( res, p, p );
+    EXPECT_TRUE( res == p );
+    lor.execute( res, BooleanConstant( true ), p );
+    EXPECT_TRUE( res == BooleanConstant( true ) );
+    lor.execute( res, BooleanConstant( false ), p );
+    EXPECT_TRUE( res == p );
+    lxor.execute( res, p, p );
+    EXPECT_TRUE( res == BooleanConstant( false ) );
+
+    EXPECT_EQ( env.size(), size );
+}
+
+TEST( libcasm_ir_SymbolicExecutionEnvironment, hash_cons_commutative_terms )
+{
+    SymbolicExecutionEnvironment env;
+    const Constant x = symbol( env, INTEGER );
+    const Constant y = symbol( env, INTEGER );
+
+    const AddInstruction add( ARITHMETIC );
+    const SubInstruction sub( ARITHMETIC );
+
+    Constant first;
+    add.execute( first, x, y );
+    EXPECT_TRUE( first.symbolic() );
+    const auto size = env.size();
+
+    Constant second;
+    add.execute( second, y, x );
+    EXPECT_TRUE( first == second );
+    EXPECT_EQ( env.size(), size );
+
+    Constant lhs;
+    Constant rhs;
+    sub.execute( lhs, x, y );
+    sub.execute( rhs, y, x );
+    EXPECT_FALSE( lhs == rhs );
+
+    Constant other;
+    add.execute( other, x, IntegerConstant( 2 ) );
+    EXPECT_FALSE( other == first );
+}
+
+TEST( libcasm_ir_SymbolicExecutionEnvironment, hash_cons_scope )
+{
+    SymbolicExecutionEnvironment env;
+    const Constant x = symbol( env, INTEGER );
+    const Constant y = symbol( env, INTEGER );
+    const auto condition = env.tptpAtomFromConstant( symbol( env, BOOLEAN ) );
+
+    const AddInstruction add( ARITHMETIC );
+
+    Constant scoped;
+    {
+        const auto scope = env.makeEnvironment( condition );
+        add.execute( scoped, x, y );
+
+        Constant again;
+        add.execute( again, x, y );
+        EXPECT_TRUE( again == scoped );
+    }
+
+    Constant outside;
+    add.execute( outside, x, y );
+    EXPECT_FALSE( outside == scoped );
+
+    Constant again;
+    add.execute( again, x, y );
+    EXPECT_TRUE( again == outside );
+}
+
+static std::vector< std::string > mergeNames( const std::size_t workers )
+{
+    SymbolicExecutionEnvironment env;
+    env.setWorkers( workers );
+    const Constant x = symbol( env, INTEGER );
+    const auto condition = env.tptpAtomFromConstant( symbol( env, BOOLEAN ) );
+
+    const AddInstruction add( ARITHMETIC );
+    const auto path = [&]( const i64 offset ) {
+        return [&add, &x, offset]( SymbolicExecutionEnvironment& ) {
+            Constant res;
+            add.execute( res, x, IntegerConstant( offset ) );
+            return res;
+        };
+    };
+
+    Constant thenValue;
+    Constant elseValue;
+    const auto result = env.mergeSymbolPaths(
+        condition,
+        [&]( SymbolicExecutionEnvironment& fork ) {
+            thenValue = path( 1 )( fork );
+            return thenValue;
+        },
+        [&]( SymbolicExecutionEnvironment& fork ) {
+            elseValue = path( 2 )( fork );
+            return elseValue;
+        } );
+
+    return { thenValue.name(), elseValue.name(), result.name() };
+}
+
+TEST( libcasm_ir_SymbolicExecutionEnvironment, fork_names_are_deterministic )
+{
+    const auto sequential = mergeNames( 1 );
+    EXPECT_EQ( sequential, mergeNames( 4 ) );
+    EXPECT_EQ( sequential, mergeNames( 4 ) );
+
+    EXPECT_EQ( sequential[ 0 ], "'%f0_0'" );
+    EXPECT_EQ( sequential[ 1 ], "'%f1_0'" );
+    EXPECT_EQ( sequential[ 2 ], "'%2'" );
+}
+
+TEST( libcasm_ir_SymbolicExecutionEnvironment, fork_symbols_outlive_join )
+{
+    SymbolicExecutionEnvironment env;
+    const Constant x = symbol( env, INTEGER );
+    const auto condition = env.tptpAtomFromConstant( symbol( env, BOOLEAN ) );
+
+    const AddInstruction add( ARITHMETIC );
+
+    Constant forked;
+    env.mergeSymbolPaths(
+        condition,
+        [&]( SymbolicExecutionEnvironment& fork ) {
+            add.execute( forked, x, IntegerConstant( 1 ) );
+            EXPECT_EQ( &SymbolicExecutionEnvironment::active( env ), &fork );
+            return forked;
+        },
+        [&]( SymbolicExecutionEnvironment& ) { return x; } );
+
+    ASSERT_TRUE( forked.symbolic() );
+    EXPECT_EQ( &static_cast< const SymbolicConstant& >( forked ).environment(), &env );
+
+    const auto size = env.size();
+    Constant res;
+    add.execute( res, forked, x );
+    EXPECT_TRUE( res.symbolic() );
+    EXPECT_GT( env.size(), size );
+}
+
+TEST( libcasm_ir_SymbolicExecutionEnvironment, join_deduplicates_functions )
+{
+    const auto merge = []( const u1 both ) {
+        SymbolicExecutionEnvironment env;
+        const auto condition = env.tptpAtomFromConstant( symbol( env, BOOLEAN ) );
+        const auto size = env.size();
+
+        env.mergeSymbolPaths(
+            condition,
+            [&]( SymbolicExecutionEnvironment& fork ) -> Constant {
+                fork.addFunctionDeclaration( "g", *FUNCTION );
+                return IntegerConstant( 1 );
+            },
+            [&]( SymbolicExecutionEnvironment& fork ) -> Constant {
+                if( both )
+                {
+                    fork.addFunctionDeclaration( "g", *FUNCTION );
+                }
+                return IntegerConstant( 2 );
+            } );
+
+        return env.size() - size;
+    };
+
+    EXPECT_EQ( merge( true ), merge( false ) );
+}
+
+static void step( SymbolicExecutionEnvironment& env, const std::vector< Constant >& arguments )
+{
+    const AddInstruction add( ARITHMETIC );
+    const auto value = env.get( "f", FUNCTION, arguments );
+
+    Constant next;
+    add.execute( next, value, IntegerConstant( 1 ) );
+    env.set( "f", FUNCTION, arguments, next.name() );
+    env.incrementTime();
+}
+
+TEST( libcasm_ir_SymbolicExecutionEnvironment, frame_axioms )
+{
+    SymbolicExecutionEnvironment env;
+    env.enableFrames( 0 );
+    env.addFunctionDeclaration( "f", *FUNCTION );
+    env.addFunctionDeclaration( "c", *NULLARY );
+
+    // one axiom per declared function carries unchanged locations over
+    auto size = env.size();
+    env.incrementTime();
+    EXPECT_EQ( env.size() - size, 2 );
+
+    // an unconditional update of a nullary function needs no axiom
+    env.set( "c", NULLARY, {}, env.tptpAtomFromConstant( IntegerConstant( 1 ) ) );
+    size = env.size();
+    env.incrementTime();
+    EXPECT_EQ( env.size() - size, 1 );
+
+    // a location update only excludes the updated arguments
+    const auto one = env.tptpAtomFromConstant( IntegerConstant( 1 ) );
+    env.set( "f", FUNCTION, { IntegerConstant( 0 ) }, one );
+    size = env.size();
+    env.incrementTime();
+    EXPECT_EQ( env.size() - size, 2 );
+}
+
+TEST( libcasm_ir_SymbolicExecutionEnvironment, frame_window_flushes )
+{
+    EXPECT_THROW( SymbolicExecutionEnvironment().enableFrames( 2 ), InternalException );
+
+    std::size_t flushed = 0;
+    SymbolicExecutionEnvironment env;
+    env.enableFrames( 2, [&flushed]( const TPTP::Specification::Ptr& frame ) {
+        EXPECT_TRUE( frame != nullptr );
+        flushed++;
+    } );
+    env.addFunctionDeclaration( "f", *FUNCTION );
+
+    step( env, { IntegerConstant( 0 ) } );
+    step( env, { IntegerConstant( 0 ) } );
+    EXPECT_EQ( flushed, 0 );
+    const auto size = env.size();
+
+    for( std::size_t i = 0; i < 8; i++ )
+    {
+        step( env, { IntegerConstant( 0 ) } );
+    }
+    EXPECT_EQ( flushed, 8 );
+    EXPECT_EQ( env.size(), size );
+}
+
+TEST( libcasm_ir_SymbolicExecutionEnvironment, frame_flush_drops_terms )
+{
+    SymbolicExecutionEnvironment env;
+    env.enableFrames( 1, []( const TPTP::Specification::Ptr& ) {} );
+    const Constant x = symbol( env, INTEGER );
+
+    const AddInstruction add( ARITHMETIC );
+
+    Constant first;
+    add.execute( first, x, IntegerConstant( 1 ) );
+    env.incrementTime();
+
+    Constant second;
+    add.execute( second, x, IntegerConstant( 1 ) );
+    EXPECT_TRUE( first == second );
+    env.incrementTime();
+
+    Constant third;
+    add.execute( third, x, IntegerConstant( 1 ) );
+    EXPECT_TRUE( third.symbolic() );
+    EXPECT_FALSE( third == first );
+}
+
+TEST( libcasm_ir_SymbolicExecutionEnvironment, finalize_binds_final_values )
+{
+    const auto finalize = []( const u1 frames ) {
+        SymbolicExecutionEnvironment env;
+        if( frames )
+        {
+            env.enableFrames( 0 );
+        }
+        env.addFunctionDeclaration( "f", *FUNCTION );
+        step( env, { IntegerConstant( 0 ) } );
+        step( env, { IntegerConstant( 1 ) } );
+
+        const auto size = env.size();
+        env.finalize();
+        return env.size() - size;
+    };
+
+    // one symbol, its definition and its binding at time 0 per location
+    EXPECT_EQ( finalize( true ), 6 );
+    EXPECT_EQ( finalize( false ), 6 );
+}
+
+TEST( libcasm_ir_SymbolicExecutionEnvironment, frames_keep_the_initial_state_apart )
+{
+    SymbolicExecutionEnvironment env;
+    env.enableFrames( 0 );
+    env.enableFrames( 0 );
+    env.addFunctionDeclaration( "f", *FUNCTION );
+
+    // the first step reads the initial state at time 1 like the step based
+    // representation, so the final state bound at time 0 is a separate one
+    EXPECT_EQ( env.time(), 2 );
+    step( env, { IntegerConstant( 0 ) } );
+    EXPECT_EQ( env.time(), 3 );
+    step( env, { IntegerConstant( 0 ) } );
+    EXPECT_EQ( env.time(), 4 );
+
+    const auto size = env.size();
+    env.finalize();
+    EXPECT_EQ( env.size() - size, 3 );
+
+    EXPECT_EQ( SymbolicExecutionEnvironment().time(), 1 );
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -0,0 +1,193 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "../main.h"
+
+using namespace libcasm_ir;
+using namespace libstdhl;
+
+static const auto VOID = Memory::get< VoidType >();
+static const auto INTEGER = Memory::get< IntegerType >();
+
+static Value::Ptr function( void )
+{
+    return Memory::make< Function >( "x", Memory::make< RelationType >( INTEGER, Types() ) );
+}
+
+static Instruction::Ptr instruction( const Statement::Ptr& stmt, const std::size_t position )
+{
+    return *std::next( stmt->instructions().begin(), position );
+}
+
+static void fill( const Statement::Ptr& stmt, const Value::Ptr& function )
+{
+    auto loc = stmt->add< LocationInstruction >( function, std::vector< Value::Ptr >{} );
+    auto val = stmt->add< LookupInstruction >( loc );
+    auto add0 = stmt->add< AddInstruction >( val, Memory::make< IntegerConstant >( 1 ) );
+    auto add1 = stmt->add< AddInstruction >( val, Memory::make< IntegerConstant >( 1 ) );
+    auto mul = stmt->add< MulInstruction >( add0, add1 );
+    stmt->add< UpdateInstruction >( loc, mul );
+}
+
+TEST( libcasm_ir__transform_CommonSubexpressionEliminationPass, statement )
+{
+    CommonSubexpressionEliminationPass pass;
+
+    auto rule = Memory::make< Rule >( TEST_NAME, Memory::make< RelationType >( VOID ) );
+    rule->setContext( ParallelBlock::create() );
+
+    auto stmt = rule->context()->add< TrivialStatement >();
+    fill( stmt, function() );
+    EXPECT_EQ( stmt->instructions().size(), 6 );
+
+    EXPECT_EQ( pass.optimize( *rule ), 1 );
+    ASSERT_EQ( stmt->instructions().size(), 5 );
+
+    const auto mul = instruction( stmt, 3 );
+    ASSERT_TRUE( isa< MulInstruction >( mul ) );
+    EXPECT_EQ( mul->operand( 0 ), mul->operand( 1 ) );
+    EXPECT_EQ( instruction( stmt, 2 )->next(), mul );
+
+    EXPECT_EQ( pass.optimize( *rule ), 0 );
+}
+
+TEST( libcasm_ir__transform_CommonSubexpressionEliminationPass, sequential_dominance )
+{
+    CommonSubexpressionEliminationPass pass;
+
+    auto rule = Memory::make< Rule >( TEST_NAME, Memory::make< RelationType >( VOID ) );
+    rule->setContext( ParallelBlock::create() );
+
+    const auto x = function();
+    auto seq = SequentialBlock::create();
+    rule->context()->add( seq );
+    auto stmt0 = seq->add< TrivialStatement >();
+    auto stmt1 = seq->add< TrivialStatement >();
+    fill( stmt0, x );
+    fill( stmt1, x );
+
+    // one add in each statement and the location of the second statement
+    EXPECT_EQ( pass.optimize( *rule ), 3 );
+    EXPECT_EQ( stmt0->instructions().size(), 5 );
+    EXPECT_EQ( stmt1->instructions().size(), 4 );
+    EXPECT_EQ( instruction( stmt1, 0 )->operand( 0 ), instruction( stmt0, 0 ) );
+}
+
+TEST( libcasm_ir__transform_CommonSubexpressionEliminationPass, parallel_siblings )
+{
+    CommonSubexpressionEliminationPass pass;
+
+    auto rule = Memory::make< Rule >( TEST_NAME, Memory::make< RelationType >( VOID ) );
+    rule->setContext( ParallelBlock::create() );
+
+    const auto x = function();
+    auto stmt0 = rule->context()->add< TrivialStatement >();
+    auto stmt1 = rule->context()->add< TrivialStatement >();
+    fill( stmt0, x );
+    fill( stmt1, x );
+
+    EXPECT_EQ( pass.optimize( *rule ), 2 );
+    EXPECT_EQ( stmt0->instructions().size(), 5 );
+    EXPECT_EQ( stmt1->instructions().size(), 5 );
+}
+
+TEST( libcasm_ir__transform_CommonSubexpressionEliminationPass, forall_domain )
+{
+    CommonSubexpressionEliminationPass pass;
+
+    auto rule = Memory::make< Rule >( TEST_NAME, Memory::make< RelationType >( VOID ) );
+    rule->setContext( ParallelBlock::create() );
+
+    const auto one = Memory::make< IntegerConstant >( 1 );
+    auto seq = SequentialBlock::create();
+    rule->context()->add( seq );
+
+    auto stmt = seq->add< TrivialStatement >();
+    auto sum = stmt->add< AddInstruction >( one, one );
+
+    auto forall = seq->add< ForallStatement >( Memory::make< Identifier >( INTEGER, "i" ), one );
+    auto domain = forall->add< AddInstruction >( one, one );
+    forall->setDomain( domain );
+    forall->add( ParallelBlock::create() );
+
+    EXPECT_EQ( pass.optimize( *rule ), 1 );
+    EXPECT_EQ( forall->domain(), sum );
+    EXPECT_EQ( forall->instructions().size(), 0 );
+    EXPECT_EQ( sum->uses().size(), 1 );
+}
+
+TEST( libcasm_ir__transform_CommonSubexpressionEliminationPass, equal_named_identifiers )
+{
+    CommonSubexpressionEliminationPass pass;
+
+    auto rule = Memory::make< Rule >( TEST_NAME, Memory::make< RelationType >( VOID ) );
+    rule->setContext( ParallelBlock::create() );
+
+    const auto one = Memory::make< IntegerConstant >( 1 );
+    const auto a = Memory::make< Identifier >( INTEGER, "a" );
+    const auto b = Memory::make< Identifier >( INTEGER, "a" );
+    rule->addParameter( a );
+
+    auto seq = SequentialBlock::create();
+    rule->context()->add( seq );
+
+    auto stmt0 = seq->add< TrivialStatement >();
+    stmt0->add< AddInstruction >( a, one );
+
+    auto forall = seq->add< ForallStatement >( b, Memory::make< DomainConstant >( INTEGER ) );
+    auto stmt1 = forall->add( ParallelBlock::create() )->add< TrivialStatement >();
+    auto add = stmt1->add< AddInstruction >( b, one );
+    stmt1->add< UpdateInstruction >(
+        stmt1->add< LocationInstruction >( function(), std::vector< Value::Ptr >{} ), add );
+
+    EXPECT_EQ( pass.optimize( *rule ), 0 );
+    EXPECT_EQ( stmt1->instructions().size(), 3 );
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -0,0 +1,258 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "Fixture.h"
+
+using namespace libcasm_ir;
+using namespace libstdhl;
+
+static const auto VOID = Memory::get< VoidType >();
+static const auto INTEGER = Memory::get< IntegerType >();
+
+static Value::Ptr function( Specification& specification, const std::string& name )
+{
+    auto type = Memory::make< RelationType >( INTEGER, Types() );
+    auto function = Memory::make< Function >( name, type );
+    specification.add( function );
+    return function;
+}
+
+static Rule::Ptr rule( Specification& specification, const std::string& name )
+{
+    auto rule = specification.add< Rule >( name, Memory::make< RelationType >( VOID ) );
+    rule->setContext( ParallelBlock::create() );
+    return rule;
+}
+
+static Derived::Ptr derived( Specification& specification, const std::string& name )
+{
+    auto type = Memory::make< RelationType >( INTEGER, Types() );
+    auto derived = specification.add< Derived >( name, type );
+    auto stmt = Memory::make< TrivialStatement >();
+    derived->setContext( stmt );
+
+    auto cst = Memory::make< IntegerConstant >( 1 );
+    stmt->add< AddInstruction >( cst, cst );
+    return derived;
+}
+
+TEST( libcasm_ir__transform_DeadCodeEliminationPass, unused_instructions )
+{
+    DeadCodeEliminationPass pass;
+
+    Specification specification( TEST_NAME );
+    const auto x = function( specification, "x" );
+    auto init = rule( specification, "init" );
+
+    auto stmt = init->context()->add< TrivialStatement >();
+    auto val = stmt->add< LookupInstruction >(
+        stmt->add< LocationInstruction >( x, std::vector< Value::Ptr >{} ) );
+    stmt->add< AddInstruction >( val, val );
+    update( stmt, x, Memory::make< IntegerConstant >( 1 ) );
+    EXPECT_EQ( stmt->instructions().size(), 5 );
+
+    EXPECT_EQ( pass.optimize( *init ), 3 );
+    ASSERT_EQ( stmt->instructions().size(), 2 );
+    const auto loc = *stmt->instructions().begin();
+    EXPECT_TRUE( isa< LocationInstruction >( loc ) );
+    EXPECT_TRUE( isa< UpdateInstruction >( loc->next() ) );
+
+    EXPECT_EQ( pass.optimize( *init ), 0 );
+}
+
+TEST( libcasm_ir__transform_DeadCodeEliminationPass, unused_across_statements )
+{
+    DeadCodeEliminationPass pass;
+
+    Specification specification( TEST_NAME );
+    const auto x = function( specification, "x" );
+    auto init = rule( specification, "init" );
+    auto seq = SequentialBlock::create();
+    init->context()->add( seq );
+
+    auto stmt1 = seq->add< TrivialStatement >();
+    auto val = stmt1->add< LookupInstruction >(
+        stmt1->add< LocationInstruction >( x, std::vector< Value::Ptr >{} ) );
+    auto sum = stmt1->add< AddInstruction >( val, val );
+    update( stmt1, x, Memory::make< IntegerConstant >( 1 ) );
+
+    auto stmt2 = seq->add< TrivialStatement >();
+    stmt2->add< AddInstruction >( sum, Memory::make< IntegerConstant >( 1 ) );
+    update( stmt2, x, Memory::make< IntegerConstant >( 2 ) );
+
+    EXPECT_EQ( pass.optimize( *init ), 4 );
+    EXPECT_EQ( stmt1->instructions().size(), 2 );
+    EXPECT_EQ( stmt2->instructions().size(), 2 );
+
+    EXPECT_EQ( pass.optimize( *init ), 0 );
+}
+
+TEST( libcasm_ir__transform_DeadCodeEliminationPass, derived_result )
+{
+    DeadCodeEliminationPass pass;
+
+    Specification specification( TEST_NAME );
+    auto d = derived( specification, "d" );
+
+    EXPECT_EQ( pass.optimize( *d ), 0 );
+    EXPECT_EQ( d->context()->instructions().size(), 1 );
+}
+
+TEST( libcasm_ir__transform_DeadCodeEliminationPass, unreachable_declarations )
+{
+    DeadCodeEliminationPass pass;
+    pass.setFunctionRemoval( true );
+
+    Specification specification( TEST_NAME );
+    const auto x = function( specification, "x" );
+    const auto y = function( specification, "y" );
+    const auto z = function( specification, "z" );
+    auto init = rule( specification, "init" );
+    auto used = rule( specification, "used" );
+    auto referenced = rule( specification, "referenced" );
+    auto dead = rule( specification, "dead" );
+    auto d = derived( specification, "d" );
+    derived( specification, "e" );
+    auto f = derived( specification, "f" );
+    specification.add( Memory::make< RuleReferenceConstant >( init ) );
+
+    auto stmt = init->context()->add< TrivialStatement >();
+    stmt->add< CallInstruction >( used );
+    update( stmt, x, stmt->add< CallInstruction >( d ) );
+    stmt->add< CallInstruction >( f );
+
+    auto ref = Memory::make< RuleReferenceConstant >( referenced );
+    update( used->context()->add< TrivialStatement >(), y, ref );
+    update( referenced->context()->add< TrivialStatement >(), x, ref );
+    update( dead->context()->add< TrivialStatement >(), z, Memory::make< IntegerConstant >( 1 ) );
+
+    // the unused call of 'f', the deriveds 'e' and 'f', the rule 'dead' and
+    // the function 'z'
+    EXPECT_EQ( pass.optimize( specification ), 5 );
+
+    EXPECT_EQ( stmt->instructions().size(), 4 );
+    EXPECT_EQ( specification.constants().size(), 1 );
+    EXPECT_EQ( specification.functions().size(), 2 );
+    EXPECT_EQ( specification.rules().size(), 3 );
+    ASSERT_EQ( specification.deriveds().size(), 1 );
+    EXPECT_EQ( *specification.deriveds().begin(), d );
+
+    EXPECT_EQ( pass.optimize( specification ), 0 );
+}
+
+TEST( libcasm_ir__transform_DeadCodeEliminationPass, functions_are_kept )
+{
+    DeadCodeEliminationPass pass;
+
+    Specification specification( TEST_NAME );
+    function( specification, "x" );
+    auto init = rule( specification, "init" );
+    rule( specification, "dead" );
+    specification.add( Memory::make< RuleReferenceConstant >( init ) );
+
+    EXPECT_EQ( pass.optimize( specification ), 1 );
+    EXPECT_EQ( specification.functions().size(), 1 );
+    ASSERT_EQ( specification.rules().size(), 1 );
+    EXPECT_EQ( *specification.rules().begin(), init );
+}
+
+TEST( libcasm_ir__transform_DeadCodeEliminationPass, no_root )
+{
+    DeadCodeEliminationPass pass;
+    pass.setFunctionRemoval( true );
+
+    Specification specification( TEST_NAME );
+    function( specification, "x" );
+    rule( specification, "init" );
+    derived( specification, "d" );
+
+    EXPECT_EQ( pass.optimize( specification ), 0 );
+    EXPECT_EQ( specification.functions().size(), 1 );
+    EXPECT_EQ( specification.rules().size(), 1 );
+    EXPECT_EQ( specification.deriveds().size(), 1 );
+}
+
+TEST( libcasm_ir__transform_DeadCodeEliminationPass, explicit_roots )
+{
+    DeadCodeEliminationPass pass;
+
+    Specification specification( TEST_NAME );
+    auto init = rule( specification, "init" );
+    auto main = rule( specification, "main" );
+    specification.add( Memory::make< RuleReferenceConstant >( init ) );
+
+    pass.setRoots( { main } );
+    EXPECT_EQ( pass.roots().size(), 1 );
+
+    EXPECT_EQ( pass.optimize( specification ), 1 );
+    ASSERT_EQ( specification.rules().size(), 1 );
+    EXPECT_EQ( *specification.rules().begin(), main );
+}
+
+TEST( libcasm_ir__transform_DeadCodeEliminationPass, forall_domain )
+{
+    DeadCodeEliminationPass pass;
+
+    Specification specification( TEST_NAME );
+    const auto x = function( specification, "x" );
+    auto init = rule( specification, "init" );
+
+    auto forall = init->context()->add< ForallStatement >(
+        Memory::make< Identifier >( INTEGER, "i" ), Memory::make< IntegerConstant >( 1 ) );
+    auto domain = forall->add< LookupInstruction >(
+        forall->add< LocationInstruction >( x, std::vector< Value::Ptr >{} ) );
+    forall->setDomain( domain );
+    forall->add( ParallelBlock::create() );
+
+    EXPECT_EQ( pass.optimize( *init ), 0 );
+    EXPECT_EQ( forall->instructions().size(), 2 );
+    EXPECT_EQ( forall->domain(), domain );
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
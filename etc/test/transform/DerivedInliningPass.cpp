@@ -0,0 +1,134 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "Fixture.h"
+
+using namespace libcasm_ir;
+using namespace libstdhl;
+
+static const auto INTEGER = Memory::get< IntegerType >();
+
+static Derived::Ptr derived(
+    Specification& specification,
+    const std::string& name,
+    const std::size_t size,
+    const Types& arguments = Types() )
+{
+    auto type = Memory::make< RelationType >( INTEGER, arguments );
+    auto derived = specification.add< Derived >( name, type );
+    auto stmt = Memory::make< TrivialStatement >();
+    derived->setContext( stmt );
+
+    Value::Ptr value = Memory::make< IntegerConstant >( 1 );
+    for( std::size_t index = 0; index < size; index++ )
+    {
+        value = stmt->add< AddInstruction >( value, Memory::make< IntegerConstant >( 1 ) );
+    }
+    return derived;
+}
+
+static Value::Ptr function( Specification& specification )
+{
+    auto type = Memory::make< RelationType >( INTEGER, Types() );
+    auto function = Memory::make< Function >( "x", type );
+    specification.add( function );
+    return function;
+}
+
+TEST( libcasm_ir__transform_DerivedInliningPass, small_derived )
+{
+    DerivedInliningPass pass;
+
+    Specification specification( TEST_NAME );
+    const auto x = function( specification );
+    auto d = derived( specification, "d", 2 );
+    auto stmt = init( specification );
+    update( stmt, x, stmt->add< CallInstruction >( d ) );
+    EXPECT_EQ( stmt->instructions().size(), 3 );
+
+    EXPECT_EQ( pass.optimize( specification ), 1 );
+    ASSERT_EQ( stmt->instructions().size(), 4 );
+
+    const auto first = *stmt->instructions().begin();
+    ASSERT_TRUE( isa< AddInstruction >( first ) );
+    const auto second = first->next();
+    ASSERT_TRUE( isa< AddInstruction >( second ) );
+    EXPECT_EQ( second->operand( 0 ), first );
+    EXPECT_TRUE( isa< LocationInstruction >( second->next() ) );
+
+    const auto upd = second->next()->next();
+    ASSERT_TRUE( isa< UpdateInstruction >( upd ) );
+    EXPECT_EQ( upd->operand( 1 ), second );
+
+    // the derived body is copied, not moved
+    EXPECT_EQ( d->context()->instructions().size(), 2 );
+    EXPECT_EQ( pass.optimize( specification ), 0 );
+}
+
+TEST( libcasm_ir__transform_DerivedInliningPass, keep_large_and_parameterized )
+{
+    DerivedInliningPass pass;
+
+    Specification specification( TEST_NAME );
+    const auto x = function( specification );
+    auto large = derived( specification, "large", DerivedInliningPass::THRESHOLD + 1 );
+    auto parameterized = derived( specification, "parameterized", 1, Types( { INTEGER } ) );
+    auto stmt = init( specification );
+    update( stmt, x, stmt->add< CallInstruction >( large ) );
+    update(
+        stmt,
+        x,
+        stmt->add< CallInstruction >(
+            parameterized, std::vector< Value::Ptr >{ Memory::make< IntegerConstant >( 1 ) } ) );
+
+    EXPECT_EQ( pass.optimize( specification ), 0 );
+    EXPECT_EQ( stmt->instructions().size(), 6 );
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
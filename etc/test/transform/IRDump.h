@@ -0,0 +1,163 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#ifndef _LIBCASMIR_UTS_TRANSFORM_IRDUMP_H_
+#define _LIBCASMIR_UTS_TRANSFORM_IRDUMP_H_
+
+#include "../main.h"
+
+#include <regex>
+#include <unordered_map>
+
+/**
+   specification with 32 rules for the dump tests
+*/
+static inline libcasm_ir::Specification::Ptr dumpSpecification( const std::string& name )
+{
+    using namespace libcasm_ir;
+    using namespace libstdhl;
+
+    const auto VOID = Memory::get< VoidType >();
+    const auto INTEGER = Memory::get< IntegerType >();
+
+    auto specification = Memory::make< Specification >( name );
+
+    auto function = specification->add< Function >(
+        "x", Memory::make< RelationType >( INTEGER, Types() ) );
+
+    for( std::size_t c = 0; c < 32; c++ )
+    {
+        auto rule = specification->add< Rule >(
+            "r" + std::to_string( c ), Memory::make< RelationType >( VOID ) );
+        rule->setContext( c % 2 ? ParallelBlock::create() : SequentialBlock::create() );
+
+        auto stmt = rule->context()->add< TrivialStatement >();
+        auto loc = stmt->add< LocationInstruction >( function, std::vector< Value::Ptr >{} );
+        auto val = stmt->add< LookupInstruction >( loc );
+        auto cst = Memory::make< IntegerConstant >( static_cast< i64 >( c ) );
+        auto sum = stmt->add< AddInstruction >( val, cst );
+        stmt->add< UpdateInstruction >( loc, sum );
+    }
+
+    return specification;
+}
+
+template < typename Visitor >
+static inline std::string dump(
+    const libcasm_ir::Specification::Ptr& specification, const std::size_t threads )
+{
+    std::string buffer;
+    {
+        libcasm_ir::Writer writer( buffer );
+        Visitor visitor{ writer };
+        visitor.setThreads( threads );
+        specification->accept( visitor );
+    }
+    return buffer;
+}
+
+/**
+   labels are numbered process-wide and the dot dump contains addresses,
+   therefore the label numbers are rebased to zero and the addresses are
+   replaced by their order of appearance to compare the dumps of two equal
+   specifications
+*/
+static inline std::string normalize( const std::string& text )
+{
+    static const std::regex pattern( "(%r|%lbl|lbl|@c|@b)([0-9]+)|0x[0-9a-f]+" );
+
+    const auto counter = []( const std::string& prefix ) {
+        return prefix == "lbl" ? std::string( "%lbl" ) : prefix;
+    };
+
+    std::unordered_map< std::string, u64 > minimum;
+    for( std::sregex_iterator match( text.begin(), text.end(), pattern ), end; match != end;
+         ++match )
+    {
+        if( ( *match )[ 1 ].matched )
+        {
+            const auto key = counter( ( *match )[ 1 ].str() );
+            const auto number = std::stoull( ( *match )[ 2 ].str() );
+            const auto result = minimum.emplace( key, number );
+            if( not result.second and number < result.first->second )
+            {
+                result.first->second = number;
+            }
+        }
+    }
+
+    std::string normalized;
+    std::unordered_map< std::string, std::size_t > addresses;
+    auto position = text.cbegin();
+    for( std::sregex_iterator match( text.begin(), text.end(), pattern ), end; match != end;
+         ++match )
+    {
+        normalized.append( position, ( *match )[ 0 ].first );
+        position = ( *match )[ 0 ].second;
+
+        if( ( *match )[ 1 ].matched )
+        {
+            const auto number = std::stoull( ( *match )[ 2 ].str() );
+            normalized += ( *match )[ 1 ].str() +
+                          std::to_string( number - minimum[ counter( ( *match )[ 1 ].str() ) ] );
+        }
+        else
+        {
+            const auto result = addresses.emplace( ( *match )[ 0 ].str(), addresses.size() );
+            normalized += "<" + std::to_string( result.first->second ) + ">";
+        }
+    }
+    normalized.append( position, text.cend() );
+
+    return normalized;
+}
+
+#endif  // _LIBCASMIR_UTS_TRANSFORM_IRDUMP_H_
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
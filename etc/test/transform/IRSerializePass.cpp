@@ -0,0 +1,378 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "../main.h"
+
+#include <algorithm>
+#include <thread>
+
+using namespace libcasm_ir;
+using namespace libstdhl;
+
+static Specification::Ptr specification( const std::string& name, const std::size_t rules = 1 )
+{
+    const auto VOID = Memory::get< VoidType >();
+    const auto INTEGER = Memory::get< IntegerType >();
+
+    auto specification = Memory::make< Specification >( name );
+
+    auto function = specification->add< Function >(
+        "x", Memory::make< RelationType >( INTEGER, Types() ) );
+
+    for( std::size_t c = 1; c < rules; c++ )
+    {
+        auto rule = specification->add< Rule >(
+            "main" + std::to_string( c ), Memory::make< RelationType >( VOID ) );
+        rule->setContext( ParallelBlock::create() );
+
+        auto stmt = rule->context()->add< TrivialStatement >();
+        auto loc = stmt->add< LocationInstruction >( function, std::vector< Value::Ptr >{} );
+        auto sum = stmt->add< AddInstruction >(
+            stmt->add< LookupInstruction >( loc ), Memory::make< IntegerConstant >( ( i64 )c ) );
+        stmt->add< UpdateInstruction >( loc, sum );
+    }
+
+    auto rule = specification->add< Rule >( "main", Memory::make< RelationType >( VOID ) );
+    rule->setContext( ParallelBlock::create() );
+
+    auto stmt = rule->context()->add< TrivialStatement >();
+    auto loc = stmt->add< LocationInstruction >( function, std::vector< Value::Ptr >{} );
+    auto val = stmt->add< LookupInstruction >( loc );
+    auto sum = stmt->add< AddInstruction >( val, Memory::make< IntegerConstant >( 1 ) );
+    stmt->add< UpdateInstruction >( loc, sum );
+
+    auto val_T = Memory::get< BooleanConstant >( true );
+    auto val_F = Memory::get< BooleanConstant >( false );
+
+    auto br0 = rule->context()->add< BranchStatement >();
+
+    auto lbl_T = br0->add( ParallelBlock::create() );
+    lbl_T->add< TrivialStatement >()->add< SkipInstruction >();
+
+    auto lbl_F = br0->add( SequentialBlock::create() );
+    lbl_F->add< TrivialStatement >()->add< SkipInstruction >();
+
+    br0->add< SelectInstruction >(
+        val_T, std::initializer_list< Value::Ptr >{ val_T, lbl_T, val_F, lbl_F } );
+
+    return specification;
+}
+
+static std::vector< u8 > serialize( const Specification::Ptr& specification )
+{
+    IRSerializer serializer( specification );
+    return serializer.serialize();
+}
+
+TEST( libcasm_ir__transform_IRSerializePass, round_trip )
+{
+    const auto original = specification( TEST_NAME );
+
+    const auto bytes = serialize( original );
+    EXPECT_GT( bytes.size(), IRBinary::HEADER_SIZE );
+
+    IRDeserializer deserializer( bytes );
+    const auto decoded = deserializer.specification();
+
+    EXPECT_EQ( decoded->name(), original->name() );
+    EXPECT_EQ( decoded->functions().size(), original->functions().size() );
+    EXPECT_EQ( decoded->rules().size(), original->rules().size() );
+    EXPECT_EQ( serialize( decoded ), bytes );
+}
+
+TEST( libcasm_ir__transform_IRSerializePass, materialize )
+{
+    const auto original = specification( TEST_NAME );
+
+    const auto bytes = serialize( original );
+    IRDeserializer deserializer( bytes );
+
+    const auto decoded = deserializer.specification();
+    ASSERT_EQ( decoded->rules().size(), 1 );
+
+    const auto rule = *decoded->rules().begin();
+    EXPECT_TRUE( rule->materialized() );
+    ASSERT_NE( rule->context(), nullptr );
+
+    deserializer.materialize( *rule );
+    EXPECT_EQ( serialize( decoded ), bytes );
+}
+
+TEST( libcasm_ir__transform_IRSerializePass, lazy_rule_stub )
+{
+    const auto original = specification( TEST_NAME );
+
+    const auto bytes = serialize( original );
+    auto deserializer = Memory::make< IRDeserializer >( bytes );
+
+    const auto decoded = deserializer->specification( true );
+    deserializer.reset();
+    ASSERT_EQ( decoded->rules().size(), 1 );
+
+    const auto rule = *decoded->rules().begin();
+    EXPECT_FALSE( rule->materialized() );
+
+    const auto context = rule->context();
+    ASSERT_NE( context, nullptr );
+    EXPECT_TRUE( rule->materialized() );
+    EXPECT_EQ( context->rule(), rule );
+    EXPECT_EQ( context->blocks().size(), 2 );
+
+    EXPECT_EQ( serialize( decoded ), bytes );
+}
+
+TEST( libcasm_ir__transform_IRSerializePass, lazy_rule_stub_concurrent )
+{
+    const auto original = specification( TEST_NAME );
+
+    const auto bytes = serialize( original );
+    auto deserializer = Memory::make< IRDeserializer >( bytes );
+
+    const auto decoded = deserializer->specification( true );
+    deserializer.reset();
+    ASSERT_EQ( decoded->rules().size(), 1 );
+
+    const auto rule = *decoded->rules().begin();
+    EXPECT_FALSE( rule->materialized() );
+
+    std::vector< ParallelBlock::Ptr > contexts( 8 );
+    std::vector< std::thread > threads;
+    for( std::size_t c = 0; c < contexts.size(); c++ )
+    {
+        threads.emplace_back( [&rule, &contexts, c]() { contexts[ c ] = rule->context(); } );
+    }
+    for( auto& thread : threads )
+    {
+        thread.join();
+    }
+
+    EXPECT_TRUE( rule->materialized() );
+    for( const auto& context : contexts )
+    {
+        ASSERT_NE( context, nullptr );
+        EXPECT_EQ( context, rule->context() );
+        EXPECT_EQ( context->blocks().size(), 2 );
+    }
+
+    EXPECT_EQ( serialize( decoded ), bytes );
+}
+
+TEST( libcasm_ir__transform_IRSerializePass, lazy_rule_stubs_concurrent )
+{
+    const auto original = specification( TEST_NAME, 8 );
+
+    const auto bytes = serialize( original );
+    auto deserializer = Memory::make< IRDeserializer >( bytes );
+
+    const auto decoded = deserializer->specification( true );
+    deserializer.reset();
+    ASSERT_EQ( decoded->rules().size(), 8 );
+
+    // every thread materializes another rule with the same deserializer
+    std::vector< std::thread > threads;
+    for( const auto& rule : decoded->rules() )
+    {
+        threads.emplace_back( [rule]() { rule->context(); } );
+    }
+    for( auto& thread : threads )
+    {
+        thread.join();
+    }
+
+    for( const auto& rule : decoded->rules() )
+    {
+        EXPECT_TRUE( rule->materialized() );
+        EXPECT_NE( rule->context(), nullptr );
+    }
+
+    EXPECT_EQ( serialize( decoded ), bytes );
+}
+
+TEST( libcasm_ir__transform_IRSerializePass, lazy_rule_stub_invalid_body )
+{
+    auto bytes = serialize( specification( TEST_NAME ) );
+
+    // the section table follows the magic and the version in the header
+    IRBinary::Cursor header( bytes.data(), bytes.size(), 8 + 16 * IRBinary::Section::CODE );
+    const auto offset = header.getFixed( 8 );
+    const auto length = header.getFixed( 8 );
+    std::fill( bytes.begin() + offset, bytes.begin() + offset + length, ( u8 )Value::VALUE );
+
+    auto deserializer = Memory::make< IRDeserializer >( bytes );
+    const auto decoded = deserializer->specification( true );
+    ASSERT_EQ( decoded->rules().size(), 1 );
+
+    const auto rule = *decoded->rules().begin();
+    EXPECT_THROW( rule->context(), InternalException );
+    EXPECT_FALSE( rule->materialized() );
+
+    // the loader is kept and the failure is reported again
+    EXPECT_THROW( rule->context(), InternalException );
+    EXPECT_FALSE( rule->materialized() );
+}
+
+TEST( libcasm_ir__transform_IRSerializePass, forall_round_trip )
+{
+    const auto INTEGER = Memory::get< IntegerType >();
+
+    const auto original = specification( TEST_NAME );
+    const auto function = *original->functions().begin();
+    const auto rule = *original->rules().begin();
+
+    const auto a = Memory::make< IntegerConstant >( 0 );
+    const auto b = Memory::make< IntegerConstant >( 9 );
+    const auto range = Memory::make< RangeType >( Memory::make< Range >( a, b ) );
+    const auto domain = Memory::make< DomainConstant >( Memory::make< IntegerType >( range ) );
+    const auto variable = Memory::make< Identifier >( INTEGER, "i" );
+
+    auto forall = rule->context()->add< ForallStatement >( variable, domain );
+    auto stmt = forall->add( ParallelBlock::create() )->add< TrivialStatement >();
+    auto loc = stmt->add< LocationInstruction >( function, std::vector< Value::Ptr >{} );
+    stmt->add< UpdateInstruction >( loc, stmt->add< AddInstruction >( variable, variable ) );
+
+    const auto bytes = serialize( original );
+    IRDeserializer deserializer( bytes );
+    const auto decoded = deserializer.specification();
+
+    const auto context = ( *decoded->rules().begin() )->context();
+    ASSERT_EQ( context->blocks().size(), 3 );
+
+    const auto block = *std::next( context->blocks().begin(), 2 );
+    ASSERT_TRUE( isa< ForallStatement >( block ) );
+
+    auto& statement = static_cast< ForallStatement& >( *block );
+    ASSERT_NE( statement.variable(), nullptr );
+    EXPECT_EQ( *statement.variable(), *variable );
+    ASSERT_TRUE( isa< DomainConstant >( statement.domain() ) );
+    EXPECT_EQ( statement.blocks().size(), 1 );
+
+    EXPECT_EQ( serialize( decoded ), bytes );
+}
+
+TEST( libcasm_ir__transform_IRSerializePass, parameter_round_trip )
+{
+    const auto VOID = Memory::get< VoidType >();
+    const auto INTEGER = Memory::get< IntegerType >();
+
+    const auto original = specification( TEST_NAME );
+    const auto function = *original->functions().begin();
+
+    const auto type = Memory::make< RelationType >( VOID, Types( { INTEGER } ) );
+    const auto rule = original->add< Rule >( "update", type );
+    const auto parameter = Memory::make< Identifier >( INTEGER, "a" );
+    rule->addParameter( parameter );
+    rule->setContext( ParallelBlock::create() );
+
+    auto stmt = rule->context()->add< TrivialStatement >();
+    auto loc = stmt->add< LocationInstruction >( function, std::vector< Value::Ptr >{} );
+    stmt->add< UpdateInstruction >( loc, parameter );
+
+    const auto bytes = serialize( original );
+    IRDeserializer deserializer( bytes );
+    const auto decoded = deserializer.specification();
+    ASSERT_EQ( decoded->rules().size(), 2 );
+
+    const auto decodedRule = *std::next( decoded->rules().begin() );
+    ASSERT_EQ( decodedRule->parameters().size(), 1 );
+    EXPECT_EQ( *decodedRule->parameters()[ 0 ], *parameter );
+
+    EXPECT_EQ( serialize( decoded ), bytes );
+}
+
+TEST( libcasm_ir__transform_IRSerializePass, decimal_constant )
+{
+    const auto original = specification( TEST_NAME );
+    const auto rule = *original->rules().begin();
+
+    auto stmt = rule->context()->add< TrivialStatement >();
+    stmt->add< AddInstruction >(
+        Memory::make< DecimalConstant >( 0.1 ), Memory::make< DecimalConstant >( 0.2 ) );
+
+    EXPECT_THROW( serialize( original ), InternalException );
+}
+
+TEST( libcasm_ir__transform_IRSerializePass, invalid_header )
+{
+    const auto original = specification( TEST_NAME );
+
+    auto bytes = serialize( original );
+    bytes[ 0 ] = ~bytes[ 0 ];
+
+    EXPECT_THROW( IRDeserializer deserializer( bytes ), InternalException );
+}
+
+TEST( libcasm_ir__transform_IRSerializePass, invalid_table_size )
+{
+    for( const auto section : { IRBinary::Section::STRINGS, IRBinary::Section::CONSTANTS } )
+    {
+        auto bytes = serialize( specification( TEST_NAME ) );
+
+        IRBinary::Cursor header( bytes.data(), bytes.size(), 8 + 16 * section );
+        const auto offset = header.getFixed( 8 );
+        std::fill( bytes.begin() + offset, bytes.begin() + offset + 8, 0xff );
+
+        EXPECT_THROW( IRDeserializer deserializer( bytes ), InternalException );
+    }
+}
+
+TEST( libcasm_ir__transform_IRSerializePass, invalid_global_count )
+{
+    auto bytes = serialize( specification( TEST_NAME ) );
+
+    // the type count follows the name and the agent flag of the globals
+    IRBinary::Cursor header( bytes.data(), bytes.size(), 8 + 16 * IRBinary::Section::GLOBALS );
+    const auto offset = header.getFixed( 8 ) + 2;
+    std::fill( bytes.begin() + offset, bytes.begin() + offset + 8, 0xff );
+    bytes[ offset + 8 ] = 0x01;
+
+    IRDeserializer deserializer( bytes );
+    EXPECT_THROW( deserializer.specification(), InternalException );
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -0,0 +1,341 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "Fixture.h"
+
+using namespace libcasm_ir;
+using namespace libstdhl;
+
+static const auto VOID = Memory::get< VoidType >();
+static const auto BOOLEAN = Memory::get< BooleanType >();
+static const auto INTEGER = Memory::get< IntegerType >();
+static const auto STRING = Memory::get< StringType >();
+
+static Rule::Ptr dispatch( Specification& specification )
+{
+    auto function = Memory::make< Function >( "f", Memory::make< RelationType >( INTEGER ) );
+    specification.add( function );
+
+    auto type = Memory::make< RelationType >( VOID, Types( { BOOLEAN } ) );
+    auto rule = specification.add< Rule >( "dispatch", type );
+    auto x = Memory::make< Identifier >( BOOLEAN, "x" );
+    rule->addParameter( x );
+    rule->setContext( ParallelBlock::create() );
+
+    auto br = rule->context()->add< BranchStatement >();
+
+    auto lbl_T = br->add( ParallelBlock::create() );
+    update( lbl_T->add< TrivialStatement >(), function, Memory::make< IntegerConstant >( 1 ) );
+
+    auto lbl_F = br->add( ParallelBlock::create() );
+    update( lbl_F->add< TrivialStatement >(), function, Memory::make< IntegerConstant >( 2 ) );
+
+    auto val_T = Memory::get< BooleanConstant >( true );
+    auto val_F = Memory::get< BooleanConstant >( false );
+
+    auto cond = br->add< NotInstruction >( x );
+    br->add< SelectInstruction >(
+        cond, std::initializer_list< Value::Ptr >{ cond, val_T, lbl_T, val_F, lbl_F } );
+
+    return rule;
+}
+
+static Rule::Ptr strings( Specification& specification, const std::size_t arity )
+{
+    Types types;
+    for( std::size_t position = 0; position < arity; position++ )
+    {
+        types.add( STRING );
+    }
+
+    auto rule = specification.add< Rule >( "r", Memory::make< RelationType >( VOID, types ) );
+    for( std::size_t position = 0; position < arity; position++ )
+    {
+        const auto name = "p" + std::to_string( position );
+        rule->addParameter( Memory::make< Identifier >( STRING, name ) );
+    }
+    rule->setContext( ParallelBlock::create() );
+    rule->context()->add< TrivialStatement >()->add< SkipInstruction >();
+
+    return rule;
+}
+
+static void calls(
+    const Statement::Ptr& stmt, const Rule::Ptr& rule, const std::vector< Value::Ptr >& arguments )
+{
+    stmt->add< CallInstruction >( rule, arguments );
+    stmt->add< CallInstruction >( rule, arguments );
+}
+
+static Rule::Ptr lookup( Specification& specification, const std::string& name )
+{
+    for( const auto& rule : specification.rules() )
+    {
+        if( rule->name() == name )
+        {
+            return rule;
+        }
+    }
+    return nullptr;
+}
+
+static std::size_t selects( Rule& rule )
+{
+    std::size_t count = 0;
+    rule.iterate< Traversal::PREORDER >( [&count]( Value& value ) {
+        if( isa< SelectInstruction >( value ) )
+        {
+            count++;
+        }
+    } );
+    return count;
+}
+
+TEST( libcasm_ir__transform_RuleSpecializationPass, constant_arguments )
+{
+    RuleSpecializationPass pass;
+
+    Specification specification( TEST_NAME );
+    auto rule = dispatch( specification );
+    auto stmt = init( specification );
+
+    const auto val_T = Memory::get< BooleanConstant >( true );
+    stmt->add< CallInstruction >( rule, std::vector< Value::Ptr >{ val_T } );
+    stmt->add< CallInstruction >( rule, std::vector< Value::Ptr >{ val_T } );
+    EXPECT_EQ( specification.rules().size(), 2 );
+
+    EXPECT_EQ( pass.optimize( specification ), 2 );
+    ASSERT_EQ( specification.rules().size(), 3 );
+
+    const auto specialization = lookup( specification, "dispatch<true>" );
+    ASSERT_TRUE( specialization != nullptr );
+    EXPECT_EQ( specialization->parameters().size(), 0 );
+
+    // the negated parameter is folded and the branch is eliminated
+    EXPECT_EQ( selects( *specialization ), 0 );
+    EXPECT_EQ( selects( *rule ), 1 );
+
+    ASSERT_EQ( stmt->instructions().size(), 2 );
+    for( const auto& instruction : stmt->instructions() )
+    {
+        ASSERT_TRUE( isa< CallInstruction >( instruction ) );
+        EXPECT_EQ( instruction->operands().size(), 1 );
+        EXPECT_EQ( instruction->operand( 0 ), specialization );
+    }
+
+    // calls of the specialization have no constant arguments anymore
+    EXPECT_EQ( pass.optimize( specification ), 0 );
+    EXPECT_EQ( specification.rules().size(), 3 );
+}
+
+TEST( libcasm_ir__transform_RuleSpecializationPass, threshold )
+{
+    RuleSpecializationPass pass;
+
+    Specification specification( TEST_NAME );
+    auto rule = dispatch( specification );
+    auto stmt = init( specification );
+
+    stmt->add< CallInstruction >(
+        rule, std::vector< Value::Ptr >{ Memory::get< BooleanConstant >( true ) } );
+    stmt->add< CallInstruction >(
+        rule, std::vector< Value::Ptr >{ Memory::get< BooleanConstant >( false ) } );
+
+    EXPECT_EQ( pass.optimize( specification ), 0 );
+    EXPECT_EQ( specification.rules().size(), 2 );
+
+    pass.setThreshold( 1 );
+    EXPECT_EQ( pass.optimize( specification ), 2 );
+    EXPECT_EQ( specification.rules().size(), 4 );
+    EXPECT_TRUE( lookup( specification, "dispatch<true>" ) != nullptr );
+    EXPECT_TRUE( lookup( specification, "dispatch<false>" ) != nullptr );
+}
+
+TEST( libcasm_ir__transform_RuleSpecializationPass, budget )
+{
+    RuleSpecializationPass pass;
+    pass.setBudget( 0 );
+
+    Specification specification( TEST_NAME );
+    auto rule = dispatch( specification );
+    auto stmt = init( specification );
+
+    const auto val_T = Memory::get< BooleanConstant >( true );
+    stmt->add< CallInstruction >( rule, std::vector< Value::Ptr >{ val_T } );
+    stmt->add< CallInstruction >( rule, std::vector< Value::Ptr >{ val_T } );
+
+    EXPECT_EQ( pass.optimize( specification ), 0 );
+    EXPECT_EQ( specification.rules().size(), 2 );
+
+    pass.setBudget( RuleSpecializationPass::BUDGET );
+    EXPECT_EQ( pass.optimize( specification ), 2 );
+}
+
+TEST( libcasm_ir__transform_RuleSpecializationPass, profile_ranks_call_sites )
+{
+    const auto specialize = []( const u1 profiled ) {
+        RuleSpecializationPass pass;
+        pass.setBudget( 6 );
+
+        Specification specification( TEST_NAME );
+        auto rule = dispatch( specification );
+        auto stmt = init( specification );
+
+        const auto val_T = Memory::get< BooleanConstant >( true );
+        const auto val_F = Memory::get< BooleanConstant >( false );
+        calls( stmt, rule, { val_T } );
+        calls( stmt, rule, { val_F } );
+
+        // only the calls with the false argument were executed
+        Profile profile;
+        profile.counter( *stmt->instructions().at( 2 ) ).record();
+        profile.counter( *stmt->instructions().at( 3 ) ).record();
+        pass.setProfile( profiled ? &profile : nullptr );
+
+        // the budget only suffices for one specialization
+        EXPECT_EQ( pass.optimize( specification ), 2 );
+        EXPECT_EQ( specification.rules().size(), 3 );
+        return lookup( specification, profiled ? "dispatch<false>" : "dispatch<true>" );
+    };
+
+    EXPECT_TRUE( specialize( false ) != nullptr );
+    EXPECT_TRUE( specialize( true ) != nullptr );
+}
+
+TEST( libcasm_ir__transform_RuleSpecializationPass, string_arguments_do_not_collide )
+{
+    RuleSpecializationPass pass;
+
+    Specification specification( TEST_NAME );
+    auto rule = strings( specification, 2 );
+    auto stmt = init( specification );
+
+    calls(
+        stmt,
+        rule,
+        { Memory::make< StringConstant >( "a, b" ), Memory::make< StringConstant >( "c" ) } );
+    calls(
+        stmt,
+        rule,
+        { Memory::make< StringConstant >( "a" ), Memory::make< StringConstant >( "b, c" ) } );
+
+    EXPECT_EQ( pass.optimize( specification ), 4 );
+    ASSERT_EQ( specification.rules().size(), 4 );
+
+    const auto first = lookup( specification, "r<\"a, b\", \"c\">" );
+    const auto second = lookup( specification, "r<\"a\", \"b, c\">" );
+    ASSERT_TRUE( first != nullptr );
+    ASSERT_TRUE( second != nullptr );
+
+    ASSERT_EQ( stmt->instructions().size(), 4 );
+    EXPECT_EQ( stmt->instructions().at( 0 )->operand( 0 ), first );
+    EXPECT_EQ( stmt->instructions().at( 1 )->operand( 0 ), first );
+    EXPECT_EQ( stmt->instructions().at( 2 )->operand( 0 ), second );
+    EXPECT_EQ( stmt->instructions().at( 3 )->operand( 0 ), second );
+}
+
+TEST( libcasm_ir__transform_RuleSpecializationPass, undef_and_undef_string_do_not_collide )
+{
+    RuleSpecializationPass pass;
+
+    Specification specification( TEST_NAME );
+    auto rule = strings( specification, 1 );
+    auto stmt = init( specification );
+
+    calls( stmt, rule, { Memory::make< StringConstant >( "undef" ) } );
+    calls( stmt, rule, { Memory::make< StringConstant >() } );
+
+    EXPECT_EQ( pass.optimize( specification ), 4 );
+    ASSERT_EQ( specification.rules().size(), 4 );
+
+    const auto string = lookup( specification, "r<\"undef\">" );
+    const auto undef = lookup( specification, "r<undef>" );
+    ASSERT_TRUE( string != nullptr );
+    ASSERT_TRUE( undef != nullptr );
+
+    ASSERT_EQ( stmt->instructions().size(), 4 );
+    EXPECT_EQ( stmt->instructions().at( 0 )->operand( 0 ), string );
+    EXPECT_EQ( stmt->instructions().at( 2 )->operand( 0 ), undef );
+}
+
+TEST( libcasm_ir__transform_RuleSpecializationPass, forall_domain_is_folded )
+{
+    RuleSpecializationPass pass;
+
+    Specification specification( TEST_NAME );
+    auto type = Memory::make< RelationType >( VOID, Types( { INTEGER } ) );
+    auto rule = specification.add< Rule >( "loop", type );
+    auto n = Memory::make< Identifier >( INTEGER, "n" );
+    rule->addParameter( n );
+    rule->setContext( ParallelBlock::create() );
+
+    auto forall = rule->context()->add< ForallStatement >(
+        Memory::make< Identifier >( INTEGER, "i" ), Memory::make< IntegerConstant >( 1 ) );
+    forall->setDomain( forall->add< AddInstruction >( n, Memory::make< IntegerConstant >( 1 ) ) );
+    forall->add( ParallelBlock::create() );
+
+    auto stmt = init( specification );
+    calls( stmt, rule, { Memory::make< IntegerConstant >( 1 ) } );
+
+    EXPECT_EQ( pass.optimize( specification ), 2 );
+
+    const auto specialization = lookup( specification, "loop<1>" );
+    ASSERT_TRUE( specialization != nullptr );
+    ASSERT_EQ( specialization->context()->blocks().size(), 1 );
+
+    const auto& block = specialization->context()->blocks().at( 0 );
+    ASSERT_TRUE( isa< ForallStatement >( block ) );
+
+    auto& copy = static_cast< ForallStatement& >( *block );
+    EXPECT_EQ( copy.instructions().size(), 0 );
+    ASSERT_TRUE( isa< IntegerConstant >( copy.domain() ) );
+    EXPECT_TRUE( *copy.domain() == IntegerConstant( 2 ) );
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
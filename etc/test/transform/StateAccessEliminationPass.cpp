@@ -0,0 +1,280 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "../main.h"
+
+using namespace libcasm_ir;
+using namespace libstdhl;
+
+static const auto VOID = Memory::get< VoidType >();
+static const auto INTEGER = Memory::get< IntegerType >();
+
+static Value::Ptr function( void )
+{
+    return Memory::make< Function >( "x", Memory::make< RelationType >( INTEGER, Types() ) );
+}
+
+static Rule::Ptr rule( const std::string& name )
+{
+    auto rule = Memory::make< Rule >( name, Memory::make< RelationType >( VOID ) );
+    rule->setContext( ParallelBlock::create() );
+    return rule;
+}
+
+static Value::Ptr location( const Statement::Ptr& stmt, const Value::Ptr& function )
+{
+    return stmt->add< LocationInstruction >( function, std::vector< Value::Ptr >{} );
+}
+
+static Value::Ptr constant( const i64 value )
+{
+    return Memory::make< IntegerConstant >( value );
+}
+
+static Value::Ptr unary( void )
+{
+    return Memory::make< Function >(
+        "f", Memory::make< RelationType >( INTEGER, Types( { INTEGER } ) ) );
+}
+
+static Value::Ptr location(
+    const Statement::Ptr& stmt, const Value::Ptr& function, const Value::Ptr& argument )
+{
+    return stmt->add< LocationInstruction >( function, std::vector< Value::Ptr >{ argument } );
+}
+
+TEST( libcasm_ir__transform_StateAccessEliminationPass, repeated_lookup )
+{
+    StateAccessEliminationPass pass;
+
+    const auto x = function();
+    auto main = rule( TEST_NAME );
+
+    auto stmt = main->context()->add< TrivialStatement >();
+    auto loc = location( stmt, x );
+    auto val0 = stmt->add< LookupInstruction >( loc );
+    auto val1 = stmt->add< LookupInstruction >( loc );
+    auto sum = stmt->add< AddInstruction >( val0, val1 );
+    stmt->add< UpdateInstruction >( loc, sum );
+
+    EXPECT_EQ( pass.optimize( *main ), 1 );
+    EXPECT_EQ( stmt->instructions().size(), 4 );
+    EXPECT_EQ( sum->operand( 0 ), sum->operand( 1 ) );
+}
+
+TEST( libcasm_ir__transform_StateAccessEliminationPass, sequential_forwarding )
+{
+    StateAccessEliminationPass pass;
+
+    const auto x = function();
+    auto main = rule( TEST_NAME );
+    auto seq = SequentialBlock::create();
+    main->context()->add( seq );
+
+    auto stmt0 = seq->add< TrivialStatement >();
+    stmt0->add< UpdateInstruction >( location( stmt0, x ), constant( 1 ) );
+
+    auto stmt1 = seq->add< TrivialStatement >();
+    auto loc = location( stmt1, x );
+    auto val = stmt1->add< LookupInstruction >( loc );
+    auto sum = stmt1->add< AddInstruction >( val, constant( 1 ) );
+    stmt1->add< UpdateInstruction >( loc, sum );
+
+    EXPECT_EQ( pass.optimize( *main ), 1 );
+    EXPECT_EQ( stmt0->instructions().size(), 2 );
+    EXPECT_EQ( stmt1->instructions().size(), 3 );
+    EXPECT_TRUE( isa< IntegerConstant >( sum->operand( 0 ) ) );
+}
+
+TEST( libcasm_ir__transform_StateAccessEliminationPass, sequential_coalescing )
+{
+    StateAccessEliminationPass pass;
+
+    const auto x = function();
+    auto main = rule( TEST_NAME );
+    auto seq = SequentialBlock::create();
+    main->context()->add( seq );
+
+    auto stmt0 = seq->add< TrivialStatement >();
+    stmt0->add< UpdateInstruction >( location( stmt0, x ), constant( 1 ) );
+
+    auto stmt1 = seq->add< TrivialStatement >();
+    stmt1->add< UpdateInstruction >( location( stmt1, x ), constant( 2 ) );
+
+    EXPECT_EQ( pass.optimize( *main ), 1 );
+    EXPECT_EQ( stmt0->instructions().size(), 1 );
+    EXPECT_EQ( stmt1->instructions().size(), 2 );
+}
+
+TEST( libcasm_ir__transform_StateAccessEliminationPass, parallel_isolation )
+{
+    StateAccessEliminationPass pass;
+
+    const auto x = function();
+    auto main = rule( TEST_NAME );
+
+    auto stmt0 = main->context()->add< TrivialStatement >();
+    stmt0->add< UpdateInstruction >( location( stmt0, x ), constant( 1 ) );
+
+    auto stmt1 = main->context()->add< TrivialStatement >();
+    auto loc = location( stmt1, x );
+    auto val = stmt1->add< LookupInstruction >( loc );
+    stmt1->add< UpdateInstruction >( loc, val );
+
+    EXPECT_EQ( pass.optimize( *main ), 0 );
+    EXPECT_EQ( stmt0->instructions().size(), 2 );
+    EXPECT_EQ( stmt1->instructions().size(), 3 );
+}
+
+TEST( libcasm_ir__transform_StateAccessEliminationPass, rule_parameter_may_alias )
+{
+    StateAccessEliminationPass pass;
+
+    const auto f = unary();
+    const auto a = Memory::make< Identifier >( INTEGER, "a" );
+    auto main = rule( TEST_NAME );
+    main->addParameter( a );
+    auto seq = SequentialBlock::create();
+    main->context()->add( seq );
+
+    auto stmt0 = seq->add< TrivialStatement >();
+    stmt0->add< UpdateInstruction >( location( stmt0, f, constant( 1 ) ), constant( 1 ) );
+
+    auto stmt1 = seq->add< TrivialStatement >();
+    stmt1->add< UpdateInstruction >( location( stmt1, f, a ), constant( 2 ) );
+
+    auto stmt2 = seq->add< TrivialStatement >();
+    auto val = stmt2->add< LookupInstruction >( location( stmt2, f, constant( 1 ) ) );
+    auto sum = stmt2->add< AddInstruction >( val, constant( 1 ) );
+
+    EXPECT_EQ( pass.optimize( *main ), 0 );
+    EXPECT_EQ( stmt0->instructions().size(), 2 );
+    EXPECT_EQ( stmt1->instructions().size(), 2 );
+    EXPECT_EQ( sum->operand( 0 ), val );
+}
+
+TEST( libcasm_ir__transform_StateAccessEliminationPass, forall_variable_may_alias )
+{
+    StateAccessEliminationPass pass;
+
+    const auto f = unary();
+    const auto i = Memory::make< Identifier >( INTEGER, "i" );
+    const auto domain = Memory::make< DomainConstant >( INTEGER );
+    auto main = rule( TEST_NAME );
+
+    auto forall = main->context()->add< ForallStatement >( i, domain );
+    auto seq = SequentialBlock::create();
+    forall->add( seq );
+
+    auto stmt0 = seq->add< TrivialStatement >();
+    auto val0 = stmt0->add< LookupInstruction >( location( stmt0, f, constant( 1 ) ) );
+
+    auto stmt1 = seq->add< TrivialStatement >();
+    stmt1->add< UpdateInstruction >( location( stmt1, f, i ), val0 );
+
+    auto stmt2 = seq->add< TrivialStatement >();
+    auto val1 = stmt2->add< LookupInstruction >( location( stmt2, f, constant( 1 ) ) );
+    auto sum = stmt2->add< AddInstruction >( val1, constant( 1 ) );
+
+    EXPECT_EQ( pass.optimize( *main ), 0 );
+    EXPECT_EQ( sum->operand( 0 ), val1 );
+}
+
+TEST( libcasm_ir__transform_StateAccessEliminationPass, equal_named_identifiers_are_unknown )
+{
+    StateAccessEliminationPass pass;
+
+    const auto f = unary();
+    const auto a = Memory::make< Identifier >( INTEGER, "a" );
+    const auto b = Memory::make< Identifier >( INTEGER, "a" );
+    ASSERT_TRUE( *a == *b );
+
+    auto main = rule( TEST_NAME );
+    main->addParameter( a );
+    auto forall = main->context()->add< ForallStatement >(
+        b, Memory::make< DomainConstant >( INTEGER ) );
+    auto seq = SequentialBlock::create();
+    forall->add( seq );
+
+    auto stmt0 = seq->add< TrivialStatement >();
+    stmt0->add< UpdateInstruction >( location( stmt0, f, a ), constant( 1 ) );
+
+    auto stmt1 = seq->add< TrivialStatement >();
+    auto val = stmt1->add< LookupInstruction >( location( stmt1, f, b ) );
+    auto sum = stmt1->add< AddInstruction >( val, constant( 1 ) );
+
+    EXPECT_EQ( pass.optimize( *main ), 0 );
+    EXPECT_EQ( sum->operand( 0 ), val );
+}
+
+TEST( libcasm_ir__transform_StateAccessEliminationPass, forall_domain )
+{
+    StateAccessEliminationPass pass;
+
+    const auto x = function();
+    auto main = rule( TEST_NAME );
+    auto seq = SequentialBlock::create();
+    main->context()->add( seq );
+
+    auto stmt = seq->add< TrivialStatement >();
+    auto val = stmt->add< LookupInstruction >( location( stmt, x ) );
+    stmt->add< AddInstruction >( val, constant( 1 ) );
+
+    auto forall = seq->add< ForallStatement >(
+        Memory::make< Identifier >( INTEGER, "i" ), constant( 1 ) );
+    auto domain = forall->add< LookupInstruction >( location( forall, x ) );
+    forall->setDomain( domain );
+    forall->add( ParallelBlock::create() );
+
+    EXPECT_EQ( pass.optimize( *main ), 1 );
+    EXPECT_EQ( forall->instructions().size(), 1 );
+    EXPECT_EQ( forall->domain(), val );
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -0,0 +1,176 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "main.h"
+
+using namespace libcasm_ir;
+using namespace libstdhl;
+
+static Function::Ptr function( const std::string& name )
+{
+    const auto INTEGER = Memory::get< IntegerType >();
+    return Memory::make< Function >( name, Memory::make< RelationType >( INTEGER, Types() ) );
+}
+
+TEST( libcasm_ir_User, uses_of_operands )
+{
+    const auto x = function( "x" );
+    const auto c = Memory::make< IntegerConstant >( 1 );
+
+    EXPECT_TRUE( static_cast< User& >( *x ).uses().empty() );
+
+    auto a = Memory::make< LocationInstruction >( x, std::vector< Value::Ptr >{} );
+    auto b = Memory::make< LocationInstruction >( x, std::vector< Value::Ptr >{} );
+    auto l = Memory::make< LookupInstruction >( a );
+    auto s = Memory::make< AddInstruction >( l, c );
+
+    EXPECT_EQ( static_cast< User& >( *x ).uses().size(), 2u );
+    EXPECT_EQ( a->uses().size(), 1u );
+    EXPECT_EQ( &a->uses().begin()->use(), l.get() );
+    EXPECT_EQ( &l->uses().begin()->use(), s.get() );
+    EXPECT_EQ( s->position( *l->uses().begin() ), 0 );
+
+    b.reset();
+    EXPECT_EQ( static_cast< User& >( *x ).uses().size(), 1u );
+
+    s.reset();
+    EXPECT_TRUE( l->uses().empty() );
+}
+
+TEST( libcasm_ir_User, replace_all_uses_with )
+{
+    const auto x = function( "x" );
+    const auto y = function( "y" );
+
+    auto a = Memory::make< LocationInstruction >( x, std::vector< Value::Ptr >{} );
+    auto b = Memory::make< LocationInstruction >( y, std::vector< Value::Ptr >{} );
+    auto l = Memory::make< LookupInstruction >( a );
+    auto u = Memory::make< UpdateInstruction >( a, l );
+
+    EXPECT_EQ( a->uses().size(), 2u );
+
+    a->replaceAllUsesWith( b );
+
+    EXPECT_TRUE( a->uses().empty() );
+    EXPECT_EQ( b->uses().size(), 2u );
+    EXPECT_EQ( l->operand( 0 ), b );
+    EXPECT_EQ( u->operand( 0 ), b );
+    EXPECT_EQ( u->operand( 1 ), l );
+}
+
+TEST( libcasm_ir_User, replace_forall_domain )
+{
+    const auto INTEGER = Memory::get< IntegerType >();
+    const auto x = function( "x" );
+    const auto c = Memory::make< IntegerConstant >( 1 );
+
+    auto a = Memory::make< LocationInstruction >( x, std::vector< Value::Ptr >{} );
+    auto l = Memory::make< LookupInstruction >( a );
+    auto forall = Memory::make< ForallStatement >( Memory::make< Identifier >( INTEGER, "i" ), l );
+
+    ASSERT_EQ( l->uses().size(), 1u );
+    EXPECT_EQ( &l->uses().begin()->use(), forall.get() );
+
+    l->replaceAllUsesWith( c );
+
+    EXPECT_TRUE( l->uses().empty() );
+    EXPECT_EQ( forall->domain(), c );
+
+    forall->setDomain( l );
+    EXPECT_EQ( l->uses().size(), 1u );
+
+    forall.reset();
+    EXPECT_TRUE( l->uses().empty() );
+}
+
+TEST( libcasm_ir_User, replace_operand_by_identity )
+{
+    const auto a = Memory::make< IntegerConstant >( 1 );
+    const auto b = Memory::make< IntegerConstant >( 1 );
+    const auto c = Memory::make< IntegerConstant >( 2 );
+
+    auto s = Memory::make< AddInstruction >( a, b );
+    ASSERT_TRUE( *a == *b );
+
+    s->replace( *b, c );
+
+    EXPECT_EQ( s->operand( 0 ), a );
+    EXPECT_EQ( s->operand( 1 ), c );
+}
+
+TEST( libcasm_ir_User, copy_and_move_operand_slots )
+{
+    const auto x = function( "x" );
+
+    auto a = Memory::make< LocationInstruction >( x, std::vector< Value::Ptr >{} );
+
+    std::vector< LookupInstruction > lookups;
+    for( std::size_t c = 0; c < 16; c++ )
+    {
+        lookups.emplace_back( a );
+    }
+    EXPECT_EQ( a->uses().size(), 16u );
+
+    {
+        const auto copy = lookups.front();
+        EXPECT_EQ( a->uses().size(), 17u );
+    }
+    EXPECT_EQ( a->uses().size(), 16u );
+
+    for( const auto& use : a->uses() )
+    {
+        EXPECT_EQ( &use.def(), a.get() );
+        EXPECT_EQ( static_cast< const Instruction& >( use.use() ).operand( 0 ), a );
+    }
+
+    lookups.clear();
+    EXPECT_TRUE( a->uses().empty() );
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
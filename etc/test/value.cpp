@@ -143,6 +143,11 @@ TEST( libcasm_ir_Value, id_to_token_string )
                 EXPECT_STREQ( Value::token( id ).c_str(), "BranchStatement" );
                 break;
             }
+            case Value::FORALL_STATEMENT:
+            {
+                EXPECT_STREQ( Value::token( id ).c_str(), "ForallStatement" );
+                break;
+            }
 
             case Value::CONSTANT:
             {
@@ -699,6 +704,71 @@ TEST( libcasm_ir_Value, id_to_token_string )
     }
 }
 
+static Rule::Ptr rule( void )
+{
+    auto rule = libstdhl::Memory::make< Rule >(
+        "rule", libstdhl::Memory::make< RelationType >( libstdhl::Memory::get< VoidType >() ) );
+    rule->setContext( ParallelBlock::create() );
+
+    auto stmt = rule->context()->add< TrivialStatement >();
+    stmt->add< SkipInstruction >();
+
+    auto val_T = libstdhl::Memory::get< BooleanConstant >( true );
+    auto br0 = rule->context()->add< BranchStatement >();
+    auto lbl_T = br0->add( SequentialBlock::create() );
+    lbl_T->add< TrivialStatement >()->add< SkipInstruction >();
+    br0->add< SelectInstruction >( val_T, std::initializer_list< Value::Ptr >{ val_T, lbl_T } );
+
+    return rule;
+}
+
+static void iterate( const Traversal order )
+{
+    auto value = rule();
+
+    std::vector< Value* > expected;
+    TraversalVisitor visitor( order, [&expected]( Value& v ) { expected.emplace_back( &v ); } );
+    value->accept( visitor );
+
+    std::vector< Value* > result;
+    const auto callback = [&result]( Value& v ) { result.emplace_back( &v ); };
+    if( order == Traversal::PREORDER )
+    {
+        EXPECT_TRUE( value->iterate< Traversal::PREORDER >( callback ) );
+    }
+    else
+    {
+        EXPECT_TRUE( value->iterate< Traversal::POSTORDER >( callback ) );
+    }
+
+    EXPECT_FALSE( result.empty() );
+    EXPECT_EQ( result, expected );
+}
+
+TEST( libcasm_ir_Value, iterate_preorder )
+{
+    iterate( Traversal::PREORDER );
+}
+
+TEST( libcasm_ir_Value, iterate_postorder )
+{
+    iterate( Traversal::POSTORDER );
+}
+
+TEST( libcasm_ir_Value, iterate_terminate )
+{
+    auto value = rule();
+
+    std::size_t visits = 0;
+    const auto result = value->iterate< Traversal::PREORDER >( [&visits]( Value& v ) {
+        visits++;
+        return not isa< Statement >( v );
+    } );
+
+    EXPECT_FALSE( result );
+    EXPECT_EQ( visits, 3u );
+}
+
 //
 //  Local variables:
 //  mode: c++
@@ -0,0 +1,140 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "main.h"
+
+#include <cstdio>
+#include <fstream>
+
+using namespace libcasm_ir;
+
+TEST( libcasm_ir_Writer, same_representation_as_stream )
+{
+    const int value = 0;
+    const void* pointers[] = { nullptr, &value };
+    const i64 numbers[] = { 0, 1, -1, 42, -1234567890, std::numeric_limits< i64 >::min(),
+                            std::numeric_limits< i64 >::max() };
+
+    std::string buffer;
+    std::stringstream stream;
+    {
+        Writer writer( buffer );
+
+        for( const auto pointer : pointers )
+        {
+            writer << pointer << ' ';
+            stream << pointer << ' ';
+        }
+        for( const auto number : numbers )
+        {
+            writer << number << ", ";
+            stream << number << ", ";
+        }
+
+        writer << std::numeric_limits< u64 >::max() << 'c' << std::string( "str" ) << "\n";
+        stream << std::numeric_limits< u64 >::max() << 'c' << std::string( "str" ) << "\n";
+    }
+
+    EXPECT_EQ( buffer, stream.str() );
+}
+
+TEST( libcasm_ir_Writer, buffer_capacity )
+{
+    std::string buffer;
+    Writer writer( buffer, 4 );
+
+    writer << "abc";
+    EXPECT_TRUE( buffer.empty() );
+
+    writer << "de";
+    EXPECT_EQ( buffer, "abc" );
+
+    writer << std::string( 16, 'x' );
+    EXPECT_EQ( buffer, "abcde" + std::string( 16, 'x' ) );
+
+    writer << 'f';
+    writer.flush();
+    EXPECT_EQ( buffer, "abcde" + std::string( 16, 'x' ) + "f" );
+}
+
+TEST( libcasm_ir_Writer, stream_target )
+{
+    std::stringstream stream;
+    {
+        Writer writer( stream );
+        writer << "text " << 123u;
+        EXPECT_TRUE( stream.str().empty() );
+    }
+
+    EXPECT_EQ( stream.str(), "text 123" );
+}
+
+TEST( libcasm_ir_Writer, file_target )
+{
+    const std::string path = "libcasm_ir_Writer_file_target.txt";
+    {
+        const auto writer = Writer::file( path, 4 );
+        *writer << "text " << 123u << '\n';
+    }
+
+    std::ifstream file( path );
+    const std::string content(
+        ( std::istreambuf_iterator< char >( file ) ), std::istreambuf_iterator< char >() );
+    file.close();
+    std::remove( path.c_str() );
+
+    EXPECT_EQ( content, "text 123\n" );
+}
+
+TEST( libcasm_ir_Writer, file_target_invalid_path )
+{
+    EXPECT_THROW( Writer::file( "libcasm_ir_Writer/missing/directory.txt" ), std::domain_error );
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
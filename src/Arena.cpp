@@ -0,0 +1,116 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "Arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+using namespace libcasm_ir;
+
+static thread_local Arena::Ptr s_active = nullptr;
+
+static inline std::size_t padding( const u8* position, const std::size_t alignment )
+{
+    return ( alignment - ( reinterpret_cast< std::uintptr_t >( position ) % alignment ) ) %
+           alignment;
+}
+
+Arena::Arena( const std::size_t chunkSize )
+: m_chunkSize( chunkSize )
+, m_chunks()
+, m_position( nullptr )
+, m_available( 0 )
+, m_size( 0 )
+{
+}
+
+void* Arena::allocate( const std::size_t size, const std::size_t alignment )
+{
+    auto offset = padding( m_position, alignment );
+
+    if( m_position == nullptr or ( size + offset ) > m_available )
+    {
+        const auto chunkSize = std::max( m_chunkSize, size + alignment );
+        m_chunks.emplace_back( new u8[ chunkSize ] );
+        m_position = m_chunks.back().get();
+        m_available = chunkSize;
+
+        offset = padding( m_position, alignment );
+    }
+
+    auto memory = m_position + offset;
+    m_position += offset + size;
+    m_available -= offset + size;
+    m_size += size;
+
+    return memory;
+}
+
+std::size_t Arena::size( void ) const
+{
+    return m_size;
+}
+
+std::size_t Arena::chunks( void ) const
+{
+    return m_chunks.size();
+}
+
+const Arena::Ptr& Arena::active( void )
+{
+    return s_active;
+}
+
+Arena::Scope::Scope( const Arena::Ptr& arena )
+: ThreadScope( s_active, arena )
+{
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
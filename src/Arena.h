@@ -0,0 +1,205 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#ifndef _LIBCASM_IR_ARENA_H_
+#define _LIBCASM_IR_ARENA_H_
+
+#include <libcasm-ir/CasmIR>
+#include <libcasm-ir/ThreadScope>
+
+#include <libstdhl/Memory>
+
+#include <memory>
+#include <vector>
+
+namespace libcasm_ir
+{
+    /**
+       @brief bump allocator for IR nodes
+
+       An arena hands out memory from large chunks and never frees single
+       allocations, all chunks are released at once after the last node which
+       was allocated in the arena is gone. IR nodes (object and shared
+       pointer control block) are placed into the arena which is activated
+       for the current thread by an Arena::Scope, otherwise they are heap
+       allocated as usual. Only nodes created while the scope is alive are
+       placed into the arena, a builder shall hold the scope for the whole
+       construction of a specification. An arena is not thread-safe, nodes
+       shall only be created by the thread which activated the arena.
+    */
+    class Arena final
+    {
+      public:
+        using Ptr = std::shared_ptr< Arena >;
+
+        explicit Arena( const std::size_t chunkSize = 64 * 1024 );
+
+        Arena( const Arena& other ) = delete;
+
+        Arena& operator=( const Arena& other ) = delete;
+
+        void* allocate( const std::size_t size, const std::size_t alignment );
+
+        /**
+           @return number of bytes allocated in the arena
+        */
+        std::size_t size( void ) const;
+
+        std::size_t chunks( void ) const;
+
+        class Scope final : public ThreadScope< Arena::Ptr >
+        {
+          public:
+            explicit Scope( const Arena::Ptr& arena );
+        };
+
+        static const Arena::Ptr& active( void );
+
+        template < typename T >
+        class Allocator
+        {
+          public:
+            using value_type = T;
+
+            Allocator( const Arena::Ptr& arena )
+            : m_arena( arena )
+            {
+            }
+
+            template < typename U >
+            Allocator( const Allocator< U >& other )
+            : m_arena( other.arena() )
+            {
+            }
+
+            T* allocate( const std::size_t n )
+            {
+                return static_cast< T* >( m_arena->allocate( n * sizeof( T ), alignof( T ) ) );
+            }
+
+            void deallocate( T*, const std::size_t )
+            {
+                // memory is released together with the arena
+            }
+
+            const Arena::Ptr& arena( void ) const
+            {
+                return m_arena;
+            }
+
+            template < typename U >
+            u1 operator==( const Allocator< U >& rhs ) const
+            {
+                return m_arena == rhs.arena();
+            }
+
+            template < typename U >
+            u1 operator!=( const Allocator< U >& rhs ) const
+            {
+                return m_arena != rhs.arena();
+            }
+
+          private:
+            Arena::Ptr m_arena;
+        };
+
+        template < typename T, typename... Args >
+        static std::shared_ptr< T > make( Args&&... args )
+        {
+            const auto& arena = active();
+            if( not arena )
+            {
+                return libstdhl::Memory::make< T >( std::forward< Args >( args )... );
+            }
+
+            return std::allocate_shared< T >(
+                Allocator< T >( arena ), std::forward< Args >( args )... );
+        }
+
+        /**
+           storage for objects with non-public constructors, the object has to
+           be constructed in place and then handed to 'adopt'
+        */
+        template < typename T >
+        static void* allocate( void )
+        {
+            const auto& arena = active();
+            if( not arena )
+            {
+                return ::operator new( sizeof( T ) );
+            }
+
+            return arena->allocate( sizeof( T ), alignof( T ) );
+        }
+
+        template < typename T >
+        static std::shared_ptr< T > adopt( T* object )
+        {
+            const auto& arena = active();
+            if( not arena )
+            {
+                return std::shared_ptr< T >( object );
+            }
+
+            return std::shared_ptr< T >(
+                object, []( T* obj ) { obj->~T(); }, Allocator< T >( arena ) );
+        }
+
+      private:
+        const std::size_t m_chunkSize;
+        std::vector< std::unique_ptr< u8[] > > m_chunks;
+        u8* m_position;
+        std::size_t m_available;
+        std::size_t m_size;
+    };
+}
+
+#endif  // _LIBCASM_IR_ARENA_H_
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
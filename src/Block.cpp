@@ -135,18 +135,18 @@ ExecutionSemanticsBlock::Ptr ExecutionSemanticsBlock::init( void )
 {
     auto self = ptr_this< ExecutionSemanticsBlock >();
 
-    m_entry = libstdhl::Memory::make< TrivialStatement >();
+    m_entry = Arena::make< TrivialStatement >();
     m_entry->setScope( self );
     m_entry->setParent( self );
 
-    auto f = libstdhl::Memory::make< ForkInstruction >();
+    auto f = Arena::make< ForkInstruction >();
     m_entry->add( f );
 
-    m_exit = libstdhl::Memory::make< TrivialStatement >();
+    m_exit = Arena::make< TrivialStatement >();
     m_exit->setScope( self );
     m_exit->setParent( self );
 
-    auto m = libstdhl::Memory::make< MergeInstruction >();
+    auto m = Arena::make< MergeInstruction >();
     m_exit->add( m );
 
     return self;
@@ -239,7 +239,7 @@ u1 ExecutionSemanticsBlock::classof( Value const* obj )
 
 ParallelBlock::Ptr ParallelBlock::create( u1 empty )
 {
-    auto block = std::shared_ptr< ParallelBlock >( new ParallelBlock );
+    auto block = Arena::adopt( new( Arena::allocate< ParallelBlock >() ) ParallelBlock );
 
     if( not empty )
     {
@@ -309,7 +309,7 @@ u1 ParallelBlock::classof( Value const* obj )
 
 SequentialBlock::Ptr SequentialBlock::create( u1 empty )
 {
-    auto block = std::shared_ptr< SequentialBlock >( new SequentialBlock );
+    auto block = Arena::adopt( new( Arena::allocate< SequentialBlock >() ) SequentialBlock );
 
     if( not empty )
     {
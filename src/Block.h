@@ -42,6 +42,7 @@
 #ifndef _LIBCASM_IR_BLOCK_H_
 #define _LIBCASM_IR_BLOCK_H_
 
+#include <libcasm-ir/Arena>
 #include <libcasm-ir/Value>
 
 namespace libcasm_ir
@@ -115,7 +116,7 @@ namespace libcasm_ir
         template < typename T, typename... Args >
         typename T::Ptr add( Args&&... args )
         {
-            auto obj = libstdhl::Memory::make< T >( std::forward< Args >( args )... );
+            auto obj = Arena::make< T >( std::forward< Args >( args )... );
             add( obj );
             return obj;
         }
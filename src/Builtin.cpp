@@ -44,6 +44,7 @@
 #include <libcasm-ir/Constant>
 #include <libcasm-ir/Exception>
 #include <libcasm-ir/Instruction>
+#include <libcasm-ir/OutputSink>
 
 #include <cassert>
 
@@ -56,8 +57,89 @@ static const auto DECIMAL = libstdhl::Memory::get< DecimalType >();
 static const auto RATIONAL = libstdhl::Memory::get< RationalType >();
 static const auto STRING = libstdhl::Memory::get< StringType >();
 
+static const char DIGITS[] = "0123456789abcdef";
+
+static const char DECIMAL_PAIRS[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/**
+   formats integer and binary constants which fit into a machine word
+   directly into a stack buffer (two digits per step for decimals, table
+   lookup of the digit bits for the power of two radixes), all other values
+   are left to the libstdhl conversion
+*/
+static u1 stringify_native( const Constant& constant, const u8 radix, Constant& res )
+{
+    const auto& data = constant.data();
+    if( not data.trivial() )
+    {
+        return false;
+    }
+
+    u64 value = data.value();
+    const u1 sign = data.sign() and value != 0;
+    if( sign and radix != 10 )
+    {
+        return false;
+    }
+
+    char buffer[ 65 ];
+    char* const end = buffer + sizeof( buffer );
+    char* position = end;
+
+    if( radix == 10 )
+    {
+        while( value >= 100 )
+        {
+            const auto pair = ( value % 100 ) * 2;
+            value /= 100;
+            *( --position ) = DECIMAL_PAIRS[ pair + 1 ];
+            *( --position ) = DECIMAL_PAIRS[ pair ];
+        }
+
+        if( value >= 10 )
+        {
+            *( --position ) = DECIMAL_PAIRS[ value * 2 + 1 ];
+            *( --position ) = DECIMAL_PAIRS[ value * 2 ];
+        }
+        else
+        {
+            *( --position ) = DIGITS[ value ];
+        }
+
+        if( sign )
+        {
+            *( --position ) = '-';
+        }
+    }
+    else
+    {
+        const u8 shift = ( radix == 16 ) ? 4 : ( radix == 8 ) ? 3 : 1;
+        const u64 mask = radix - 1;
+
+        do
+        {
+            *( --position ) = DIGITS[ value & mask ];
+            value >>= shift;
+        } while( value != 0 );
+    }
+
+    res = StringConstant( std::string( position, end - position ) );
+    return true;
+}
+
 Builtin::Builtin( const Type::Ptr& type, const Value::ID id )
 : User( type, id )
+, m_kernel( nullptr )
 {
 }
 
@@ -129,7 +211,26 @@ u1 Builtin::available( const std::string& token )
     return true;
 }
 
+Builtin::Kernel Builtin::kernel( void ) const
+{
+    return m_kernel;
+}
+
+static Builtin::Ptr instantiate( const Value::ID id, const Type::Ptr& type );
+
 Builtin::Ptr Builtin::create( const Value::ID id, const Type::Ptr& type )
+{
+    auto builtin = instantiate( id, type );
+
+    if( builtin )
+    {
+        builtin->m_kernel = select( id, *type );
+    }
+
+    return builtin;
+}
+
+static Builtin::Ptr instantiate( const Value::ID id, const Type::Ptr& type )
 {
     switch( id )
     {
@@ -151,6 +252,7 @@ Builtin::Ptr Builtin::create( const Value::ID id, const Type::Ptr& type )
         case Value::STATEMENT:                    // [fallthrough]
         case Value::TRIVIAL_STATEMENT:            // [fallthrough]
         case Value::BRANCH_STATEMENT:             // [fallthrough]
+        case Value::FORALL_STATEMENT:             // [fallthrough]
         case Value::CONSTANT:                     // [fallthrough]
         case Value::VOID_CONSTANT:                // [fallthrough]
         case Value::RULE_REFERENCE_CONSTANT:      // [fallthrough]
@@ -418,6 +520,223 @@ Builtin::Ptr Builtin::create( const Value::ID id, const Type::Ptr& type )
     return nullptr;
 }
 
+//
+// Builtin Kernels
+//
+
+// kernels are only selected for unary relations, therefore the register
+// size is always one and not checked again
+
+template < Value::ID ID, Type::Kind KIND >
+static void builtin_kernel( Constant& res, const Constant* reg, const std::size_t );
+
+template <>
+void builtin_kernel< Value::AS_BOOLEAN_BUILTIN, Type::Kind::BOOLEAN >(
+    Constant& res, const Constant* reg, const std::size_t )
+{
+    res = reg[ 0 ];
+}
+
+template <>
+void builtin_kernel< Value::AS_BOOLEAN_BUILTIN, Type::Kind::INTEGER >(
+    Constant& res, const Constant* reg, const std::size_t )
+{
+    const auto& arg = static_cast< const IntegerConstant& >( reg[ 0 ] );
+    res = arg.defined() ? BooleanConstant( arg.value() != 0 ) : BooleanConstant();
+}
+
+template <>
+void builtin_kernel< Value::AS_BOOLEAN_BUILTIN, Type::Kind::BINARY >(
+    Constant& res, const Constant* reg, const std::size_t )
+{
+    const auto& arg = static_cast< const BinaryConstant& >( reg[ 0 ] );
+    res = arg.defined() ? BooleanConstant( arg.value() != 0 ) : BooleanConstant();
+}
+
+template <>
+void builtin_kernel< Value::AS_INTEGER_BUILTIN, Type::Kind::BOOLEAN >(
+    Constant& res, const Constant* reg, const std::size_t )
+{
+    const auto& arg = static_cast< const BooleanConstant& >( reg[ 0 ] );
+    res = arg.defined() ? IntegerConstant( arg.value() == true ? 1 : 0 ) : IntegerConstant();
+}
+
+template <>
+void builtin_kernel< Value::AS_INTEGER_BUILTIN, Type::Kind::INTEGER >(
+    Constant& res, const Constant* reg, const std::size_t )
+{
+    res = reg[ 0 ];
+}
+
+template <>
+void builtin_kernel< Value::AS_INTEGER_BUILTIN, Type::Kind::BINARY >(
+    Constant& res, const Constant* reg, const std::size_t )
+{
+    const auto& arg = reg[ 0 ];
+
+    if( not arg.defined() )
+    {
+        res = IntegerConstant();
+        return;
+    }
+
+    const auto& t = static_cast< const BinaryType& >( arg.type() );
+    const auto& c = static_cast< const BinaryConstant& >( arg ).value();
+
+    if( c.isSet( t.bitsize() ) )
+    {
+        Operation::execute< InvInstruction >( t.ptr_type(), res, arg );
+        const auto& r = static_cast< const BinaryConstant& >( res ).value();
+        res = IntegerConstant( r, true );
+    }
+    else
+    {
+        res = IntegerConstant( c );
+    }
+}
+
+template < u8 RADIX, libstdhl::Type::Radix TO, typename T >
+static void stringify_kernel( Constant& res, const Constant* reg, const std::size_t )
+{
+    const auto& arg = reg[ 0 ];
+
+    if( not arg.defined() )
+    {
+        res = StringConstant();
+        return;
+    }
+
+    if( not stringify_native( arg, RADIX, res ) )
+    {
+        const auto& c = static_cast< const T& >( arg ).value();
+        res = StringConstant( c.template to< TO, libstdhl::Type::Literal::NONE >() );
+    }
+}
+
+template < typename T >
+static Builtin::Kernel stringify_select( const Value::ID id )
+{
+    switch( id )
+    {
+        case Value::AS_STRING_BUILTIN:  // [fallthrough]
+        case Value::DEC_BUILTIN:
+        {
+            return &stringify_kernel< 10, libstdhl::Type::Radix::DECIMAL, T >;
+        }
+        case Value::HEX_BUILTIN:
+        {
+            return &stringify_kernel< 16, libstdhl::Type::Radix::HEXADECIMAL, T >;
+        }
+        case Value::OCT_BUILTIN:
+        {
+            return &stringify_kernel< 8, libstdhl::Type::Radix::OCTAL, T >;
+        }
+        case Value::BIN_BUILTIN:
+        {
+            return &stringify_kernel< 2, libstdhl::Type::Radix::BINARY, T >;
+        }
+        default:
+        {
+            return nullptr;
+        }
+    }
+}
+
+Builtin::Kernel Builtin::select( const Value::ID id, const Type& type )
+{
+    if( not type.isRelation() )
+    {
+        return nullptr;
+    }
+
+    const auto& relation = static_cast< const RelationType& >( type );
+    if( relation.arguments().size() != 1 )
+    {
+        return nullptr;
+    }
+
+    const auto kind = ( *relation.arguments().begin() )->kind();
+
+    switch( id )
+    {
+        case Value::AS_BOOLEAN_BUILTIN:
+        {
+            switch( kind )
+            {
+                case Type::Kind::BOOLEAN:
+                {
+                    return &builtin_kernel< Value::AS_BOOLEAN_BUILTIN, Type::Kind::BOOLEAN >;
+                }
+                case Type::Kind::INTEGER:
+                {
+                    return &builtin_kernel< Value::AS_BOOLEAN_BUILTIN, Type::Kind::INTEGER >;
+                }
+                case Type::Kind::BINARY:
+                {
+                    return &builtin_kernel< Value::AS_BOOLEAN_BUILTIN, Type::Kind::BINARY >;
+                }
+                default:
+                {
+                    break;
+                }
+            }
+            break;
+        }
+        case Value::AS_INTEGER_BUILTIN:
+        {
+            switch( kind )
+            {
+                case Type::Kind::BOOLEAN:
+                {
+                    return &builtin_kernel< Value::AS_INTEGER_BUILTIN, Type::Kind::BOOLEAN >;
+                }
+                case Type::Kind::INTEGER:
+                {
+                    return &builtin_kernel< Value::AS_INTEGER_BUILTIN, Type::Kind::INTEGER >;
+                }
+                case Type::Kind::BINARY:
+                {
+                    return &builtin_kernel< Value::AS_INTEGER_BUILTIN, Type::Kind::BINARY >;
+                }
+                default:
+                {
+                    break;
+                }
+            }
+            break;
+        }
+        case Value::AS_STRING_BUILTIN:  // [fallthrough]
+        case Value::DEC_BUILTIN:        // [fallthrough]
+        case Value::HEX_BUILTIN:        // [fallthrough]
+        case Value::OCT_BUILTIN:        // [fallthrough]
+        case Value::BIN_BUILTIN:
+        {
+            switch( kind )
+            {
+                case Type::Kind::INTEGER:
+                {
+                    return stringify_select< IntegerConstant >( id );
+                }
+                case Type::Kind::BINARY:
+                {
+                    return stringify_select< BinaryConstant >( id );
+                }
+                default:
+                {
+                    break;
+                }
+            }
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+
+    return nullptr;
+}
+
 //------------------------------------------------------------------------------
 
 //
@@ -967,9 +1286,9 @@ void PrintBuiltin::execute( Constant& res, const Constant* reg, const std::size_
 {
     const auto& txt = reg[ 0 ];
     assert( txt.type().isString() );
-    const auto stringConstant = static_cast< const StringConstant& >( txt );
+    const auto& stringConstant = static_cast< const StringConstant& >( txt );
 
-    std::cout << stringConstant.toString();
+    OutputSink::print( stringConstant );
 
     res = VoidConstant();
 }
@@ -1043,9 +1362,10 @@ void PrintLnBuiltin::execute( Constant& res, const Constant* reg, const std::siz
 {
     const auto& txt = reg[ 0 ];
     assert( txt.type().isString() );
-    const auto stringConstant = static_cast< const StringConstant& >( txt );
+    const auto& stringConstant = static_cast< const StringConstant& >( txt );
 
-    std::cout << stringConstant.toString() << "\n";
+    OutputSink::print( stringConstant );
+    OutputSink::print( "\n" );
 
     res = VoidConstant();
 }
@@ -1560,6 +1880,12 @@ void AsStringBuiltin::execute( Constant& res, const Constant* reg, const std::si
 
     if( arg.defined() )
     {
+        if( ( isa< IntegerConstant >( arg ) or isa< BinaryConstant >( arg ) ) and
+            stringify_native( arg, 10, res ) )
+        {
+            return;
+        }
+
         res = StringConstant( arg.name() );
     }
     else
@@ -2039,6 +2365,11 @@ void DecBuiltin::execute( Constant& res, const Constant* reg, const std::size_t
             }
             case Type::Kind::INTEGER:
             {
+                if( stringify_native( arg, 10, res ) )
+                {
+                    break;
+                }
+
                 const auto& c = static_cast< const IntegerConstant& >( arg ).value();
                 res = StringConstant(
                     c.to< libstdhl::Type::Radix::DECIMAL, libstdhl::Type::Literal::NONE >() );
@@ -2046,6 +2377,11 @@ void DecBuiltin::execute( Constant& res, const Constant* reg, const std::size_t
             }
             case Type::Kind::BINARY:
             {
+                if( stringify_native( arg, 10, res ) )
+                {
+                    break;
+                }
+
                 const auto& c = static_cast< const BinaryConstant& >( arg ).value();
                 res = StringConstant(
                     c.to< libstdhl::Type::Radix::DECIMAL, libstdhl::Type::Literal::NONE >() );
@@ -2122,6 +2458,11 @@ void HexBuiltin::execute( Constant& res, const Constant* reg, const std::size_t
             }
             case Type::Kind::INTEGER:
             {
+                if( stringify_native( arg, 16, res ) )
+                {
+                    break;
+                }
+
                 const auto& c = static_cast< const IntegerConstant& >( arg ).value();
                 res = StringConstant(
                     c.to< libstdhl::Type::Radix::HEXADECIMAL, libstdhl::Type::Literal::NONE >() );
@@ -2129,6 +2470,11 @@ void HexBuiltin::execute( Constant& res, const Constant* reg, const std::size_t
             }
             case Type::Kind::BINARY:
             {
+                if( stringify_native( arg, 16, res ) )
+                {
+                    break;
+                }
+
                 const auto& c = static_cast< const BinaryConstant& >( arg ).value();
                 res = StringConstant(
                     c.to< libstdhl::Type::Radix::HEXADECIMAL, libstdhl::Type::Literal::NONE >() );
@@ -2205,6 +2551,11 @@ void OctBuiltin::execute( Constant& res, const Constant* reg, const std::size_t
             }
             case Type::Kind::INTEGER:
             {
+                if( stringify_native( arg, 8, res ) )
+                {
+                    break;
+                }
+
                 const auto& c = static_cast< const IntegerConstant& >( arg ).value();
                 res = StringConstant(
                     c.to< libstdhl::Type::Radix::OCTAL, libstdhl::Type::Literal::NONE >() );
@@ -2212,6 +2563,11 @@ void OctBuiltin::execute( Constant& res, const Constant* reg, const std::size_t
             }
             case Type::Kind::BINARY:
             {
+                if( stringify_native( arg, 8, res ) )
+                {
+                    break;
+                }
+
                 const auto& c = static_cast< const BinaryConstant& >( arg ).value();
                 res = StringConstant(
                     c.to< libstdhl::Type::Radix::OCTAL, libstdhl::Type::Literal::NONE >() );
@@ -2288,6 +2644,11 @@ void BinBuiltin::execute( Constant& res, const Constant* reg, const std::size_t
             }
             case Type::Kind::INTEGER:
             {
+                if( stringify_native( arg, 2, res ) )
+                {
+                    break;
+                }
+
                 const auto& c = static_cast< const IntegerConstant& >( arg ).value();
                 res = StringConstant(
                     c.to< libstdhl::Type::Radix::BINARY, libstdhl::Type::Literal::NONE >() );
@@ -2295,6 +2656,11 @@ void BinBuiltin::execute( Constant& res, const Constant* reg, const std::size_t
             }
             case Type::Kind::BINARY:
             {
+                if( stringify_native( arg, 2, res ) )
+                {
+                    break;
+                }
+
                 const auto& c = static_cast< const BinaryConstant& >( arg ).value();
                 res = StringConstant(
                     c.to< libstdhl::Type::Radix::BINARY, libstdhl::Type::Literal::NONE >() );
@@ -56,10 +56,36 @@ namespace libcasm_ir
       public:
         using Ptr = std::shared_ptr< Builtin >;
 
+        /**
+           execution function of a builtin which is specialized for one
+           concrete relation type, it omits the type dispatch of 'execute'
+        */
+        using Kernel = void ( * )( Constant& res, const Constant* reg, const std::size_t size );
+
         Builtin( const Type::Ptr& type, const Value::ID id = classid() );
 
         std::string name( void ) const override final;
 
+        /**
+           @return specialized kernel selected by 'Builtin::create' or nullptr
+        */
+        Kernel kernel( void ) const;
+
+        /**
+           executes the specialized kernel if available, otherwise 'execute'
+        */
+        inline void invoke( Constant& res, const Constant* reg, const std::size_t size ) const
+        {
+            if( m_kernel )
+            {
+                m_kernel( res, reg, size );
+            }
+            else
+            {
+                execute( res, reg, size );
+            }
+        }
+
         std::size_t hash( void ) const override;
 
         u1 operator==( const Value& rhs ) const override;
@@ -83,6 +109,15 @@ namespace libcasm_ir
         static u1 available( const std::string& token );
 
         static Builtin::Ptr create( const Value::ID id, const Type::Ptr& type );
+
+        /**
+           @return specialized kernel of builtin 'id' for the relation 'type'
+           or nullptr if the builtin has no kernel for this relation
+        */
+        static Kernel select( const Value::ID id, const Type& type );
+
+      private:
+        Kernel m_kernel;
     };
 
     using Builtins = ValueList< Builtin >;
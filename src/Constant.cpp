@@ -40,12 +40,13 @@
 //
 
 #include "Constant.h"
+#include "RandomStream.h"
 
 #include <libcasm-ir/Exception>
 #include <libcasm-ir/Instruction>
-#include <libstdhl/Random>
 #include <libstdhl/String>
 
+#include <algorithm>
 #include <cmath>
 
 #include <libtptp/Type>
@@ -1019,17 +1020,224 @@ u1 BinaryConstant::classof( Value const* obj )
     return obj->id() == classid();
 }
 
+//
+// String Layout
+//
+
+static constexpr std::size_t STRING_LEAF_SIZE = 64;
+
+static constexpr u64 STRING_HASH_BASE = 0x100000001b3;
+
+struct StringConstant::StringLayout::Node final
+{
+    using Ptr = std::shared_ptr< const Node >;
+
+    const std::string leaf;
+    const Ptr left;
+    const Ptr right;
+    const std::size_t length;
+    const std::size_t height;
+    const u64 hash;
+    const u64 power;
+
+    Node( std::string&& text )
+    : leaf( std::move( text ) )
+    , left( nullptr )
+    , right( nullptr )
+    , length( leaf.size() )
+    , height( 0 )
+    , hash( polynomial( leaf ) )
+    , power( power_of( leaf.size() ) )
+    {
+    }
+
+    Node( const Ptr& lhs, const Ptr& rhs )
+    : leaf()
+    , left( lhs )
+    , right( rhs )
+    , length( lhs->length + rhs->length )
+    , height( std::max( lhs->height, rhs->height ) + 1 )
+    , hash( lhs->hash * rhs->power + rhs->hash )
+    , power( lhs->power * rhs->power )
+    {
+    }
+
+    void flatten( std::string& result ) const
+    {
+        if( height == 0 )
+        {
+            result.append( leaf );
+            return;
+        }
+
+        left->flatten( result );
+        right->flatten( result );
+    }
+
+    static u64 power_of( std::size_t exponent )
+    {
+        u64 result = 1;
+        u64 base = STRING_HASH_BASE;
+
+        while( exponent != 0 )
+        {
+            if( exponent & 1 )
+            {
+                result *= base;
+            }
+            base *= base;
+            exponent >>= 1;
+        }
+
+        return result;
+    }
+
+    static u64 polynomial( const std::string& text )
+    {
+        u64 result = 0;
+        for( const auto character : text )
+        {
+            result = result * STRING_HASH_BASE + ( u8 )( character );
+        }
+        return result;
+    }
+
+    static Ptr join( const Ptr& lhs, const Ptr& rhs )
+    {
+        if( lhs->length == 0 )
+        {
+            return rhs;
+        }
+
+        if( rhs->length == 0 )
+        {
+            return lhs;
+        }
+
+        if( ( lhs->length + rhs->length ) <= STRING_LEAF_SIZE )
+        {
+            std::string text;
+            text.reserve( lhs->length + rhs->length );
+            lhs->flatten( text );
+            rhs->flatten( text );
+            return std::make_shared< const Node >( std::move( text ) );
+        }
+
+        // join along the spine of the higher tree (AVL join), only the
+        // nodes on this path are created, all others are shared
+
+        if( lhs->height > rhs->height + 1 )
+        {
+            return balance( lhs->left, join( lhs->right, rhs ) );
+        }
+
+        if( rhs->height > lhs->height + 1 )
+        {
+            return balance( join( lhs, rhs->left ), rhs->right );
+        }
+
+        return std::make_shared< const Node >( lhs, rhs );
+    }
+
+    static Ptr balance( const Ptr& lhs, const Ptr& rhs )
+    {
+        if( lhs->height > rhs->height + 1 )
+        {
+            if( lhs->left->height >= lhs->right->height )
+            {
+                return std::make_shared< const Node >(
+                    lhs->left, std::make_shared< const Node >( lhs->right, rhs ) );
+            }
+
+            return std::make_shared< const Node >(
+                std::make_shared< const Node >( lhs->left, lhs->right->left ),
+                std::make_shared< const Node >( lhs->right->right, rhs ) );
+        }
+
+        if( rhs->height > lhs->height + 1 )
+        {
+            if( rhs->right->height >= rhs->left->height )
+            {
+                return std::make_shared< const Node >(
+                    std::make_shared< const Node >( lhs, rhs->left ), rhs->right );
+            }
+
+            return std::make_shared< const Node >(
+                std::make_shared< const Node >( lhs, rhs->left->left ),
+                std::make_shared< const Node >( rhs->left->right, rhs->right ) );
+        }
+
+        return std::make_shared< const Node >( lhs, rhs );
+    }
+};
+
+StringConstant::StringLayout::StringLayout( const std::shared_ptr< const Node >& node )
+: m_node( node )
+{
+    assert( m_node );
+}
+
+const std::shared_ptr< const StringConstant::StringLayout::Node >&
+StringConstant::StringLayout::node( void ) const
+{
+    return m_node;
+}
+
+std::size_t StringConstant::StringLayout::length( void ) const
+{
+    return m_node->length;
+}
+
+std::string StringConstant::StringLayout::toString( void ) const
+{
+    if( m_node->height == 0 )
+    {
+        return m_node->leaf;
+    }
+
+    std::string result;
+    result.reserve( m_node->length );
+    m_node->flatten( result );
+    return result;
+}
+
+u1 StringConstant::StringLayout::operator==( const StringLayout& rhs ) const
+{
+    if( m_node == rhs.m_node )
+    {
+        return true;
+    }
+
+    if( m_node->length != rhs.m_node->length or m_node->hash != rhs.m_node->hash )
+    {
+        return false;
+    }
+
+    return toString() == rhs.toString();
+}
+
+std::size_t StringConstant::StringLayout::hash( void ) const
+{
+    return m_node->hash;
+}
+
+libstdhl::Type::Layout* StringConstant::StringLayout::clone( void ) const
+{
+    // nodes are immutable, therefore a clone shares the whole rope
+    return new StringLayout( m_node );
+}
+
 //
 // String Constant
 //
 
 StringConstant::StringConstant( const libstdhl::Type::String& value )
-: Constant( STRING, value, classid() )
+: StringConstant( value.toString() )
 {
 }
 
 StringConstant::StringConstant( const std::string& value )
-: Constant( STRING, libstdhl::Type::createString( value ), classid() )
+: StringConstant( std::make_shared< const StringLayout::Node >( std::string( value ) ) )
 {
 }
 
@@ -1038,16 +1246,45 @@ StringConstant::StringConstant( void )
 {
 }
 
-const libstdhl::Type::String& StringConstant::value( void ) const
+StringConstant::StringConstant( const std::shared_ptr< const StringLayout::Node >& node )
+: Constant( STRING, libstdhl::Type::Data( new StringLayout( node ) ), classid() )
+{
+}
+
+std::string StringConstant::value( void ) const
+{
+    assert( defined() );
+    return layout()->toString();
+}
+
+std::size_t StringConstant::length( void ) const
 {
-    return static_cast< const libstdhl::Type::String& >( m_data );
+    return defined() ? layout()->length() : 0;
+}
+
+StringConstant StringConstant::concat( const StringConstant& rhs ) const
+{
+    assert( defined() and rhs.defined() );
+    return StringConstant( StringLayout::Node::join( layout()->node(), rhs.layout()->node() ) );
+}
+
+void StringConstant::append( std::string& result ) const
+{
+    if( defined() )
+    {
+        layout()->node()->flatten( result );
+    }
+    else
+    {
+        result.append( undef_str );
+    }
 }
 
 std::string StringConstant::toString( void ) const
 {
     if( defined() )
     {
-        return value().toString();
+        return value();
     }
     else
     {
@@ -1063,7 +1300,7 @@ void StringConstant::accept( Visitor& visitor )
 std::size_t StringConstant::hash( void ) const
 {
     const auto h = ( ( (std::size_t)classid() ) << 1 ) | defined();
-    return libstdhl::Hash::combine( h, libstdhl::Hash::value( value() ) );
+    return defined() ? libstdhl::Hash::combine( h, layout()->hash() ) : h;
 }
 
 u1 StringConstant::operator==( const Value& rhs ) const
@@ -1079,7 +1316,12 @@ u1 StringConstant::operator==( const Value& rhs ) const
     }
 
     const auto& other = static_cast< const StringConstant& >( rhs );
-    return ( this->defined() == other.defined() ) and ( this->value() == other.value() );
+    if( not this->defined() or not other.defined() )
+    {
+        return this->defined() == other.defined();
+    }
+
+    return *this->layout() == *other.layout();
 }
 
 u1 StringConstant::classof( Value const* obj )
@@ -1087,6 +1329,11 @@ u1 StringConstant::classof( Value const* obj )
     return obj->id() == classid();
 }
 
+const StringConstant::StringLayout* StringConstant::layout( void ) const
+{
+    return static_cast< StringLayout* >( m_data.ptr() );
+}
+
 //
 // Decimal Constant
 //
@@ -1245,6 +1492,12 @@ EnumerationConstant::EnumerationConstant( const Enumeration::Ptr& kind, const st
 {
 }
 
+EnumerationConstant::EnumerationConstant( const EnumerationType::Ptr& type, const u64 index )
+: Constant( type, libstdhl::Type::createNatural( index ), classid() )
+{
+    assert( index < type->kind().elements().size() );
+}
+
 EnumerationConstant::EnumerationConstant( const EnumerationType::Ptr& type )
 : Constant( type, classid() )
 {
@@ -1597,7 +1850,7 @@ Constant ListConstant::choose( void ) const
     std::size_t index = -1;
     while( true )
     {
-        index = libstdhl::Random::uniform< std::size_t >( 0, value()->elements().size() - 1 );
+        index = RandomStream::draw( ( u64 )( value()->elements().size() ) );
 
         const auto element = value()->elements()[ index ];
 
@@ -1862,7 +2115,9 @@ SymbolicConstant::SymbolicConstant(
     const Type::Ptr& type, const std::string& name, SymbolicExecutionEnvironment& environment )
 : Constant( type, libstdhl::Type::Data( new SymbolicLayout( name, environment ) ), classid() )
 {
-    environment.addSymbolDefinition( definition() );
+    // the definition belongs to the environment explored by this thread,
+    // which is a fork of the referred root environment during a path merge
+    SymbolicExecutionEnvironment::active( environment ).addSymbolDefinition( definition() );
 }
 
 SymbolicConstant::SymbolicConstant( const Type::Ptr& type )
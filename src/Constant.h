@@ -348,6 +348,36 @@ namespace libcasm_ir
       public:
         using Ptr = std::shared_ptr< StringConstant >;
 
+      private:
+        /**
+           immutable rope, a concatenation shares the nodes of both operands
+           and is rebalanced by height, short pieces are merged into flat
+           leaves; every node caches its length and a polynomial hash of its
+           content which composes in constant time on concatenation
+        */
+        class StringLayout final : public libstdhl::Type::Layout
+        {
+          public:
+            struct Node;
+
+            StringLayout( const std::shared_ptr< const Node >& node );
+
+            const std::shared_ptr< const Node >& node( void ) const;
+
+            std::size_t length( void ) const;
+
+            std::string toString( void ) const;
+
+            u1 operator==( const StringLayout& rhs ) const;
+
+            std::size_t hash( void ) const override;
+
+            Layout* clone( void ) const override;
+
+          private:
+            const std::shared_ptr< const Node > m_node;
+        };
+
       public:
         StringConstant( const libstdhl::Type::String& value );
 
@@ -355,7 +385,24 @@ namespace libcasm_ir
 
         StringConstant( void );
 
-        const libstdhl::Type::String& value( void ) const;
+        /**
+           @return flattened content of the string
+        */
+        std::string value( void ) const;
+
+        std::size_t length( void ) const;
+
+        /**
+           @return concatenation of this and 'rhs' (both defined) which shares
+           the storage of both strings
+        */
+        StringConstant concat( const StringConstant& rhs ) const;
+
+        /**
+           appends the content of the string leaf by leaf to 'result'
+           without flattening the rope first
+        */
+        void append( std::string& result ) const;
 
         std::string toString( void ) const;
 
@@ -371,6 +418,11 @@ namespace libcasm_ir
         }
 
         static u1 classof( Value const* obj );
+
+      private:
+        StringConstant( const std::shared_ptr< const StringLayout::Node >& node );
+
+        const StringLayout* layout( void ) const;
     };
 
     class DecimalConstant final : public Constant
@@ -449,6 +501,12 @@ namespace libcasm_ir
 
         EnumerationConstant( const Enumeration::Ptr& kind, const std::string& value );
 
+        /**
+           creates the constant of the element at the given index of the
+           enumeration without encoding the element name
+         */
+        EnumerationConstant( const EnumerationType::Ptr& type, const u64 index );
+
         EnumerationConstant( const EnumerationType::Ptr& type );
 
         EnumerationConstant( const Enumeration::Ptr& kind );
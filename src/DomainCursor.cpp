@@ -0,0 +1,319 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "DomainCursor.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+using namespace libcasm_ir;
+
+DomainCursor::DomainCursor( const Type::Ptr& type, const std::size_t chunkSize )
+: m_type( type )
+, m_mode( Mode::COLLECTION )
+, m_chunk( chunkSize )
+, m_size( 0 )
+, m_first( 0 )
+, m_count( 0 )
+, m_position( 0 )
+, m_remaining( 0 )
+, m_from()
+, m_to()
+, m_integer()
+, m_values( nullptr )
+{
+    assert( type );
+    assert( chunkSize > 0 );
+
+    if( type->isEnumeration() )
+    {
+        m_mode = Mode::ENUMERATION;
+        m_count = static_cast< const EnumerationType& >( *type ).kind().elements().size();
+    }
+    else if( type->isRange() and static_cast< const RangeType& >( *type ).type().isInteger() )
+    {
+        initialize( static_cast< const RangeType& >( *type ) );
+    }
+    else if( type->isInteger() and static_cast< const IntegerType& >( *type ).constrained() )
+    {
+        initialize( *static_cast< const IntegerType& >( *type ).range() );
+    }
+    else
+    {
+        auto values = std::make_shared< std::vector< Constant > >();
+        type->foreach(
+            [&values]( const Constant& constant ) { values->emplace_back( constant ); } );
+        m_count = values->size();
+        m_values = values;
+    }
+
+    reset();
+}
+
+DomainCursor::DomainCursor( const DomainConstant& domain, const std::size_t chunkSize )
+: DomainCursor( domain.type().ptr_type(), chunkSize )
+{
+}
+
+u1 DomainCursor::next( void )
+{
+    const auto capacity = m_chunk.size();
+    m_size = 0;
+
+    switch( m_mode )
+    {
+        case Mode::NATIVE:
+        {
+            while( m_size < capacity and m_remaining > 0 )
+            {
+                m_chunk[ m_size++ ] = IntegerConstant( m_position );
+
+                // the position is not advanced past the last element to not
+                // overflow at the upper limit
+                if( --m_remaining > 0 )
+                {
+                    m_position++;
+                }
+            }
+            break;
+        }
+        case Mode::INTEGER:
+        {
+            while( m_size < capacity and m_remaining > 0 )
+            {
+                m_chunk[ m_size++ ] = m_integer;
+
+                if( m_integer.value() == m_to.value() )
+                {
+                    m_remaining = 0;
+                }
+                else
+                {
+                    auto integer = m_integer.value();
+                    ++integer;
+                    m_integer = IntegerConstant( integer );
+                }
+            }
+            break;
+        }
+        case Mode::ENUMERATION:
+        {
+            const auto type = std::static_pointer_cast< EnumerationType >( m_type );
+
+            while( m_size < capacity and m_remaining > 0 )
+            {
+                m_chunk[ m_size++ ] = EnumerationConstant( type, ( u64 )( m_position++ ) );
+                m_remaining--;
+            }
+            break;
+        }
+        case Mode::COLLECTION:
+        {
+            while( m_size < capacity and m_remaining > 0 )
+            {
+                m_chunk[ m_size++ ] = ( *m_values )[ m_position++ ];
+                m_remaining--;
+            }
+            break;
+        }
+    }
+
+    return m_size > 0;
+}
+
+void DomainCursor::reset( void )
+{
+    m_size = 0;
+
+    switch( m_mode )
+    {
+        case Mode::NATIVE:
+        {
+            m_position = m_first;
+            m_remaining = m_count;
+            break;
+        }
+        case Mode::INTEGER:
+        {
+            m_integer = m_from;
+            m_remaining = ( m_from.value() <= m_to.value() ) ? 1 : 0;
+            break;
+        }
+        case Mode::ENUMERATION:  // [fallthrough]
+        case Mode::COLLECTION:
+        {
+            // the first element is an index for these domains
+            m_position = m_first;
+            m_remaining = m_count;
+            break;
+        }
+    }
+}
+
+const Type& DomainCursor::type( void ) const
+{
+    return *m_type;
+}
+
+u1 DomainCursor::countable( void ) const
+{
+    return m_mode != Mode::INTEGER;
+}
+
+u64 DomainCursor::count( void ) const
+{
+    assert( countable() );
+    return m_count;
+}
+
+std::vector< DomainCursor > DomainCursor::split( const std::size_t parts ) const
+{
+    std::vector< DomainCursor > cursors;
+
+    if( not countable() or m_count == 0 or parts <= 1 )
+    {
+        cursors.emplace_back( *this );
+        cursors.back().reset();
+        return cursors;
+    }
+
+    const u64 size = std::min< u64 >( parts, m_count );
+    const u64 quotient = m_count / size;
+    const u64 remainder = m_count % size;
+
+    cursors.reserve( size );
+
+    u64 offset = 0;
+    for( u64 part = 0; part < size; part++ )
+    {
+        const u64 count = quotient + ( part < remainder ? 1 : 0 );
+
+        cursors.emplace_back( *this );
+        auto& cursor = cursors.back();
+        cursor.m_first = ( i64 )( ( u64 )( m_first ) + offset );
+        cursor.m_count = count;
+        cursor.reset();
+
+        offset += count;
+    }
+
+    return cursors;
+}
+
+std::size_t DomainCursor::size( void ) const
+{
+    return m_size;
+}
+
+const Constant& DomainCursor::operator[]( const std::size_t index ) const
+{
+    assert( index < m_size );
+    return m_chunk[ index ];
+}
+
+const Constant* DomainCursor::begin( void ) const
+{
+    return m_chunk.data();
+}
+
+const Constant* DomainCursor::end( void ) const
+{
+    return m_chunk.data() + m_size;
+}
+
+u1 DomainCursor::native( const Value& value, i64& result )
+{
+    if( not isa< IntegerConstant >( value ) )
+    {
+        return false;
+    }
+
+    const auto& constant = static_cast< const IntegerConstant& >( value );
+    const auto& data = constant.data();
+
+    if( not constant.defined() or not data.trivial() or
+        data.value() > static_cast< u64 >( std::numeric_limits< i64 >::max() ) )
+    {
+        return false;
+    }
+
+    result = constant.value_i64();
+    return true;
+}
+
+void DomainCursor::initialize( const RangeType& range )
+{
+    i64 first = 0;
+    i64 last = 0;
+
+    if( range.ptr_range() and native( *range.range().from(), first ) and
+        native( *range.range().to(), last ) )
+    {
+        m_mode = Mode::NATIVE;
+        m_first = first;
+        m_count = ( first <= last ) ? ( u64 )( last ) - ( u64 )( first ) + 1 : 0;
+        return;
+    }
+
+    m_mode = Mode::INTEGER;
+
+    if( range.ptr_range() )
+    {
+        m_from = static_cast< const IntegerConstant& >( *range.range().from() );
+        m_to = static_cast< const IntegerConstant& >( *range.range().to() );
+    }
+    else
+    {
+        m_from = IntegerConstant( libstdhl::Limits< libstdhl::Type::Integer >::min() );
+        m_to = IntegerConstant( libstdhl::Limits< libstdhl::Type::Integer >::max() );
+    }
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
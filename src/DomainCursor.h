@@ -0,0 +1,172 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#ifndef _LIBCASM_IR_DOMAIN_CURSOR_H_
+#define _LIBCASM_IR_DOMAIN_CURSOR_H_
+
+#include <libcasm-ir/Constant>
+#include <libcasm-ir/Type>
+
+#include <memory>
+#include <vector>
+
+namespace libcasm_ir
+{
+    /**
+       @brief    iterates the domain of a type in chunks of constants
+
+       The constants of a chunk are stored in a buffer which is allocated
+       once and reused for every chunk. Integer ranges whose bounds fit into
+       64 bits are counted natively, enumeration constants are created by
+       their index. All other types fall back to collecting the constants
+       of Type::foreach once.
+
+       A countable domain can be split into cursors over consecutive
+       sub-ranges, e.g. to partition a forall statement across workers.
+
+       @code
+       DomainCursor cursor( type );
+       while( cursor.next() )
+       {
+           for( const auto& constant : cursor )
+           {
+               ...
+           }
+       }
+       @endcode
+    */
+    class DomainCursor
+    {
+      public:
+        static constexpr std::size_t CHUNK_SIZE = 64;
+
+        DomainCursor( const Type::Ptr& type, const std::size_t chunkSize = CHUNK_SIZE );
+
+        DomainCursor( const DomainConstant& domain, const std::size_t chunkSize = CHUNK_SIZE );
+
+        /**
+           fills the buffer with the next chunk of the domain
+
+           @return false if the domain is exhausted and the chunk is empty
+         */
+        u1 next( void );
+
+        /**
+           restarts the iteration at the first element of the domain
+         */
+        void reset( void );
+
+        const Type& type( void ) const;
+
+        /**
+           @return true if the number of elements of the domain is known, only
+           integer ranges exceeding 64 bits are not countable
+         */
+        u1 countable( void ) const;
+
+        /**
+           @return the number of elements of a countable domain
+         */
+        u64 count( void ) const;
+
+        /**
+           splits a countable domain into at most the given number of cursors
+           over consecutive sub-ranges of nearly equal size, which are
+           iterated in order and independent of this cursor, a domain which is
+           not countable results in a single cursor
+         */
+        std::vector< DomainCursor > split( const std::size_t parts ) const;
+
+        std::size_t size( void ) const;
+
+        const Constant& operator[]( const std::size_t index ) const;
+
+        const Constant* begin( void ) const;
+
+        const Constant* end( void ) const;
+
+        /**
+           @return true if the value is an integer constant which fits into
+           64 bits, the native value is stored in the result
+         */
+        static u1 native( const Value& value, i64& result );
+
+      private:
+        enum class Mode
+        {
+            NATIVE,
+            INTEGER,
+            ENUMERATION,
+            COLLECTION
+        };
+
+        void initialize( const RangeType& range );
+
+        Type::Ptr m_type;
+        Mode m_mode;
+
+        std::vector< Constant > m_chunk;
+        std::size_t m_size;
+
+        i64 m_first;
+        u64 m_count;
+        i64 m_position;
+        u64 m_remaining;
+
+        IntegerConstant m_from;
+        IntegerConstant m_to;
+        IntegerConstant m_integer;
+
+        std::shared_ptr< std::vector< Constant > > m_values;
+    };
+}
+
+#endif  // _LIBCASM_IR_DOMAIN_CURSOR_H_
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -47,6 +47,7 @@
 #include <libcasm-ir/Derived>
 #include <libcasm-ir/Exception>
 #include <libcasm-ir/Function>
+#include <libcasm-ir/Profile>
 #include <libcasm-ir/Rule>
 #include <libcasm-ir/Statement>
 
@@ -63,7 +64,222 @@ static const auto VOID = libstdhl::Memory::get< VoidType >();
 static const auto BOOLEAN = libstdhl::Memory::get< BooleanType >();
 static const auto INTEGER = libstdhl::Memory::get< IntegerType >();
 
-SymbolicConstant symbolicInstruction(
+static u1 isConstantValue( const Constant& constant, const Constant& value )
+{
+    return constant.defined() and not constant.symbolic() and constant == value;
+}
+
+static u1 isSameSymbol( const Constant& lhs, const Constant& rhs )
+{
+    return lhs.defined() and rhs.defined() and lhs.symbolic() and rhs.symbolic() and lhs == rhs;
+}
+
+static u1 simplifySymbolicInstruction(
+    const Value& value, const Constant& lhs, const Constant& rhs, Constant& res )
+{
+    // local algebraic identities which collapse a symbolic term to one of
+    // its operands or to a constant, no symbol and no formula is emitted then
+
+    const auto integer = value.type().result().isInteger();
+    const auto zero = IntegerConstant( 0 );
+    const auto one = IntegerConstant( 1 );
+    const auto tru = BooleanConstant( true );
+    const auto fls = BooleanConstant( false );
+
+    switch( value.id() )
+    {
+        case Value::ADD_INSTRUCTION:
+        {
+            if( integer and isConstantValue( rhs, zero ) )
+            {
+                res = lhs;
+                return true;
+            }
+            if( integer and isConstantValue( lhs, zero ) )
+            {
+                res = rhs;
+                return true;
+            }
+            break;
+        }
+        case Value::SUB_INSTRUCTION:
+        {
+            if( integer and isConstantValue( rhs, zero ) )
+            {
+                res = lhs;
+                return true;
+            }
+            if( integer and isSameSymbol( lhs, rhs ) )
+            {
+                res = zero;
+                return true;
+            }
+            break;
+        }
+        case Value::MUL_INSTRUCTION:
+        {
+            if( integer and ( isConstantValue( lhs, zero ) or isConstantValue( rhs, zero ) ) )
+            {
+                res = zero;
+                return true;
+            }
+            if( integer and isConstantValue( rhs, one ) )
+            {
+                res = lhs;
+                return true;
+            }
+            if( integer and isConstantValue( lhs, one ) )
+            {
+                res = rhs;
+                return true;
+            }
+            break;
+        }
+        case Value::DIV_INSTRUCTION:
+        {
+            if( integer and isConstantValue( rhs, one ) )
+            {
+                res = lhs;
+                return true;
+            }
+            break;
+        }
+        case Value::AND_INSTRUCTION:
+        {
+            if( isConstantValue( lhs, fls ) or isConstantValue( rhs, fls ) )
+            {
+                res = fls;
+                return true;
+            }
+            if( isConstantValue( rhs, tru ) or isSameSymbol( lhs, rhs ) )
+            {
+                res = lhs;
+                return true;
+            }
+            if( isConstantValue( lhs, tru ) )
+            {
+                res = rhs;
+                return true;
+            }
+            break;
+        }
+        case Value::OR_INSTRUCTION:
+        {
+            if( isConstantValue( lhs, tru ) or isConstantValue( rhs, tru ) )
+            {
+                res = tru;
+                return true;
+            }
+            if( isConstantValue( rhs, fls ) or isSameSymbol( lhs, rhs ) )
+            {
+                res = lhs;
+                return true;
+            }
+            if( isConstantValue( lhs, fls ) )
+            {
+                res = rhs;
+                return true;
+            }
+            break;
+        }
+        case Value::XOR_INSTRUCTION:
+        {
+            if( isConstantValue( rhs, fls ) )
+            {
+                res = lhs;
+                return true;
+            }
+            if( isConstantValue( lhs, fls ) )
+            {
+                res = rhs;
+                return true;
+            }
+            if( isSameSymbol( lhs, rhs ) )
+            {
+                res = fls;
+                return true;
+            }
+            break;
+        }
+        case Value::IMP_INSTRUCTION:
+        {
+            if( isConstantValue( lhs, fls ) or isConstantValue( rhs, tru ) or
+                isSameSymbol( lhs, rhs ) )
+            {
+                res = tru;
+                return true;
+            }
+            if( isConstantValue( lhs, tru ) )
+            {
+                res = rhs;
+                return true;
+            }
+            break;
+        }
+        case Value::EQU_INSTRUCTION:  // [fallthrough]
+        case Value::LEQ_INSTRUCTION:  // [fallthrough]
+        case Value::GEQ_INSTRUCTION:
+        {
+            if( isSameSymbol( lhs, rhs ) )
+            {
+                res = tru;
+                return true;
+            }
+            break;
+        }
+        case Value::NEQ_INSTRUCTION:  // [fallthrough]
+        case Value::LTH_INSTRUCTION:  // [fallthrough]
+        case Value::GTH_INSTRUCTION:
+        {
+            if( isSameSymbol( lhs, rhs ) )
+            {
+                res = fls;
+                return true;
+            }
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+
+    return false;
+}
+
+static SymbolicExecutionEnvironment::Term symbolicTerm(
+    const Value& value, const Constant& lhs, const Constant& rhs )
+{
+    SymbolicExecutionEnvironment::Term term = { value.id(), value.type().hash(), { lhs, rhs } };
+
+    switch( value.id() )
+    {
+        case Value::ADD_INSTRUCTION:  // [fallthrough]
+        case Value::MUL_INSTRUCTION:  // [fallthrough]
+        case Value::AND_INSTRUCTION:  // [fallthrough]
+        case Value::OR_INSTRUCTION:   // [fallthrough]
+        case Value::XOR_INSTRUCTION:  // [fallthrough]
+        case Value::EQU_INSTRUCTION:  // [fallthrough]
+        case Value::NEQ_INSTRUCTION:
+        {
+            // commutative operations share one term for both operand orders
+            if( rhs.hash() < lhs.hash() )
+            {
+                std::swap( term.operands[ 0 ], term.operands[ 1 ] );
+            }
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+
+    return term;
+}
+
+Constant symbolicInstruction(
+    const Value& value,
     const Constant& lhs,
     const Constant& rhs,
     const std::function< TPTP::Logic::Ptr(
@@ -73,31 +289,53 @@ SymbolicConstant symbolicInstruction(
         const TPTP::Atom::Ptr& ) > callback,
     const libstdhl::Optional< Type::Ptr > resType = {} )
 {
-    auto& env = lhs.symbolic() ? static_cast< const SymbolicConstant& >( lhs ).environment()
-                               : static_cast< const SymbolicConstant& >( rhs ).environment();
-    SymbolicConstant localRes(
-        resType ? *resType : lhs.type().ptr_result(), env.generateSymbolName(), env );
-    if( lhs.defined() and rhs.defined() )
+    auto& env = SymbolicExecutionEnvironment::active(
+        lhs.symbolic() ? static_cast< const SymbolicConstant& >( lhs ).environment()
+                       : static_cast< const SymbolicConstant& >( rhs ).environment() );
+
+    if( not lhs.defined() or not rhs.defined() )
     {
-        auto lhsSym = env.tptpAtomFromConstant( lhs );
-        auto rhsSym = env.tptpAtomFromConstant( rhs );
+        return SymbolicConstant(
+            resType ? *resType : lhs.type().ptr_result(), env.generateSymbolName(), env.root() );
+    }
 
-        auto resSym =
-            std::make_shared< TPTP::ConstantAtom >( localRes.name(), TPTP::Atom::Kind::PLAIN );
+    Constant simplified;
+    if( simplifySymbolicInstruction( value, lhs, rhs, simplified ) )
+    {
+        return simplified;
+    }
 
-        const auto atom = callback( env, lhsSym, rhsSym, resSym );
-        env.addFormula( atom );
+    const auto key = symbolicTerm( value, lhs, rhs );
+    if( const auto term = env.term( key ) )
+    {
+        return *term;
     }
 
+    SymbolicConstant localRes(
+        resType ? *resType : lhs.type().ptr_result(), env.generateSymbolName(), env.root() );
+
+    auto lhsSym = env.tptpAtomFromConstant( lhs );
+    auto rhsSym = env.tptpAtomFromConstant( rhs );
+
+    auto resSym =
+        std::make_shared< TPTP::ConstantAtom >( localRes.name(), TPTP::Atom::Kind::PLAIN );
+
+    const auto atom = callback( env, lhsSym, rhsSym, resSym );
+    env.addFormula( atom );
+    env.addTerm( key, localRes );
+
     return localRes;
 }
 
-SymbolicConstant symbolicArithmeticInstruction(
+Constant symbolicArithmeticInstruction(
     const Constant& lhs, const Constant& rhs, const Value& value )
 {
     assert( ArithmeticInstruction::classof( &value ) );
     return symbolicInstruction(
-        lhs, rhs, [ & ]( auto& env, const auto& lhsSym, const auto& rhsSym, const auto& resSym ) {
+        value,
+        lhs,
+        rhs,
+        [ & ]( auto& env, const auto& lhsSym, const auto& rhsSym, const auto& resSym ) {
             return std::make_shared< TPTP::FunctorAtom >(
                 env.generateOperatorFunction( value ),
                 std::initializer_list< TPTP::Logic::Ptr >{ lhsSym, rhsSym, resSym },
@@ -109,16 +347,39 @@ SymbolicConstant symbolicArithmeticInstruction(
 // Instruction
 //
 
+static inline User* definition( const Value::Ptr& operand )
+{
+    return isa< User >( operand ) ? static_cast< User* >( operand.get() ) : nullptr;
+}
+
 Instruction::Instruction(
     const Type::Ptr& type, const Value::ID id, const std::vector< Value::Ptr >& operands )
 : User( type, id )
 {
+    m_operands.reserve( operands.size() );
+    m_uses.reserve( operands.size() );
+
     for( auto operand : operands )
     {
         add( operand );
     }
 }
 
+Instruction::Instruction( const Instruction& other )
+: User( other )
+, m_operands( other.m_operands )
+, m_uses()
+, m_statement( other.m_statement )
+, m_next( other.m_next )
+{
+    m_uses.reserve( m_operands.size() );
+
+    for( const auto& operand : m_operands )
+    {
+        m_uses.emplace_back( *this, definition( operand ) );
+    }
+}
+
 void Instruction::add( const Value::Ptr& operand )
 {
     if( isa< UnaryInstruction >( this ) and m_operands.size() >= 1 )
@@ -136,13 +397,7 @@ void Instruction::add( const Value::Ptr& operand )
     }
 
     m_operands.emplace_back( operand );
-
-    if( isa< User >( operand ) )
-    {
-        User* user = static_cast< User* >( operand.get() );
-
-        user->setUse( *this );
-    }
+    m_uses.emplace_back( *this, definition( operand ) );
 }
 
 Value::Ptr Instruction::operand( u8 position ) const
@@ -168,31 +423,40 @@ const std::vector< Value::Ptr >& Instruction::operands( void ) const
     return m_operands;
 }
 
-void Instruction::replace( Value& from, const Value::Ptr& to )
+void Instruction::setOperand( u8 position, const Value::Ptr& operand )
 {
-    std::cerr << "replace: " << from.label() << " -> " << to->label() << "\n";
-
-    std::replace_if(
-        m_operands.begin(),
-        m_operands.end(),
-        [ & ]( const Value::Ptr& v ) { return *v.get() == from; },
-        to );
-
-    if( isa< User >( from ) )
+    if( position >= m_operands.size() )
     {
-        std::cerr << "replace-from: remove use of " << this->label() << " -> " << from.label()
-                  << "\n";
-
-        User& user = static_cast< User& >( from );
-        user.removeUse( *this );
+        throw std::domain_error(
+            "instruction operand position '" + std::to_string( position ) + "' does not exist!" );
     }
 
-    if( isa< User >( to ) )
+    if( not operand )
     {
-        std::cerr << "replace-to: set use of " << to->label() << "\n";
+        throw std::domain_error( "instruction operand is a null pointer" );
+    }
+
+    m_uses[ position ].set( definition( operand ) );
+    m_operands[ position ] = operand;
+}
+
+u8 Instruction::position( const Use& use ) const
+{
+    assert( &use.use() == this );
+    assert( &use >= m_uses.data() and &use < m_uses.data() + m_uses.size() );
 
-        auto user = std::static_pointer_cast< User >( to );
-        user->setUse( *this );
+    return &use - m_uses.data();
+}
+
+void Instruction::replace( Value& from, const Value::Ptr& to )
+{
+    // operands are matched by identity, an equal but distinct value is kept
+    for( std::size_t c = 0; c < m_operands.size(); c++ )
+    {
+        if( m_operands[ c ].get() == &from )
+        {
+            setOperand( c, to );
+        }
     }
 }
 
@@ -220,6 +484,11 @@ Instruction::Ptr Instruction::next( void ) const
     return m_next.lock();
 }
 
+void Instruction::resetNext( void )
+{
+    m_next.reset();
+}
+
 std::string Instruction::name( void ) const
 {
     return Value::token( id() );
@@ -512,10 +781,35 @@ void CallInstruction::accept( Visitor& visitor )
     visitor.visit( *this );
 }
 
-void CallInstruction::execute( Constant& res, const Constant* reg, const std::size_t size ) const
+static void call(
+    const CallInstruction& instruction,
+    Constant& res,
+    const Constant* reg,
+    const std::size_t size )
 {
+    const auto& symbol = instruction.callee();
+
+    if( isa< Builtin >( symbol ) )
+    {
+        static_cast< const Builtin& >( *symbol ).invoke( res, reg, size );
+        return;
+    }
+
     // TODO: FIXME: @ppaulweber
-    throw InternalException( "unimplemented '" + description() + "'" );
+    throw InternalException( "unimplemented '" + instruction.description() + "'" );
+}
+
+void CallInstruction::execute( Constant& res, const Constant* reg, const std::size_t size ) const
+{
+    const auto profile = Profile::active();
+    if( profile )
+    {
+        Profile::Sample sample( profile->counter( *this ) );
+        call( *this, res, reg, size );
+        return;
+    }
+
+    call( *this, res, reg, size );
 }
 
 u1 CallInstruction::classof( Value const* obj )
@@ -878,10 +1172,10 @@ void AddInstruction::execute( Constant& res, const Constant& lhs, const Constant
         }
         case Type::Kind::STRING:
         {
-            auto& lval = static_cast< const StringConstant& >( lhs ).value();
-            auto& rval = static_cast< const StringConstant& >( rhs ).value();
+            const auto& lval = static_cast< const StringConstant& >( lhs );
+            const auto& rval = static_cast< const StringConstant& >( rhs );
 
-            res = StringConstant( lval.toString() + rval.toString() );
+            res = lval.concat( rval );
             break;
         }
         default:
@@ -1773,6 +2067,7 @@ void AndInstruction::execute( Constant& res, const Constant& lhs, const Constant
                 if( lhs.defined() and rhs.defined() )
                 {
                     res = symbolicInstruction(
+                        *this,
                         lhs,
                         rhs,
                         [ & ](
@@ -1951,6 +2246,7 @@ void XorInstruction::execute( Constant& res, const Constant& lhs, const Constant
                 if( lhs.defined() and rhs.defined() )
                 {
                     res = symbolicInstruction(
+                        *this,
                         lhs,
                         rhs,
                         [ & ](
@@ -2121,6 +2417,7 @@ void OrInstruction::execute( Constant& res, const Constant& lhs, const Constant&
                 if( lhs.defined() and rhs.defined() )
                 {
                     res = symbolicInstruction(
+                        *this,
                         lhs,
                         rhs,
                         [ & ](
@@ -2294,6 +2591,7 @@ void ImpInstruction::execute( Constant& res, const Constant& lhs, const Constant
         if( lhs.defined() and rhs.defined() )
         {
             res = symbolicInstruction(
+                *this,
                 lhs,
                 rhs,
                 [ & ]( auto& env, const auto& lhsSym, const auto& rhsSym, const auto& resSym ) {
@@ -2605,6 +2903,7 @@ void EquInstruction::execute( Constant& res, const Constant& lhs, const Constant
     if( lhs.symbolic() or rhs.symbolic() )
     {
         res = symbolicInstruction(
+            *this,
             lhs,
             rhs,
             [ & ]( auto& env, const auto& lhsSym, const auto& rhsSym, const auto& resSym ) {
@@ -2772,6 +3071,7 @@ void NeqInstruction::execute( Constant& res, const Constant& lhs, const Constant
     if( lhs.symbolic() or rhs.symbolic() )
     {
         res = symbolicInstruction(
+            *this,
             lhs,
             rhs,
             [ & ]( auto& env, const auto& lhsSym, const auto& rhsSym, const auto& resSym ) {
@@ -2948,6 +3248,7 @@ void LthInstruction::execute( Constant& res, const Constant& lhs, const Constant
             case Type::Kind::RATIONAL:
             {
                 res = symbolicInstruction(
+                    *this,
                     lhs,
                     rhs,
                     [ & ]( auto& env, const auto& lhsSym, const auto& rhsSym, const auto& resSym ) {
@@ -3080,6 +3381,7 @@ void LeqInstruction::execute( Constant& res, const Constant& lhs, const Constant
                 case Type::Kind::RATIONAL:
                 {
                     res = symbolicInstruction(
+                        *this,
                         lhs,
                         rhs,
                         [ & ](
@@ -3223,6 +3525,7 @@ void GthInstruction::execute( Constant& res, const Constant& lhs, const Constant
             case Type::Kind::RATIONAL:
             {
                 res = symbolicInstruction(
+                    *this,
                     lhs,
                     rhs,
                     [ & ]( auto& env, const auto& lhsSym, const auto& rhsSym, const auto& resSym ) {
@@ -3349,6 +3652,7 @@ void GeqInstruction::execute( Constant& res, const Constant& lhs, const Constant
                 case Type::Kind::RATIONAL:
                 {
                     res = symbolicInstruction(
+                        *this,
                         lhs,
                         rhs,
                         [ & ](
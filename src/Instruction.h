@@ -61,12 +61,28 @@ namespace libcasm_ir
             const Value::ID id,
             const std::vector< Value::Ptr >& operands = {} );
 
+        /**
+           a copied instruction has its own operand slots which are linked
+           into the use lists of the shared operands
+         */
+        Instruction( const Instruction& other );
+
         void add( const Value::Ptr& operand );
 
         Value::Ptr operand( u8 position ) const;
 
         const std::vector< Value::Ptr >& operands( void ) const;
 
+        void setOperand( u8 position, const Value::Ptr& operand );
+
+        /**
+           @return operand position of a use slot of this instruction
+         */
+        u8 position( const Use& use ) const;
+
+        /**
+           replaces every operand which is the value `from` itself
+         */
         void replace( Value& from, const Value::Ptr& to );
 
         void setStatement( const std::shared_ptr< Statement >& statement );
@@ -77,6 +93,11 @@ namespace libcasm_ir
 
         Instruction::Ptr next( void ) const;
 
+        /**
+           unlinks the instruction from its successor
+         */
+        void resetNext( void );
+
         std::string name( void ) const override;
 
         std::size_t hash( void ) const override;
@@ -86,6 +107,9 @@ namespace libcasm_ir
       private:
         std::vector< Value::Ptr > m_operands;
 
+        // declared after the operands to unlink before the operands are released
+        std::vector< Use > m_uses;
+
         std::weak_ptr< Statement > m_statement;
 
         std::weak_ptr< Instruction > m_next;
@@ -268,6 +292,11 @@ namespace libcasm_ir
 
         void accept( Visitor& visitor ) override final;
 
+        /**
+           evaluates a builtin callee through 'Builtin::invoke', the register
+           'reg' holds the call arguments without the callee, the call is
+           sampled into the active profile of the executing thread
+        */
         void execute( Constant& res, const Constant* reg, const std::size_t size ) const override;
 
       public:
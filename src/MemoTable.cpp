@@ -0,0 +1,230 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "MemoTable.h"
+
+#include <libcasm-ir/Annotation>
+#include <libcasm-ir/Builtin>
+#include <libcasm-ir/Instruction>
+
+using namespace libcasm_ir;
+
+MemoTable::MemoTable( void )
+: m_results()
+, m_memoizable()
+, m_uncached()
+, m_step( 0 )
+, m_hits( 0 )
+, m_misses( 0 )
+{
+}
+
+const Constant* MemoTable::lookup(
+    const Derived& derived, const Constant* arguments, const std::size_t size ) const
+{
+    const Key key{ &derived, std::vector< Constant >( arguments, arguments + size ) };
+
+    const auto result = m_results.find( key );
+    if( result == m_results.end() )
+    {
+        return nullptr;
+    }
+
+    return &result->second;
+}
+
+const Constant& MemoTable::insert(
+    const Derived& derived,
+    const Constant* arguments,
+    const std::size_t size,
+    const Constant& result )
+{
+    Key key{ &derived, std::vector< Constant >( arguments, arguments + size ) };
+    return m_results.emplace( std::move( key ), result ).first->second;
+}
+
+const Constant& MemoTable::evaluate(
+    const Derived& derived,
+    const Constant* arguments,
+    const std::size_t size,
+    const std::function< Constant( void ) >& compute )
+{
+    auto memoizable = m_memoizable.find( &derived );
+    if( memoizable == m_memoizable.end() )
+    {
+        memoizable = m_memoizable.emplace( &derived, MemoTable::memoizable( derived ) ).first;
+    }
+
+    if( not memoizable->second )
+    {
+        // the result is only valid until the next evaluation
+        m_misses++;
+        m_uncached = compute();
+        return m_uncached;
+    }
+
+    if( const auto result = lookup( derived, arguments, size ) )
+    {
+        m_hits++;
+        return *result;
+    }
+
+    m_misses++;
+    return insert( derived, arguments, size, compute() );
+}
+
+void MemoTable::invalidate( void )
+{
+    m_results.clear();
+    m_step++;
+}
+
+u64 MemoTable::step( void ) const
+{
+    return m_step;
+}
+
+std::size_t MemoTable::size( void ) const
+{
+    return m_results.size();
+}
+
+u64 MemoTable::hits( void ) const
+{
+    return m_hits;
+}
+
+u64 MemoTable::misses( void ) const
+{
+    return m_misses;
+}
+
+u1 MemoTable::memoizable( const Derived& derived )
+{
+    std::unordered_set< const Derived* > visited;
+    return memoizable( derived, visited );
+}
+
+u1 MemoTable::memoizable(
+    const Derived& derived, std::unordered_set< const Derived* >& visited )
+{
+    if( not visited.emplace( &derived ).second )
+    {
+        // recursive calls are decided by the first visit
+        return true;
+    }
+
+    return const_cast< Derived& >( derived ).iterate< Traversal::PREORDER >(
+        [&visited]( Value& value ) -> u1 {
+            if( isa< UpdateInstruction >( value ) or isa< ForkInstruction >( value ) or
+                isa< MergeInstruction >( value ) )
+            {
+                return false;
+            }
+
+            if( not isa< CallInstruction >( value ) )
+            {
+                return true;
+            }
+
+            const auto& callee = static_cast< CallInstruction& >( value ).callee();
+
+            if( isa< Derived >( callee ) )
+            {
+                return memoizable( static_cast< const Derived& >( *callee ), visited );
+            }
+
+            if( isa< Builtin >( callee ) )
+            {
+                try
+                {
+                    const auto& properties = Annotation::find( callee->id() ).properties();
+                    return properties.isSet( Property::SIDE_EFFECT_FREE );
+                }
+                catch( const std::domain_error& )
+                {
+                    return false;
+                }
+            }
+
+            return false;
+        } );
+}
+
+u1 MemoTable::Key::operator==( const Key& rhs ) const
+{
+    if( derived != rhs.derived or arguments.size() != rhs.arguments.size() )
+    {
+        return false;
+    }
+
+    for( std::size_t index = 0; index < arguments.size(); index++ )
+    {
+        if( arguments[ index ] != rhs.arguments[ index ] )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::size_t MemoTable::KeyHash::operator()( const Key& key ) const
+{
+    auto hash = std::hash< const Derived* >()( key.derived );
+
+    for( const auto& argument : key.arguments )
+    {
+        hash = libstdhl::Hash::combine( hash, argument.hash() );
+    }
+
+    return hash;
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
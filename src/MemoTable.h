@@ -0,0 +1,150 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#ifndef _LIBCASM_IR_MEMO_TABLE_H_
+#define _LIBCASM_IR_MEMO_TABLE_H_
+
+#include <libcasm-ir/Constant>
+#include <libcasm-ir/Derived>
+
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace libcasm_ir
+{
+    /**
+       @brief per-step memo table of derived results
+
+       A derived is a pure function of its arguments and the current state,
+       therefore its result can be reused within one step for the same
+       arguments. The table is keyed on the derived and its argument
+       constants and has to be invalidated whenever an update set is
+       applied to the state. Deriveds which call builtins with side effects
+       (e.g. print) are not memoizable.
+    */
+    class MemoTable final
+    {
+      public:
+        MemoTable( void );
+
+        /**
+           @return cached result of 'derived' for 'arguments' or nullptr
+        */
+        const Constant* lookup(
+            const Derived& derived, const Constant* arguments, const std::size_t size ) const;
+
+        const Constant& insert(
+            const Derived& derived,
+            const Constant* arguments,
+            const std::size_t size,
+            const Constant& result );
+
+        /**
+           returns the cached result or computes and caches it by 'compute'
+           if 'derived' is memoizable
+        */
+        const Constant& evaluate(
+            const Derived& derived,
+            const Constant* arguments,
+            const std::size_t size,
+            const std::function< Constant( void ) >& compute );
+
+        /**
+           drops all results, has to be called when an update set is applied
+        */
+        void invalidate( void );
+
+        /**
+           @return number of applied update sets (invalidations)
+        */
+        u64 step( void ) const;
+
+        std::size_t size( void ) const;
+
+        u64 hits( void ) const;
+
+        u64 misses( void ) const;
+
+        /**
+           @return true if 'derived' and all deriveds it calls only use side
+           effect free builtins
+        */
+        static u1 memoizable( const Derived& derived );
+
+      private:
+        struct Key
+        {
+            const Derived* derived;
+            std::vector< Constant > arguments;
+
+            u1 operator==( const Key& rhs ) const;
+        };
+
+        struct KeyHash
+        {
+            std::size_t operator()( const Key& key ) const;
+        };
+
+        static u1 memoizable(
+            const Derived& derived, std::unordered_set< const Derived* >& visited );
+
+        std::unordered_map< Key, Constant, KeyHash > m_results;
+        std::unordered_map< const Derived*, u1 > m_memoizable;
+        Constant m_uncached;
+        u64 m_step;
+        u64 m_hits;
+        u64 m_misses;
+    };
+}
+
+#endif  // _LIBCASM_IR_MEMO_TABLE_H_
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
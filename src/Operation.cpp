@@ -55,6 +55,13 @@ void Operation::execute(
     const Constant* reg,
     const std::size_t size )
 {
+    const auto kernel = Builtin::select( id, *type );
+    if( kernel )
+    {
+        kernel( res, reg, size );
+        return;
+    }
+
     switch( id )
     {
         case Value::VALUE:                        // [[fallthrough]]
@@ -75,6 +82,7 @@ void Operation::execute(
         case Value::STATEMENT:                    // [[fallthrough]]
         case Value::TRIVIAL_STATEMENT:            // [[fallthrough]]
         case Value::BRANCH_STATEMENT:             // [[fallthrough]]
+        case Value::FORALL_STATEMENT:             // [[fallthrough]]
         case Value::CONSTANT:                     // [[fallthrough]]
         case Value::VOID_CONSTANT:                // [[fallthrough]]
         case Value::RULE_REFERENCE_CONSTANT:      // [[fallthrough]]
@@ -0,0 +1,159 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "OutputSink.h"
+
+#include "Constant.h"
+
+using namespace libcasm_ir;
+
+static thread_local OutputSink* s_active = nullptr;
+static thread_local u64 s_order = 0;
+
+OutputSink::OutputSink( std::ostream& stream )
+: m_stream( &stream )
+, m_segments()
+, m_size( 0 )
+, m_mutex()
+{
+}
+
+OutputSink::~OutputSink( void )
+{
+    flush();
+}
+
+std::ostream& OutputSink::stream( void ) const
+{
+    return *m_stream;
+}
+
+void OutputSink::redirect( std::ostream& stream )
+{
+    flush();
+    m_stream = &stream;
+}
+
+void OutputSink::write( const std::string& text, const u64 order )
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+    m_segments[ order ].append( text );
+    m_size += text.size();
+}
+
+void OutputSink::write( const StringConstant& text, const u64 order )
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+    auto& segment = m_segments[ order ];
+    const auto size = segment.size();
+    text.append( segment );
+    m_size += segment.size() - size;
+}
+
+void OutputSink::flush( void )
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+
+    if( m_segments.empty() )
+    {
+        return;
+    }
+
+    for( const auto& segment : m_segments )
+    {
+        m_stream->write( segment.second.data(), segment.second.size() );
+    }
+
+    m_stream->flush();
+    m_segments.clear();
+    m_size = 0;
+}
+
+std::size_t OutputSink::size( void ) const
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+    return m_size;
+}
+
+OutputSink::Scope::Scope( OutputSink& sink, const u64 order )
+: ThreadScope( s_active, &sink )
+, m_order( s_order, order )
+{
+}
+
+OutputSink* OutputSink::active( void )
+{
+    return s_active;
+}
+
+void OutputSink::print( const std::string& text )
+{
+    if( s_active )
+    {
+        s_active->write( text, s_order );
+    }
+    else
+    {
+        std::cout << text;
+    }
+}
+
+void OutputSink::print( const StringConstant& text )
+{
+    if( s_active )
+    {
+        s_active->write( text, s_order );
+    }
+    else
+    {
+        std::cout << text.toString();
+    }
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
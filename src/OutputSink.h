@@ -0,0 +1,143 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#ifndef _LIBCASM_IR_OUTPUT_SINK_H_
+#define _LIBCASM_IR_OUTPUT_SINK_H_
+
+#include <libcasm-ir/CasmIR>
+#include <libcasm-ir/ThreadScope>
+
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace libcasm_ir
+{
+    class StringConstant;
+
+    /**
+       @brief buffered output channel of the print builtins
+
+       Text which is printed during a step is collected in segments and
+       written to the target stream by 'flush' at the end of the step. Each
+       segment is identified by an order key (e.g. the position of the
+       evaluated rule in the update set) and segments are flushed in
+       ascending key order, therefore the output of a parallel evaluation
+       does not depend on the thread interleaving. The target stream can be
+       any std::ostream, e.g. std::cout, a std::ofstream or a
+       std::ostringstream to capture the output in tests.
+
+       The print builtins write to the sink which is activated for the
+       current thread by an OutputSink::Scope, otherwise they write
+       directly to std::cout.
+    */
+    class OutputSink final
+    {
+      public:
+        explicit OutputSink( std::ostream& stream = std::cout );
+
+        ~OutputSink( void );
+
+        OutputSink( const OutputSink& other ) = delete;
+
+        OutputSink& operator=( const OutputSink& other ) = delete;
+
+        std::ostream& stream( void ) const;
+
+        void redirect( std::ostream& stream );
+
+        void write( const std::string& text, const u64 order = 0 );
+
+        /**
+           appends the rope leaves of 'text' directly to the segment
+        */
+        void write( const StringConstant& text, const u64 order = 0 );
+
+        /**
+           writes all pending segments in ascending order key order to the
+           target stream and clears them
+        */
+        void flush( void );
+
+        /**
+           @return number of pending bytes which are not yet flushed
+        */
+        std::size_t size( void ) const;
+
+        class Scope final : public ThreadScope< OutputSink* >
+        {
+          public:
+            explicit Scope( OutputSink& sink, const u64 order = 0 );
+
+          private:
+            ThreadScope< u64 > m_order;
+        };
+
+        static OutputSink* active( void );
+
+        /**
+           writes to the active sink (using the order key of its scope) or
+           directly to std::cout if no sink is active
+        */
+        static void print( const std::string& text );
+
+        static void print( const StringConstant& text );
+
+      private:
+        std::ostream* m_stream;
+        std::map< u64, std::string > m_segments;
+        std::size_t m_size;
+        mutable std::mutex m_mutex;
+    };
+}
+
+#endif  // _LIBCASM_IR_OUTPUT_SINK_H_
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
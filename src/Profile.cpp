@@ -0,0 +1,301 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "Profile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h>
+#endif
+
+using namespace libcasm_ir;
+
+static thread_local Profile* s_active = nullptr;
+
+//
+//
+// Profile::Counter
+//
+
+Profile::Counter::Counter( void )
+: m_executions( 0 )
+, m_cycles( 0 )
+{
+}
+
+u64 Profile::Counter::executions( void ) const
+{
+    return m_executions.load( std::memory_order_relaxed );
+}
+
+u64 Profile::Counter::cycles( void ) const
+{
+    return m_cycles.load( std::memory_order_relaxed );
+}
+
+//
+//
+// Profile::BranchCounter
+//
+
+Profile::BranchCounter::BranchCounter( const std::size_t targets )
+: m_counter()
+, m_taken( targets )
+{
+    for( auto& taken : m_taken )
+    {
+        taken.store( 0, std::memory_order_relaxed );
+    }
+}
+
+const Profile::Counter& Profile::BranchCounter::counter( void ) const
+{
+    return m_counter;
+}
+
+std::size_t Profile::BranchCounter::targets( void ) const
+{
+    return m_taken.size();
+}
+
+u64 Profile::BranchCounter::taken( const std::size_t target ) const
+{
+    assert( target < m_taken.size() );
+    return m_taken[ target ].load( std::memory_order_relaxed );
+}
+
+//
+//
+// Profile::Sample
+//
+
+Profile::Sample::Sample( Counter& counter )
+: m_counter( counter )
+, m_start( timestamp() )
+{
+}
+
+Profile::Sample::~Sample( void )
+{
+    m_counter.record( timestamp() - m_start );
+}
+
+//
+//
+// Profile
+//
+
+Profile::Profile( void )
+: m_counters()
+, m_branches()
+, m_mutex()
+{
+}
+
+Profile::Counter& Profile::counter( const Instruction& instruction )
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+    return m_counters[ &instruction ];
+}
+
+Profile::BranchCounter& Profile::counter( BranchStatement& statement )
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+
+    auto result = m_branches.find( &statement );
+    if( result == m_branches.end() )
+    {
+        result = m_branches
+                     .emplace(
+                         std::piecewise_construct,
+                         std::forward_as_tuple( &statement ),
+                         std::forward_as_tuple( statement.blocks().size() + 1 ) )
+                     .first;
+    }
+
+    return result->second;
+}
+
+const Profile::Counter* Profile::find( const Instruction& instruction ) const
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+
+    const auto result = m_counters.find( &instruction );
+    return result != m_counters.end() ? &result->second : nullptr;
+}
+
+const Profile::BranchCounter* Profile::find( const BranchStatement& statement ) const
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+
+    const auto result = m_branches.find( &statement );
+    return result != m_branches.end() ? &result->second : nullptr;
+}
+
+u64 Profile::maximum( void ) const
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+
+    u64 maximum = 0;
+    for( const auto& counter : m_counters )
+    {
+        maximum = std::max( maximum, counter.second.executions() );
+    }
+    for( const auto& branch : m_branches )
+    {
+        maximum = std::max( maximum, branch.second.counter().executions() );
+    }
+
+    return maximum;
+}
+
+double Profile::heat( const Value& value, const u64 maximum ) const
+{
+    const auto counter = lookup( value );
+    if( not counter or maximum == 0 )
+    {
+        return 0.0;
+    }
+
+    return std::min( 1.0, (double)counter->executions() / (double)maximum );
+}
+
+double Profile::heat( const Value& value ) const
+{
+    return heat( value, maximum() );
+}
+
+std::string Profile::annotation( const Value& value, const u64 maximum ) const
+{
+    const auto counter = lookup( value );
+    if( not counter )
+    {
+        return "";
+    }
+
+    std::ostringstream stream;
+    stream << "heat = " << std::fixed << std::setprecision( 2 ) << heat( value, maximum )
+           << ", executions = " << counter->executions() << ", cycles = " << counter->cycles();
+
+    if( isa< BranchStatement >( value ) )
+    {
+        const auto branch = find( static_cast< const BranchStatement& >( value ) );
+        assert( branch );
+
+        stream << ", taken = {";
+        for( std::size_t target = 0; target < branch->targets(); target++ )
+        {
+            stream << ( target > 0 ? ", " : "" ) << branch->taken( target );
+        }
+        stream << "}";
+    }
+
+    return stream.str();
+}
+
+std::size_t Profile::size( void ) const
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+    return m_counters.size() + m_branches.size();
+}
+
+void Profile::clear( void )
+{
+    std::lock_guard< std::mutex > lock( m_mutex );
+    m_counters.clear();
+    m_branches.clear();
+}
+
+const Profile::Counter* Profile::lookup( const Value& value ) const
+{
+    if( isa< Instruction >( value ) )
+    {
+        return find( static_cast< const Instruction& >( value ) );
+    }
+
+    if( isa< BranchStatement >( value ) )
+    {
+        const auto branch = find( static_cast< const BranchStatement& >( value ) );
+        return branch ? &branch->counter() : nullptr;
+    }
+
+    return nullptr;
+}
+
+//
+//
+// Profile::Scope
+//
+
+Profile::Scope::Scope( Profile& profile )
+: ThreadScope( s_active, &profile )
+{
+}
+
+Profile* Profile::active( void )
+{
+    return s_active;
+}
+
+u64 Profile::timestamp( void )
+{
+#if defined( __x86_64__ ) || defined( __i386__ )
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast< std::chrono::nanoseconds >(
+               std::chrono::steady_clock::now().time_since_epoch() )
+        .count();
+#endif
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
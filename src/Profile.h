@@ -0,0 +1,244 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#ifndef _LIBCASM_IR_PROFILE_H_
+#define _LIBCASM_IR_PROFILE_H_
+
+#include <libcasm-ir/Instruction>
+#include <libcasm-ir/Statement>
+#include <libcasm-ir/ThreadScope>
+
+#include <atomic>
+#include <cassert>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace libcasm_ir
+{
+    /**
+       @brief execution profile of the instructions and branches of a spec
+
+       The counters are kept in a side table and do not change the IR. An
+       executor requests the counter of an instruction or branch statement
+       once (e.g. when it prepares a rule) and updates it afterwards
+       without any lock, the counters stay valid for the lifetime of the
+       profile. A CallInstruction samples itself into the active profile of
+       the executing thread. The cycles are measured with the time stamp
+       counter.
+
+       The table is keyed by the address of the IR value, because the
+       labels of void instructions are not unique. A transformation which
+       replaces an instruction leaves the counter of the old one behind, so
+       a profile only describes the IR it was recorded on and has to be
+       cleared and recorded again after such a pass.
+
+       The heat of a value is its number of executions relative to the most
+       executed instruction or branch. The IRDumpSourcePass and
+       IRDumpDotPass annotate their output with the heat of a given
+       profile, the RuleSpecializationPass ranks its call sites by it.
+    */
+    class Profile final
+    {
+      public:
+        class Counter final
+        {
+          public:
+            Counter( void );
+
+            Counter( const Counter& other ) = delete;
+
+            Counter& operator=( const Counter& other ) = delete;
+
+            inline void record( const u64 cycles = 0 )
+            {
+                m_executions.fetch_add( 1, std::memory_order_relaxed );
+                m_cycles.fetch_add( cycles, std::memory_order_relaxed );
+            }
+
+            u64 executions( void ) const;
+
+            u64 cycles( void ) const;
+
+          private:
+            std::atomic< u64 > m_executions;
+            std::atomic< u64 > m_cycles;
+        };
+
+        /**
+           counter of a branch statement with a histogram of the taken
+           blocks, the last target counts the executions which selected none
+           of the blocks
+        */
+        class BranchCounter final
+        {
+          public:
+            explicit BranchCounter( const std::size_t targets );
+
+            BranchCounter( const BranchCounter& other ) = delete;
+
+            BranchCounter& operator=( const BranchCounter& other ) = delete;
+
+            inline void record( const std::size_t target, const u64 cycles = 0 )
+            {
+                assert( target < m_taken.size() );
+                m_counter.record( cycles );
+                m_taken[ target ].fetch_add( 1, std::memory_order_relaxed );
+            }
+
+            const Counter& counter( void ) const;
+
+            std::size_t targets( void ) const;
+
+            u64 taken( const std::size_t target ) const;
+
+          private:
+            Counter m_counter;
+            std::vector< std::atomic< u64 > > m_taken;
+        };
+
+        /**
+           measures the cycles from its construction to its destruction and
+           records them in the given counter
+        */
+        class Sample final
+        {
+          public:
+            explicit Sample( Counter& counter );
+
+            ~Sample( void );
+
+            Sample( const Sample& other ) = delete;
+
+            Sample& operator=( const Sample& other ) = delete;
+
+          private:
+            Counter& m_counter;
+            u64 m_start;
+        };
+
+        Profile( void );
+
+        Profile( const Profile& other ) = delete;
+
+        Profile& operator=( const Profile& other ) = delete;
+
+        /**
+           @return counter of 'instruction', it is created on first request
+         */
+        Counter& counter( const Instruction& instruction );
+
+        /**
+           @return counter of 'statement' with one target per block and one
+                   for no selected block, it is created on first request
+         */
+        BranchCounter& counter( BranchStatement& statement );
+
+        /**
+           @return counter of 'instruction' or nullptr if it was not recorded
+         */
+        const Counter* find( const Instruction& instruction ) const;
+
+        const BranchCounter* find( const BranchStatement& statement ) const;
+
+        /**
+           @return executions of the most executed instruction or branch
+         */
+        u64 maximum( void ) const;
+
+        /**
+           @return executions of 'value' relative to 'maximum' in [0, 1],
+                   values which were not recorded have no heat
+         */
+        double heat( const Value& value, const u64 maximum ) const;
+
+        double heat( const Value& value ) const;
+
+        /**
+           @return heat, executions, cycles and taken branch histogram of
+                   'value' for the IR dumps or an empty string if 'value'
+                   was not recorded
+         */
+        std::string annotation( const Value& value, const u64 maximum ) const;
+
+        std::size_t size( void ) const;
+
+        void clear( void );
+
+        class Scope final : public ThreadScope< Profile* >
+        {
+          public:
+            explicit Scope( Profile& profile );
+        };
+
+        /**
+           @return profile of the current thread or nullptr if profiling is
+                   disabled
+         */
+        static Profile* active( void );
+
+        /**
+           @return time stamp counter (rdtsc) on x86 targets and a steady
+                   clock in nanoseconds on all others
+         */
+        static u64 timestamp( void );
+
+      private:
+        const Counter* lookup( const Value& value ) const;
+
+        std::unordered_map< const Value*, Counter > m_counters;
+        std::unordered_map< const Value*, BranchCounter > m_branches;
+        mutable std::mutex m_mutex;
+    };
+}
+
+#endif  // _LIBCASM_IR_PROFILE_H_
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -0,0 +1,269 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "RandomStream.h"
+
+#include "Constant.h"
+#include "DomainCursor.h"
+#include "Type.h"
+
+#include <libstdhl/Random>
+
+#include <cassert>
+
+using namespace libcasm_ir;
+
+static thread_local RandomStream* s_active = nullptr;
+
+static constexpr u64 GOLDEN_GAMMA = 0x9e3779b97f4a7c15;
+
+static inline u64 mix( u64 value )
+{
+    value = ( value ^ ( value >> 30 ) ) * 0xbf58476d1ce4e5b9;
+    value = ( value ^ ( value >> 27 ) ) * 0x94d049bb133111eb;
+    return value ^ ( value >> 31 );
+}
+
+static inline u64 bounded( RandomStream& stream, const u64 bound )
+{
+    if( bound == 0 )
+    {
+        return stream.next();
+    }
+
+    // reject the lower values which would bias the modulo mapping
+    const u64 threshold = ( -bound ) % bound;
+    while( true )
+    {
+        const auto value = stream.next();
+        if( value >= threshold )
+        {
+            return value % bound;
+        }
+    }
+}
+
+static inline u1 nativeRange( const Type& type, i64& from, i64& to )
+{
+    const RangeType* range = nullptr;
+
+    if( type.isRange() )
+    {
+        range = &static_cast< const RangeType& >( type );
+    }
+    else if( type.isInteger() and static_cast< const IntegerType& >( type ).constrained() )
+    {
+        range = static_cast< const IntegerType& >( type ).range().get();
+    }
+
+    return range != nullptr and range->type().isInteger() and range->ptr_range() and
+           DomainCursor::native( *range->range().from(), from ) and
+           DomainCursor::native( *range->range().to(), to ) and from <= to;
+}
+
+RandomStream::RandomStream( const u64 seed, const u64 stream )
+: m_seed( seed )
+, m_stream( stream )
+, m_key( mix( seed ^ mix( stream + GOLDEN_GAMMA ) ) )
+, m_counter( 0 )
+{
+}
+
+u64 RandomStream::seed( void ) const
+{
+    return m_seed;
+}
+
+u64 RandomStream::stream( void ) const
+{
+    return m_stream;
+}
+
+u64 RandomStream::counter( void ) const
+{
+    return m_counter;
+}
+
+RandomStream RandomStream::fork( const u64 stream ) const
+{
+    // mix( 0 ) is 0, therefore the child identifier is offset by the gamma
+    // to keep 'fork( 0 )' apart from its parent
+    return RandomStream( m_seed, mix( m_stream + GOLDEN_GAMMA * ( stream + 1 ) ) );
+}
+
+u64 RandomStream::at( const u64 counter ) const
+{
+    return mix( m_key + ( counter + 1 ) * GOLDEN_GAMMA );
+}
+
+u64 RandomStream::next( void )
+{
+    return at( m_counter++ );
+}
+
+u64 RandomStream::uniform( const u64 bound )
+{
+    return bounded( *this, bound );
+}
+
+i64 RandomStream::uniform( const i64 from, const i64 to )
+{
+    assert( from <= to );
+    const auto span = ( u64 )( to ) - ( u64 )( from ) + 1;
+    return ( i64 )( ( u64 )( from ) + bounded( *this, span ) );
+}
+
+double RandomStream::real( void )
+{
+    // upper 53 bits fill the double mantissa
+    return ( next() >> 11 ) * ( 1.0 / ( (u64)1 << 53 ) );
+}
+
+void RandomStream::fill( u64* results, const std::size_t size )
+{
+    const auto counter = m_counter;
+    for( std::size_t index = 0; index < size; index++ )
+    {
+        results[ index ] = at( counter + index );
+    }
+    m_counter += size;
+}
+
+void RandomStream::uniform(
+    const i64 from, const i64 to, i64* results, const std::size_t size )
+{
+    for( std::size_t index = 0; index < size; index++ )
+    {
+        results[ index ] = uniform( from, to );
+    }
+}
+
+void RandomStream::choose( const Type& type, Constant* results, const std::size_t size )
+{
+    i64 from = 0;
+    i64 to = 0;
+
+    if( nativeRange( type, from, to ) )
+    {
+        for( std::size_t index = 0; index < size; index++ )
+        {
+            results[ index ] = IntegerConstant( uniform( from, to ) );
+        }
+    }
+    else if( type.isEnumeration() )
+    {
+        const auto enumeration =
+            std::static_pointer_cast< EnumerationType >( ( (Type&)type ).ptr_type() );
+        const auto elements = enumeration->kind().elements().size();
+
+        for( std::size_t index = 0; index < size; index++ )
+        {
+            results[ index ] = EnumerationConstant( enumeration, uniform( ( u64 )( elements ) ) );
+        }
+    }
+    else if( type.isBoolean() )
+    {
+        for( std::size_t index = 0; index < size; index++ )
+        {
+            results[ index ] = BooleanConstant( ( u1 )( next() >> 63 ) );
+        }
+    }
+    else
+    {
+        Scope scope( *this );
+
+        for( std::size_t index = 0; index < size; index++ )
+        {
+            results[ index ] = type.choose();
+        }
+    }
+}
+
+RandomStream* RandomStream::active( void )
+{
+    return s_active;
+}
+
+RandomStream::Scope::Scope( RandomStream& stream )
+: ThreadScope( s_active, &stream )
+{
+}
+
+u64 RandomStream::draw( void )
+{
+    if( s_active )
+    {
+        return s_active->next();
+    }
+
+    return libstdhl::Random::uniform< u64 >();
+}
+
+u64 RandomStream::draw( const u64 bound )
+{
+    if( s_active )
+    {
+        return s_active->uniform( bound );
+    }
+
+    return bound == 0 ? libstdhl::Random::uniform< u64 >()
+                      : libstdhl::Random::uniform< u64 >( 0, bound - 1 );
+}
+
+i64 RandomStream::draw( const i64 from, const i64 to )
+{
+    if( s_active )
+    {
+        return s_active->uniform( from, to );
+    }
+
+    return libstdhl::Random::uniform< i64 >( from, to );
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -0,0 +1,154 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#ifndef _LIBCASM_IR_RANDOM_STREAM_H_
+#define _LIBCASM_IR_RANDOM_STREAM_H_
+
+#include <libcasm-ir/CasmIR>
+#include <libcasm-ir/ThreadScope>
+
+namespace libcasm_ir
+{
+    class Type;
+    class Constant;
+
+    /**
+       @brief seeded counter-based random number stream
+
+       The n-th number of a stream is a pure function of its seed, its stream
+       identifier and the counter n (SplitMix64 finalizer), therefore a
+       sequence can be reproduced by seed and numbers can be generated in
+       batches or in parallel without any shared state. Independent streams
+       for partitions or elements are derived by 'fork', which makes the
+       drawn values independent of the number of threads used.
+
+       The 'choose' operations of the types draw from the stream which is
+       activated for the current thread by a RandomStream::Scope, otherwise
+       they fall back to the global non-reproducible libstdhl generator.
+    */
+    class RandomStream final
+    {
+      public:
+        explicit RandomStream( const u64 seed, const u64 stream = 0 );
+
+        u64 seed( void ) const;
+
+        u64 stream( void ) const;
+
+        /**
+           @return number of values already drawn from this stream
+        */
+        u64 counter( void ) const;
+
+        /**
+           @return independent stream derived from this stream's seed
+        */
+        RandomStream fork( const u64 stream ) const;
+
+        /**
+           @return value of this stream at 'counter', does not advance
+        */
+        u64 at( const u64 counter ) const;
+
+        u64 next( void );
+
+        /**
+           @return uniform value in [0, bound), full 64-bit range if bound is 0
+        */
+        u64 uniform( const u64 bound );
+
+        /**
+           @return uniform value in [from, to]
+        */
+        i64 uniform( const i64 from, const i64 to );
+
+        /**
+           @return uniform value in [0, 1)
+        */
+        double real( void );
+
+        void fill( u64* results, const std::size_t size );
+
+        void uniform( const i64 from, const i64 to, i64* results, const std::size_t size );
+
+        /**
+           chooses 'size' constants of type 'type' into 'results', ranged
+           integers, enumerations and booleans are drawn in a tight loop,
+           all other types are chosen through 'Type::choose'
+        */
+        void choose( const Type& type, Constant* results, const std::size_t size );
+
+        class Scope final : public ThreadScope< RandomStream* >
+        {
+          public:
+            explicit Scope( RandomStream& stream );
+        };
+
+        static RandomStream* active( void );
+
+        /**
+           draws from the active stream or from the global generator
+        */
+        static u64 draw( void );
+
+        static u64 draw( const u64 bound );
+
+        static i64 draw( const i64 from, const i64 to );
+
+      private:
+        u64 m_seed;
+        u64 m_stream;
+        u64 m_key;
+        u64 m_counter;
+    };
+}
+
+#endif  // _LIBCASM_IR_RANDOM_STREAM_H_
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -50,6 +50,10 @@ Rule::Rule( const std::string& name, const Type::Ptr& type )
 : User( type, classid() )
 , m_name( name )
 , m_context( 0 )
+, m_contextLoader()
+, m_contextPending( false )
+, m_contextMutex()
+, m_parameters()
 {
 }
 
@@ -70,14 +74,92 @@ void Rule::setContext( const ParallelBlock::Ptr& context )
 
     context->setRule( self );
 
+    // recursive, because the loader sets the context while holding the lock
+    std::lock_guard< std::recursive_mutex > lock( m_contextMutex );
+
     m_context = context;
+    if( m_contextLoader )
+    {
+        m_contextLoader = nullptr;
+        m_contextPending.store( false, std::memory_order_release );
+    }
 }
 
 ParallelBlock::Ptr Rule::context( void ) const
 {
+    if( m_contextPending.load( std::memory_order_acquire ) )
+    {
+        std::lock_guard< std::recursive_mutex > lock( m_contextMutex );
+
+        if( m_contextLoader )
+        {
+            const auto loader = m_contextLoader;
+            m_contextLoader = nullptr;
+
+            try
+            {
+                loader( const_cast< Rule& >( *this ) );
+            }
+            catch( ... )
+            {
+                // the rule stays a stub and a later access retries the loader
+                m_contextLoader = loader;
+                throw;
+            }
+
+            // the context is published only after the loader has completed
+            m_contextPending.store( false, std::memory_order_release );
+        }
+    }
+
     return m_context;
 }
 
+void Rule::setContextLoader( const std::function< void( Rule& ) >& loader )
+{
+    std::lock_guard< std::recursive_mutex > lock( m_contextMutex );
+
+    m_contextLoader = loader;
+    m_contextPending.store( static_cast< u1 >( loader ), std::memory_order_release );
+}
+
+u1 Rule::materialized( void ) const
+{
+    if( not m_contextPending.load( std::memory_order_acquire ) )
+    {
+        return true;
+    }
+
+    std::lock_guard< std::recursive_mutex > lock( m_contextMutex );
+    return not m_contextLoader;
+}
+
+void Rule::addParameter( const Identifier::Ptr& parameter )
+{
+    if( not parameter )
+    {
+        throw std::domain_error( "adding a null pointer parameter is not allowed" );
+    }
+
+    if( isa< RelationType >( type() ) )
+    {
+        const auto& relation = static_cast< const RelationType& >( type() );
+        if( m_parameters.size() >= relation.arguments().size() )
+        {
+            throw std::domain_error(
+                "rule '" + name() + "' has only " + std::to_string( relation.arguments().size() ) +
+                " arguments" );
+        }
+    }
+
+    m_parameters.emplace_back( parameter );
+}
+
+const std::vector< Identifier::Ptr >& Rule::parameters( void ) const
+{
+    return m_parameters;
+}
+
 std::string Rule::name( void ) const
 {
     return m_name;
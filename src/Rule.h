@@ -44,9 +44,15 @@
 
 #include <libcasm-ir/User>
 
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
 namespace libcasm_ir
 {
     class ParallelBlock;
+    class Identifier;
 
     class Rule final : public User
     {
@@ -59,8 +65,31 @@ namespace libcasm_ir
 
         void setContext( const std::shared_ptr< ParallelBlock >& context );
 
+        /**
+           @return context of this rule, a pending context loader is invoked
+                   on the first access, concurrent accesses wait until the
+                   loader has completed, a failing loader is kept pending
+                   and its exception is propagated
+         */
         std::shared_ptr< ParallelBlock > context( void ) const;
 
+        /**
+           installs a loader which is invoked once on the first access of the
+           context and is expected to set the context of the rule, an
+           explicitly set context discards a pending loader
+         */
+        void setContextLoader( const std::function< void( Rule& ) >& loader );
+
+        u1 materialized( void ) const;
+
+        /**
+           appends a parameter, the arguments of a call of this rule are
+           bound to the parameters in their order
+         */
+        void addParameter( const std::shared_ptr< Identifier >& parameter );
+
+        const std::vector< std::shared_ptr< Identifier > >& parameters( void ) const;
+
         std::string name( void ) const override;
 
         std::size_t hash( void ) const override;
@@ -80,6 +109,11 @@ namespace libcasm_ir
         std::string m_name;
 
         std::shared_ptr< ParallelBlock > m_context;
+        mutable std::function< void( Rule& ) > m_contextLoader;
+        mutable std::atomic< u1 > m_contextPending;
+        mutable std::recursive_mutex m_contextMutex;
+
+        std::vector< std::shared_ptr< Identifier > > m_parameters;
     };
 
     using Rules = ValueList< Rule >;
@@ -41,13 +41,46 @@
 
 #include "Specification.h"
 
+#include <type_traits>
+#include <vector>
+
 using namespace libcasm_ir;
 
 static const auto VOID = libstdhl::Memory::get< VoidType >();
 
+template < typename T >
+static void filter( ValueList< T >& list, const std::function< u1( const Value& ) >& predicate )
+{
+    using Element = typename std::decay< decltype( *list.begin() ) >::type;
+
+    std::vector< Element > values;
+    values.reserve( list.size() );
+
+    for( const auto& value : list )
+    {
+        if( not predicate( *value ) )
+        {
+            values.emplace_back( value );
+        }
+    }
+
+    if( values.size() == list.size() )
+    {
+        return;
+    }
+
+    list = ValueList< T >();
+
+    for( const auto& value : values )
+    {
+        list.add( value );
+    }
+}
+
 Specification::Specification( const std::string& name )
 : Value( VOID, classid() )
 , m_name( name )
+, m_arena( nullptr )
 {
 }
 
@@ -116,6 +149,25 @@ Rules& Specification::rules( void )
     return m_rules;
 }
 
+void Specification::remove( const std::function< u1( const Value& ) >& predicate )
+{
+    filter( m_constants, predicate );
+    filter( m_builtins, predicate );
+    filter( m_functions, predicate );
+    filter( m_deriveds, predicate );
+    filter( m_rules, predicate );
+}
+
+void Specification::setArena( const Arena::Ptr& arena )
+{
+    m_arena = arena;
+}
+
+const Arena::Ptr& Specification::arena( void ) const
+{
+    return m_arena;
+}
+
 std::string Specification::name( void ) const
 {
     return m_name;
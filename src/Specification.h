@@ -45,6 +45,7 @@
 #include <libcasm-ir/Value>
 
 #include <libcasm-ir/Agent>
+#include <libcasm-ir/Arena>
 #include <libcasm-ir/Builtin>
 #include <libcasm-ir/Constant>
 #include <libcasm-ir/Derived>
@@ -53,6 +54,8 @@
 #include <libcasm-ir/Rule>
 #include <libcasm-ir/Statement>
 
+#include <functional>
+
 namespace libcasm_ir
 {
     class Specification final : public Value
@@ -81,10 +84,27 @@ namespace libcasm_ir
         Deriveds& deriveds( void );
         Rules& rules( void );
 
+        /**
+           removes all constants, builtins, functions, deriveds and rules for
+           which the predicate holds and keeps the order of the remaining ones
+         */
+        void remove( const std::function< u1( const Value& ) >& predicate );
+
+        /**
+           enables the arena mode, the nodes created by 'add' and 'set' and
+           all nodes created while an Arena::Scope of the arena is active are
+           placed into the arena, bodies which are built afterwards are only
+           placed into it if the builder (or pass) activates the arena, the
+           arena is released after the last of its nodes is gone
+        */
+        void setArena( const Arena::Ptr& arena );
+        const Arena::Ptr& arena( void ) const;
+
         template < typename T, typename... Args >
         typename T::Ptr set( Args&&... args )
         {
-            auto obj = libstdhl::Memory::make< T >( std::forward< Args >( args )... );
+            const Arena::Scope scope( m_arena ? m_arena : Arena::active() );
+            auto obj = Arena::make< T >( std::forward< Args >( args )... );
             setAgent( obj );
             return obj;
         }
@@ -92,7 +112,8 @@ namespace libcasm_ir
         template < typename T, typename... Args >
         typename T::Ptr add( Args&&... args )
         {
-            auto obj = libstdhl::Memory::make< T >( std::forward< Args >( args )... );
+            const Arena::Scope scope( m_arena ? m_arena : Arena::active() );
+            auto obj = Arena::make< T >( std::forward< Args >( args )... );
             add( obj );
             return obj;
         }
@@ -123,6 +144,8 @@ namespace libcasm_ir
         Functions m_functions;
         Deriveds m_deriveds;
         Rules m_rules;
+
+        Arena::Ptr m_arena;
     };
 }
 
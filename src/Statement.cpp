@@ -95,6 +95,44 @@ Instructions& Statement::instructions( void )
     return m_instructions;
 }
 
+void Statement::remove( const std::function< u1( const Instruction& ) >& predicate )
+{
+    std::vector< Instruction::Ptr > instructions;
+    instructions.reserve( m_instructions.size() );
+
+    for( const auto& instruction : m_instructions )
+    {
+        if( predicate( *instruction ) )
+        {
+            instruction->setStatement( nullptr );
+            instruction->resetNext();
+        }
+        else
+        {
+            instructions.emplace_back( instruction );
+        }
+    }
+
+    if( instructions.size() == m_instructions.size() )
+    {
+        return;
+    }
+
+    m_instructions = Instructions();
+
+    for( const auto& instruction : instructions )
+    {
+        instruction->resetNext();
+
+        if( m_instructions.size() > 0 )
+        {
+            m_instructions.back()->setNext( instruction );
+        }
+
+        m_instructions.add( instruction );
+    }
+}
+
 ExecutionSemanticsBlock::Ptr Statement::add( const ExecutionSemanticsBlock::Ptr& block )
 {
     assert( block );
@@ -144,6 +182,10 @@ std::string Statement::name( void ) const
     {
         return "branch";
     }
+    else if( isa< ForallStatement >( this ) )
+    {
+        return "forall";
+    }
 
     assert( !" invalid statement to dispatch 'name' found! " );
     return "";
@@ -152,7 +194,7 @@ std::string Statement::name( void ) const
 u1 Statement::classof( Value const* obj )
 {
     return obj->id() == classid() or TrivialStatement::classof( obj ) or
-           BranchStatement::classof( obj );
+           BranchStatement::classof( obj ) or ForallStatement::classof( obj );
 }
 
 TrivialStatement::TrivialStatement( void )
@@ -185,6 +227,64 @@ u1 BranchStatement::classof( Value const* obj )
     return obj->id() == classid();
 }
 
+static inline User* definition( const Value::Ptr& domain )
+{
+    return isa< User >( domain ) ? static_cast< User* >( domain.get() ) : nullptr;
+}
+
+ForallStatement::ForallStatement( void )
+: Statement( classid() )
+, m_variable( nullptr )
+, m_domain( nullptr )
+, m_domainUse( *this )
+{
+}
+
+ForallStatement::ForallStatement(
+    const std::shared_ptr< Identifier >& variable, const Value::Ptr& domain )
+: Statement( classid() )
+, m_variable( variable )
+, m_domain( domain )
+, m_domainUse( *this, definition( domain ) )
+{
+}
+
+void ForallStatement::setVariable( const std::shared_ptr< Identifier >& variable )
+{
+    m_variable = variable;
+}
+
+const std::shared_ptr< Identifier >& ForallStatement::variable( void ) const
+{
+    return m_variable;
+}
+
+void ForallStatement::setDomain( const Value::Ptr& domain )
+{
+    m_domainUse.set( definition( domain ) );
+    m_domain = domain;
+}
+
+const Value::Ptr& ForallStatement::domain( void ) const
+{
+    return m_domain;
+}
+
+ExecutionSemanticsBlock::Ptr ForallStatement::body( void )
+{
+    return blocks().size() > 0 ? *blocks().begin() : nullptr;
+}
+
+void ForallStatement::accept( Visitor& visitor )
+{
+    visitor.visit( *this );
+}
+
+u1 ForallStatement::classof( Value const* obj )
+{
+    return obj->id() == classid();
+}
+
 //
 //  Local variables:
 //  mode: c++
@@ -46,8 +46,12 @@
 
 #include <libcasm-ir/Instruction>
 
+#include <functional>
+
 namespace libcasm_ir
 {
+    class Identifier;
+
     class Statement : public Block
     {
       public:
@@ -59,6 +63,12 @@ namespace libcasm_ir
 
         Instructions& instructions( void );
 
+        /**
+           removes all instructions for which the predicate holds and
+           relinks the remaining instructions in their order
+         */
+        void remove( const std::function< u1( const Instruction& ) >& predicate );
+
         ExecutionSemanticsBlock::Ptr add( const ExecutionSemanticsBlock::Ptr& block );
 
         ExecutionSemanticsBlocks& blocks( void );
@@ -66,7 +76,7 @@ namespace libcasm_ir
         template < typename T, typename... Args >
         typename T::Ptr add( Args&&... args )
         {
-            auto obj = libstdhl::Memory::make< T >( std::forward< Args >( args )... );
+            auto obj = Arena::make< T >( std::forward< Args >( args )... );
             add( obj );
             return obj;
         }
@@ -121,7 +131,58 @@ namespace libcasm_ir
         static u1 classof( Value const* obj );
     };
 
-    // TODO: FIXME: PPA: add ForallStatement and IterateStatement etc.
+    /**
+       @brief    executes its body in parallel for each element of a domain
+
+       The domain is either a constant (range or domain constant) or an
+       instruction of this statement which computes the domain. The body
+       block refers to the current element through the variable identifier.
+       Because all iterations are independent, an executor can partition the
+       domain (see DomainCursor::split) and evaluate each partition into its
+       own update set before merging them.
+    */
+    class ForallStatement final : public Statement
+    {
+      public:
+        using Ptr = std::shared_ptr< ForallStatement >;
+
+        ForallStatement( void );
+
+        ForallStatement( const std::shared_ptr< Identifier >& variable, const Value::Ptr& domain );
+
+        void setVariable( const std::shared_ptr< Identifier >& variable );
+
+        const std::shared_ptr< Identifier >& variable( void ) const;
+
+        /**
+           the domain is a use of its definition, replacing all uses of a
+           domain instruction redirects the domain of the statement
+         */
+        void setDomain( const Value::Ptr& domain );
+
+        const Value::Ptr& domain( void ) const;
+
+        /**
+           @return the body block or a null pointer if no body was added yet
+         */
+        ExecutionSemanticsBlock::Ptr body( void );
+
+        void accept( Visitor& visitor ) override;
+
+        static inline Value::ID classid( void )
+        {
+            return Value::FORALL_STATEMENT;
+        }
+
+        static u1 classof( Value const* obj );
+
+      private:
+        std::shared_ptr< Identifier > m_variable;
+        Value::Ptr m_domain;
+        Use m_domainUse;
+    };
+
+    // TODO: FIXME: PPA: add IterateStatement etc.
 }
 
 #endif  // _LIBCASM_IR_STATEMENT_H_
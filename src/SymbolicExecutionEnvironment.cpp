@@ -45,15 +45,32 @@
 #include <libcasm-ir/Constant>
 #include <libcasm-ir/Exception>
 #include <libcasm-ir/Instruction>
+#include <libcasm-ir/ThreadScope>
 
 #include <libtptp/Definition>
 #include <libtptp/Type>
 
+#include <future>
 #include <memory>
 #include <sstream>
+#include <thread>
 
 using namespace libcasm_ir;
 
+static thread_local SymbolicExecutionEnvironment* s_active = nullptr;
+
+namespace
+{
+    class ActiveEnvironment final : public ThreadScope< SymbolicExecutionEnvironment* >
+    {
+      public:
+        ActiveEnvironment( SymbolicExecutionEnvironment& environment )
+        : ThreadScope( s_active, &environment )
+        {
+        }
+    };
+}
+
 bool SymbolicExecutionEnvironment::Location::Comperator::operator()(
     const Location& lhs, const Location& rhs )
 {
@@ -67,11 +84,24 @@ bool SymbolicExecutionEnvironment::Location::Comperator::operator()(
     return libstdhl::Hash::value( lhs ) < libstdhl::Hash::value( rhs );
 }
 
+u1 SymbolicExecutionEnvironment::Term::operator==( const Term& rhs ) const
+{
+    return id == rhs.id and type == rhs.type and operands.size() == rhs.operands.size() and
+           std::equal( operands.begin(), operands.end(), rhs.operands.begin() );
+}
+
+std::size_t SymbolicExecutionEnvironment::Term::Hash::operator()( const Term& term ) const
+{
+    const auto hash = libstdhl::Hash::combine( term.id, term.type );
+    return libstdhl::Hash::combine( hash, libstdhl::Hash::value( term.operands ) );
+}
+
 SymbolicExecutionEnvironment::ScopedEnvironment::ScopedEnvironment(
     SymbolicExecutionEnvironment* environment, const TPTP::Logic::Ptr& logic )
 : m_environment( environment )
 {
     m_environment->m_environments.push_back( logic );
+    m_environment->m_terms.emplace_back();
 }
 
 SymbolicExecutionEnvironment::ScopedEnvironment::~ScopedEnvironment( void )
@@ -79,6 +109,7 @@ SymbolicExecutionEnvironment::ScopedEnvironment::~ScopedEnvironment( void )
     if( m_environment != nullptr )
     {
         m_environment->m_environments.pop_back();
+        m_environment->m_terms.pop_back();
     }
 }
 
@@ -88,9 +119,40 @@ void SymbolicExecutionEnvironment::ScopedEnvironment::invalidate( void )
 }
 
 SymbolicExecutionEnvironment::SymbolicExecutionEnvironment( void )
-: m_symbolName( 0 )
+: m_parent( nullptr )
+, m_root( this )
+, m_shared( std::make_shared< Shared >() )
+, m_prefix()
+, m_symbolName( 0 )
 , m_formulaName( 0 )
+, m_forks( 0 )
 , m_time( 1 )
+, m_terms( 1 )
+, m_frames( false )
+, m_frameWindow( 0 )
+, m_flushedFunctionDefinitions( 0 )
+, m_flushedFunctions( 0 )
+{
+    m_shared->busyWorkers = 0;
+    m_shared->maxWorkers = std::max( 1u, std::thread::hardware_concurrency() );
+}
+
+SymbolicExecutionEnvironment::SymbolicExecutionEnvironment(
+    SymbolicExecutionEnvironment* parent, const std::string& prefix )
+: m_parent( parent )
+, m_root( parent->m_root )
+, m_shared( parent->m_shared )
+, m_prefix( prefix )
+, m_symbolName( 0 )
+, m_formulaName( 0 )
+, m_forks( 0 )
+, m_time( parent->m_time )
+, m_environments( parent->m_environments )
+, m_terms( 1 )
+, m_frames( parent->m_frames )
+, m_frameWindow( 0 )
+, m_flushedFunctionDefinitions( 0 )
+, m_flushedFunctions( 0 )
 {
 }
 
@@ -108,14 +170,14 @@ SymbolicExecutionEnvironment::~SymbolicExecutionEnvironment( void )
 std::string SymbolicExecutionEnvironment::generateSymbolName( void )
 {
     std::stringstream stream;
-    stream << "'%" << m_symbolName++ << "'";
+    stream << "'%" << m_prefix << m_symbolName++ << "'";
     return stream.str();
 }
 
 std::string SymbolicExecutionEnvironment::generateFormulaName( void )
 {
     std::stringstream stream;
-    stream << m_formulaName++;
+    stream << m_prefix << m_formulaName++;
     return stream.str();
 }
 
@@ -124,7 +186,7 @@ std::string SymbolicExecutionEnvironment::generateOperatorFunction( const Value&
     std::stringstream stream;
     stream << "'#" << Value::token( value.id() ) << "#" << value.type().name() << "'";
     auto functionName = stream.str();
-    if( m_functionDeclarations.find( functionName ) == m_functionDeclarations.end() )
+    if( functionDeclaration( functionName ) == nullptr )
     {
         auto args = std::make_shared< TPTP::ListTypeElements< TPTP::TokenBuilder::STAR > >();
 
@@ -162,7 +224,7 @@ std::string SymbolicExecutionEnvironment::generateOperatorFunction( const Value&
             formulaName, TPTP::Role::hypothesis(), formula );
         m_functionDeclarations.emplace( functionName, definition );
 
-        // generateFunctionDefinition( value, formulaName );
+        // generateFunctionDefinition( value, functionName );
     }
     return functionName;
 }
@@ -173,18 +235,27 @@ SymbolicConstant SymbolicExecutionEnvironment::get(
     const std::vector< Constant >& arguments )
 {
     auto symName = generateSymbolName();
-    auto symConst = SymbolicConstant( functionType->ptr_result(), symName, *this );
+    auto symConst = SymbolicConstant( functionType->ptr_result(), symName, *m_root );
 
-    auto time_it = m_symbolSetTimes.find( { constant, functionType->ptr_result(), arguments } );
     int time;
-    if( time_it == m_symbolSetTimes.end() )
+    if( m_frames )
     {
-        m_symbolSetTimes[ { constant, functionType->ptr_result(), arguments } ] = 1;
-        time = 1;
+        m_frameLocations.insert( { constant, functionType->ptr_result(), arguments } );
+        time = m_time - 1;
     }
     else
     {
-        time = time_it->second;
+        const Location location = { constant, functionType->ptr_result(), arguments };
+        const auto setTimeOfLocation = setTime( location );
+        if( setTimeOfLocation == nullptr )
+        {
+            m_symbolSetTimes[ location ] = 1;
+            time = 1;
+        }
+        else
+        {
+            time = *setTimeOfLocation;
+        }
     }
 
     setAtTime(
@@ -206,7 +277,7 @@ void SymbolicExecutionEnvironment::set(
         arguments,
         std::make_shared< TPTP::ConstantAtom >( symName, TPTP::Atom::Kind::PLAIN ),
         m_time );
-    m_symbolUpdateSet[ { varName, functionType->ptr_result(), arguments } ] = m_time;
+    recordUpdate( varName, functionType, arguments );
 }
 
 void SymbolicExecutionEnvironment::set(
@@ -216,7 +287,7 @@ void SymbolicExecutionEnvironment::set(
     const TPTP::Literal::Ptr& literal )
 {
     setAtTime( varName, arguments, std::make_shared< TPTP::DefinedAtom >( literal ), m_time );
-    m_symbolUpdateSet[ { varName, functionType->ptr_result(), arguments } ] = m_time;
+    recordUpdate( varName, functionType, arguments );
 }
 
 void SymbolicExecutionEnvironment::set(
@@ -226,7 +297,7 @@ void SymbolicExecutionEnvironment::set(
     const TPTP::Atom::Ptr& atom )
 {
     setAtTime( varName, arguments, atom, m_time );
-    m_symbolUpdateSet[ { varName, functionType->ptr_result(), arguments } ] = m_time;
+    recordUpdate( varName, functionType, arguments );
 }
 
 void SymbolicExecutionEnvironment::addFormula( const TPTP::Logic::Ptr& logic )
@@ -250,6 +321,11 @@ void SymbolicExecutionEnvironment::addFormula( const TPTP::Logic::Ptr& logic )
 void SymbolicExecutionEnvironment::addFunctionDeclaration(
     const std::string& name, const Type& type )
 {
+    if( function( name ) )
+    {
+        return;
+    }
+
     auto args = std::make_shared< TPTP::ListTypeElements< TPTP::TokenBuilder::STAR > >();
     args->add( std::make_shared< TPTP::NamedType >( "$int" ) );
 
@@ -270,7 +346,8 @@ void SymbolicExecutionEnvironment::addFunctionDeclaration(
     auto definition = std::make_shared< TPTP::FormulaDefinition >(
         generateFormulaName(), TPTP::Role::hypothesis(), formula );
 
-    m_functions.push_back( definition );
+    m_functions.emplace_back( name, definition );
+    m_frameFunctions.emplace( name, type.ptr_type() );
 }
 
 void SymbolicExecutionEnvironment::addSymbolDefinition( const TPTP::Logic::Ptr& logic )
@@ -281,8 +358,71 @@ void SymbolicExecutionEnvironment::addSymbolDefinition( const TPTP::Logic::Ptr&
     m_symbolDefinitions.push_back( formulaDef );
 }
 
+const SymbolicConstant* SymbolicExecutionEnvironment::term( const Term& key ) const
+{
+    for( auto scope = m_terms.rbegin(); scope != m_terms.rend(); ++scope )
+    {
+        const auto result = scope->find( key );
+        if( result != scope->end() )
+        {
+            return result->second.get();
+        }
+    }
+    return m_parent ? m_parent->term( key ) : nullptr;
+}
+
+void SymbolicExecutionEnvironment::addTerm( const Term& key, const SymbolicConstant& symbol )
+{
+    assert( not m_terms.empty() );
+    m_terms.back().emplace( key, std::make_shared< SymbolicConstant >( symbol ) );
+}
+
 TPTP::Specification::Ptr SymbolicExecutionEnvironment::finalize( void )
 {
+    if( m_parent )
+    {
+        throw InternalException( "unable to finalize a forked symbolic environment" );
+    }
+
+    if( m_frames )
+    {
+        // the final state is the one of the last completed step, it is bound
+        // at time 0 which is not used by any frame
+        for( const auto& location : m_frameLocations )
+        {
+            auto sym = get( location.varName, location.type, location.arguments );
+            setAtTime(
+                location.varName,
+                location.arguments,
+                std::make_shared< TPTP::ConstantAtom >( sym.name(), TPTP::Atom::Kind::PLAIN ),
+                0 );
+        }
+        m_frameLocations.clear();
+
+        auto spec = std::make_shared< TPTP::Specification >();
+        addPendingDeclarations( *spec );
+        for( const auto& frame : m_frameHistory )
+        {
+            for( const auto& def : frame.symbolDefinitions )
+            {
+                spec->add( def );
+            }
+            for( const auto& def : frame.formulae )
+            {
+                spec->add( def );
+            }
+        }
+        for( const auto& def : m_symbolDefinitions )
+        {
+            spec->add( def );
+        }
+        for( const auto& def : m_formulae )
+        {
+            spec->add( def );
+        }
+        return spec;
+    }
+
     for( auto& loc : m_symbolSetTimes )
     {
         auto sym = get( loc.first.varName, loc.first.type, loc.first.arguments );
@@ -308,11 +448,11 @@ TPTP::Specification::Ptr SymbolicExecutionEnvironment::finalize( void )
     }
     for( auto& def : m_functionDefinitons )
     {
-        spec->add( def );
+        spec->add( def.second );
     }
     for( const auto& def : m_functions )
     {
-        spec->add( def );
+        spec->add( def.second );
     }
     for( auto& def : m_formulae )
     {
@@ -323,6 +463,40 @@ TPTP::Specification::Ptr SymbolicExecutionEnvironment::finalize( void )
 
 void SymbolicExecutionEnvironment::incrementTime( void )
 {
+    if( m_parent )
+    {
+        throw InternalException( "unable to increment the time of a forked symbolic environment" );
+    }
+
+    if( m_frames )
+    {
+        for( const auto& function : m_frameFunctions )
+        {
+            const auto updates = m_frameUpdates.find( function.first );
+            const auto axiom = frameAxiom(
+                function.first,
+                *function.second,
+                updates != m_frameUpdates.end() ? updates->second : std::vector< FrameUpdate >{} );
+            if( axiom )
+            {
+                addFormula( axiom );
+            }
+        }
+        m_frameUpdates.clear();
+
+        m_frameHistory.push_back( { m_time, {}, {} } );
+        std::swap( m_frameHistory.back().symbolDefinitions, m_symbolDefinitions );
+        std::swap( m_frameHistory.back().formulae, m_formulae );
+
+        while( m_frameWindow > 0 and m_frameHistory.size() > m_frameWindow )
+        {
+            flushFrame();
+        }
+
+        ++m_time;
+        return;
+    }
+
     for( auto& update : m_symbolUpdateSet )
     {
         m_symbolSetTimes[ update.first ] = update.second;
@@ -429,8 +603,8 @@ const TPTP::Literal::Ptr SymbolicExecutionEnvironment::tptpLiteralFromNumericCon
         case Type::Kind::STRING:
         {
             // TODO: @moosbruggerj fix me
-            auto& val = static_cast< const StringConstant& >( constant ).value();
-            return std::make_shared< TPTP::IntegerLiteral >( val.toString() );
+            const auto val = static_cast< const StringConstant& >( constant ).value();
+            return std::make_shared< TPTP::IntegerLiteral >( val );
         }
         default:
         {
@@ -460,7 +634,7 @@ SymbolicConstant SymbolicExecutionEnvironment::mergeSymbolPaths(
     using BConnective = TPTP::BinaryLogic::Connective;
     assert( thenValue.type().ptr_result() == elseValue.type().ptr_result() );
 
-    SymbolicConstant localRes( thenValue.type().ptr_result(), generateSymbolName(), *this );
+    SymbolicConstant localRes( thenValue.type().ptr_result(), generateSymbolName(), *m_root );
 
     const auto thenSym = tptpAtomFromConstant( thenValue );
     const auto elseSym = tptpAtomFromConstant( elseValue );
@@ -497,8 +671,413 @@ SymbolicConstant SymbolicExecutionEnvironment::mergeSymbolPaths(
     return localRes;
 }
 
+SymbolicConstant SymbolicExecutionEnvironment::mergeSymbolPaths(
+    const libtptp::Atom::Ptr& tptpCondition, const Path& thenPath, const Path& elsePath )
+{
+    const auto inverse = std::make_shared< libtptp::UnaryLogic >(
+        libtptp::UnaryLogic::Connective::NEGATION, tptpCondition );
+    inverse->setLeftDelimiter( TPTP::TokenBuilder::LPAREN() );
+    inverse->setRightDelimiter( TPTP::TokenBuilder::RPAREN() );
+
+    const auto thenFork = fork();
+    const auto elseFork = fork();
+
+    const auto explore = []( SymbolicExecutionEnvironment& environment,
+                             const TPTP::Logic::Ptr& condition,
+                             const Path& path ) -> Constant {
+        const ActiveEnvironment active( environment );
+        const auto scope = environment.makeEnvironment( condition );
+        return path( environment );
+    };
+
+    std::future< Constant > thenResult;
+    if( acquireWorker() )
+    {
+        thenResult = std::async( std::launch::async, [&]() {
+            struct Release
+            {
+                SymbolicExecutionEnvironment& environment;
+                ~Release( void )
+                {
+                    environment.releaseWorker();
+                }
+            } release{ *this };
+            return explore( *thenFork, tptpCondition, thenPath );
+        } );
+    }
+    else
+    {
+        thenResult = std::async( std::launch::deferred, [&]() {
+            return explore( *thenFork, tptpCondition, thenPath );
+        } );
+    }
+
+    const auto elseValue = explore( *elseFork, inverse, elsePath );
+    const auto thenValue = thenResult.get();
+
+    join( *thenFork );
+    join( *elseFork );
+
+    return mergeSymbolPaths( tptpCondition, thenValue, elseValue );
+}
+
+SymbolicExecutionEnvironment::Ptr SymbolicExecutionEnvironment::fork( void )
+{
+    const auto prefix = m_prefix + "f" + std::to_string( m_forks++ ) + "_";
+    return Ptr( new SymbolicExecutionEnvironment( this, prefix ) );
+}
+
+void SymbolicExecutionEnvironment::join( SymbolicExecutionEnvironment& fork )
+{
+    if( fork.m_parent != this )
+    {
+        throw InternalException( "unable to join a symbolic environment which is not a fork" );
+    }
+
+    const auto append = []( std::vector< TPTP::FormulaDefinition::Ptr >& to,
+                            std::vector< TPTP::FormulaDefinition::Ptr >& from ) {
+        to.insert( to.end(), from.begin(), from.end() );
+        from.clear();
+    };
+
+    append( m_symbolDefinitions, fork.m_symbolDefinitions );
+    append( m_formulae, fork.m_formulae );
+
+    // both forks may declare the same function or operator function, only
+    // the first declaration and its definitions are kept, definitions are
+    // keyed by the name of the function they define
+    std::unordered_set< std::string > declared;
+    for( const auto& declaration : fork.m_functionDeclarations )
+    {
+        if( m_functionDeclarations.emplace( declaration ).second )
+        {
+            declared.emplace( declaration.first );
+        }
+    }
+    for( const auto& definition : fork.m_functionDefinitons )
+    {
+        if( declared.count( definition.first ) )
+        {
+            m_functionDefinitons.emplace_back( definition );
+        }
+    }
+    for( const auto& function : fork.m_functions )
+    {
+        const auto& type = fork.m_frameFunctions.at( function.first );
+        if( m_frameFunctions.emplace( function.first, type ).second )
+        {
+            m_functions.emplace_back( function );
+        }
+    }
+    for( const auto& location : fork.m_symbolSetTimes )
+    {
+        m_symbolSetTimes.emplace( location );
+    }
+    for( const auto& location : fork.m_symbolUpdateSet )
+    {
+        m_symbolUpdateSet[ location.first ] = location.second;
+    }
+    for( const auto& function : fork.m_frameUpdates )
+    {
+        auto& updates = m_frameUpdates[ function.first ];
+        updates.insert( updates.end(), function.second.begin(), function.second.end() );
+    }
+    m_frameLocations.insert( fork.m_frameLocations.begin(), fork.m_frameLocations.end() );
+
+    fork.m_functionDefinitons.clear();
+    fork.m_functions.clear();
+    fork.m_functionDeclarations.clear();
+    fork.m_symbolSetTimes.clear();
+    fork.m_symbolUpdateSet.clear();
+    fork.m_frameFunctions.clear();
+    fork.m_frameUpdates.clear();
+    fork.m_frameLocations.clear();
+}
+
+void SymbolicExecutionEnvironment::setWorkers( const std::size_t workers )
+{
+    m_shared->maxWorkers = workers;
+}
+
+std::size_t SymbolicExecutionEnvironment::workers( void ) const
+{
+    return m_shared->maxWorkers;
+}
+
+SymbolicExecutionEnvironment& SymbolicExecutionEnvironment::root( void ) const
+{
+    return *m_root;
+}
+
+SymbolicExecutionEnvironment& SymbolicExecutionEnvironment::active(
+    SymbolicExecutionEnvironment& environment )
+{
+    return s_active ? *s_active : environment;
+}
+
+const int* SymbolicExecutionEnvironment::setTime( const Location& location ) const
+{
+    const auto result = m_symbolSetTimes.find( location );
+    if( result != m_symbolSetTimes.end() )
+    {
+        return &result->second;
+    }
+    return m_parent ? m_parent->setTime( location ) : nullptr;
+}
+
+const TPTP::FormulaDefinition::Ptr* SymbolicExecutionEnvironment::functionDeclaration(
+    const std::string& name ) const
+{
+    const auto result = m_functionDeclarations.find( name );
+    if( result != m_functionDeclarations.end() )
+    {
+        return &result->second;
+    }
+    return m_parent ? m_parent->functionDeclaration( name ) : nullptr;
+}
+
+const Type::Ptr* SymbolicExecutionEnvironment::function( const std::string& name ) const
+{
+    const auto result = m_frameFunctions.find( name );
+    if( result != m_frameFunctions.end() )
+    {
+        return &result->second;
+    }
+    return m_parent ? m_parent->function( name ) : nullptr;
+}
+
+void SymbolicExecutionEnvironment::enableFrames( const std::size_t window, const FrameSink& sink )
+{
+    if( m_parent )
+    {
+        throw InternalException( "unable to enable frames of a forked symbolic environment" );
+    }
+
+    if( window > 0 and not sink )
+    {
+        throw InternalException( "frame window of '" + std::to_string( window ) +
+                                 "' requires a frame sink" );
+    }
+
+    if( not m_frames )
+    {
+        // the initial state is at time 1 like in the step based
+        // representation, time 0 is reserved for the final state
+        ++m_time;
+    }
+
+    m_frames = true;
+    m_frameWindow = window;
+    m_frameSink = sink;
+}
+
+u1 SymbolicExecutionEnvironment::frames( void ) const
+{
+    return m_frames;
+}
+
+int SymbolicExecutionEnvironment::time( void ) const
+{
+    return m_time;
+}
+
+std::size_t SymbolicExecutionEnvironment::size( void ) const
+{
+    auto size = m_symbolDefinitions.size() + m_functionDeclarations.size() +
+                m_functionDefinitons.size() + m_functions.size() + m_formulae.size();
+    for( const auto& frame : m_frameHistory )
+    {
+        size += frame.symbolDefinitions.size() + frame.formulae.size();
+    }
+    return size;
+}
+
+void SymbolicExecutionEnvironment::recordUpdate(
+    const std::string& varName,
+    const Type::Ptr& functionType,
+    const std::vector< Constant >& arguments )
+{
+    if( not m_frames )
+    {
+        m_symbolUpdateSet[ { varName, functionType->ptr_result(), arguments } ] = m_time;
+        return;
+    }
+
+    m_frameLocations.insert( { varName, functionType->ptr_result(), arguments } );
+
+    FrameUpdate update = { m_environments, {} };
+    for( const auto& argument : arguments )
+    {
+        update.arguments.emplace_back( tptpAtomFromConstant( argument ) );
+    }
+    m_frameUpdates[ varName ].emplace_back( update );
+}
+
+TPTP::Logic::Ptr SymbolicExecutionEnvironment::frameAxiom(
+    const std::string& varName, const Type& type, const std::vector< FrameUpdate >& updates ) const
+{
+    using Connective = TPTP::BinaryLogic::Connective;
+
+    // ! [X0, ..., Xn, V] : ( ( @f(t - 1, X0, ..., Xn, V) & ~( updated ) ) => @f(t, X0, ..., V) )
+
+    std::vector< Type::Ptr > argumentTypes;
+    for( const auto& argumentType : type.arguments() )
+    {
+        argumentTypes.emplace_back( argumentType );
+    }
+
+    const auto variable = [ & ]( const std::size_t position ) {
+        if( position < argumentTypes.size() )
+        {
+            return std::make_shared< TPTP::VariableTerm >(
+                "X" + std::to_string( position ), getTPTPType( *argumentTypes[ position ] ) );
+        }
+        return std::make_shared< TPTP::VariableTerm >( "V", getTPTPType( type.result() ) );
+    };
+
+    const auto state = [ & ]( const int time ) {
+        auto args = std::make_shared< TPTP::ListLogicElements >(
+            std::initializer_list< TPTP::Logic::Ptr >{
+                std::make_shared< TPTP::DefinedAtom >( time ),
+            } );
+        for( std::size_t position = 0; position <= argumentTypes.size(); position++ )
+        {
+            args->add( variable( position ) );
+        }
+        return std::make_shared< TPTP::FunctorAtom >(
+            storeFunctionFromName( varName ), args, TPTP::Atom::Kind::PLAIN );
+    };
+
+    const auto combine = []( const TPTP::Logic::Ptr& lhs,
+                             const Connective connective,
+                             const TPTP::Logic::Ptr& rhs ) -> TPTP::Logic::Ptr {
+        if( not lhs )
+        {
+            return rhs;
+        }
+        const auto logic = std::make_shared< TPTP::BinaryLogic >( lhs, connective, rhs );
+        logic->setLeftDelimiter( TPTP::TokenBuilder::LPAREN() );
+        logic->setRightDelimiter( TPTP::TokenBuilder::RPAREN() );
+        return logic;
+    };
+
+    TPTP::Logic::Ptr updated = nullptr;
+    for( const auto& update : updates )
+    {
+        TPTP::Logic::Ptr guard = nullptr;
+        for( const auto& environment : update.environments )
+        {
+            environment->setLeftDelimiter( TPTP::TokenBuilder::LPAREN() );
+            environment->setRightDelimiter( TPTP::TokenBuilder::RPAREN() );
+            guard = combine( guard, Connective::CONJUNCTION, environment );
+        }
+
+        for( std::size_t position = 0; position < update.arguments.size(); position++ )
+        {
+            const auto equ = std::make_shared< TPTP::InfixLogic >(
+                variable( position ),
+                TPTP::InfixLogic::Connective::EQUALITY,
+                update.arguments[ position ] );
+            equ->setLeftDelimiter( TPTP::TokenBuilder::LPAREN() );
+            equ->setRightDelimiter( TPTP::TokenBuilder::RPAREN() );
+            guard = combine( guard, Connective::CONJUNCTION, equ );
+        }
+
+        if( not guard )
+        {
+            // unconditional update of a nullary function, nothing to carry over
+            return nullptr;
+        }
+
+        updated = combine( updated, Connective::DISJUNCTION, guard );
+    }
+
+    TPTP::Logic::Ptr previous = state( m_time - 1 );
+    if( updated )
+    {
+        const auto unchanged = std::make_shared< TPTP::UnaryLogic >(
+            TPTP::UnaryLogic::Connective::NEGATION, updated );
+        unchanged->setLeftDelimiter( TPTP::TokenBuilder::LPAREN() );
+        unchanged->setRightDelimiter( TPTP::TokenBuilder::RPAREN() );
+        previous = combine( previous, Connective::CONJUNCTION, unchanged );
+    }
+
+    TPTP::Logic::Ptr axiom = combine( previous, Connective::IMPLICATION, state( m_time ) );
+    for( std::size_t position = argumentTypes.size() + 1; position > 0; position-- )
+    {
+        axiom = std::make_shared< TPTP::QuantifiedLogic >(
+            TPTP::QuantifiedLogic::Quantifier::UNIVERSAL,
+            std::initializer_list< TPTP::VariableTerm::Ptr >{ variable( position - 1 ) },
+            axiom );
+    }
+    return axiom;
+}
+
+void SymbolicExecutionEnvironment::flushFrame( void )
+{
+    assert( not m_frameHistory.empty() and m_frameSink );
+
+    auto specification = std::make_shared< TPTP::Specification >();
+    addPendingDeclarations( *specification );
+
+    const auto& frame = m_frameHistory.front();
+    for( const auto& def : frame.symbolDefinitions )
+    {
+        specification->add( def );
+    }
+    for( const auto& def : frame.formulae )
+    {
+        specification->add( def );
+    }
+    m_frameHistory.pop_front();
+
+    // the term table of the root scope would grow with every step, cached
+    // terms are dropped and defined again by the next frame which uses them
+    m_terms.front().clear();
+
+    m_frameSink( specification );
+}
+
+void SymbolicExecutionEnvironment::addPendingDeclarations( TPTP::Specification& specification )
+{
+    for( const auto& def : m_functionDeclarations )
+    {
+        if( m_flushedDeclarations.emplace( def.first ).second )
+        {
+            specification.add( def.second );
+        }
+    }
+    for( ; m_flushedFunctionDefinitions < m_functionDefinitons.size();
+         m_flushedFunctionDefinitions++ )
+    {
+        specification.add( m_functionDefinitons[ m_flushedFunctionDefinitions ].second );
+    }
+    for( ; m_flushedFunctions < m_functions.size(); m_flushedFunctions++ )
+    {
+        specification.add( m_functions[ m_flushedFunctions ].second );
+    }
+}
+
+u1 SymbolicExecutionEnvironment::acquireWorker( void )
+{
+    auto busy = m_shared->busyWorkers.load();
+    while( busy < m_shared->maxWorkers )
+    {
+        if( m_shared->busyWorkers.compare_exchange_weak( busy, busy + 1 ) )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SymbolicExecutionEnvironment::releaseWorker( void )
+{
+    m_shared->busyWorkers--;
+}
+
 void SymbolicExecutionEnvironment::generateFunctionDefinition(
-    const Value& value, const std::string& formulaName )
+    const Value& value, const std::string& functionName )
 {
     switch( value.id() )
     {
@@ -524,7 +1103,7 @@ void SymbolicExecutionEnvironment::generateFunctionDefinition(
                 std::make_shared< TPTP::VariableTerm >( "Z", getTPTPType( value.type().result() ) );
 
             auto funcCall = std::make_shared< TPTP::FunctorAtom >(
-                formulaName,
+                functionName,
                 std::initializer_list< TPTP::Logic::Ptr >{ X, Y, Z },
                 TPTP::Atom::Kind::PLAIN );
 
@@ -558,7 +1137,7 @@ void SymbolicExecutionEnvironment::generateFunctionDefinition(
             auto formula = std::make_shared< TPTP::TypedFirstOrderFormula >( quantified );
             auto formulaDefiniton = std::make_shared< TPTP::FormulaDefinition >(
                 generateFormulaName(), TPTP::Role::hypothesis(), formula );
-            m_functionDefinitons.push_back( formulaDefiniton );
+            m_functionDefinitons.emplace_back( functionName, formulaDefiniton );
         }
         default:
         {
@@ -43,9 +43,15 @@
 #define _LIBCASM_IR_SYMBOLIC_EXECUTION_ENVIRONMENT_H
 
 #include <algorithm>
+#include <atomic>
+#include <deque>
+#include <functional>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <libtptp/Logic>
 #include <libtptp/Specification>
@@ -105,6 +111,39 @@ namespace libcasm_ir
         };
         friend class ScopedEnvironment;
 
+        using Ptr = std::shared_ptr< SymbolicExecutionEnvironment >;
+
+        /**
+           structural key of a hash-consed symbolic term, the operands of a
+           commutative operation are expected in a canonical order
+         */
+        struct Term
+        {
+            Value::ID id;
+            std::size_t type;
+            std::vector< Constant > operands;
+
+            u1 operator==( const Term& rhs ) const;
+
+            class Hash
+            {
+              public:
+                std::size_t operator()( const Term& term ) const;
+            };
+        };
+
+        /**
+           explores one branch alternative inside a forked environment and
+           returns the value of the alternative
+         */
+        using Path = std::function< Constant( SymbolicExecutionEnvironment& environment ) >;
+
+        /**
+           receives a compacted frame together with all declarations which
+           were not handed out before
+         */
+        using FrameSink = std::function< void( const TPTP::Specification::Ptr& frame ) >;
+
         enum Semantics : u8
         {
             ADD,
@@ -145,9 +184,40 @@ namespace libcasm_ir
         void addFormula( const TPTP::Logic::Ptr& logic );
         void addFunctionDeclaration( const std::string& name, const Type& type );
         void addSymbolDefinition( const TPTP::Logic::Ptr& logic );
+
+        /**
+           hash-consed symbolic terms, a term added inside a scoped environment
+           is only visible until the scope is left, because its defining
+           formula is guarded by the environment condition; the terms of the
+           root scope are dropped whenever a frame is flushed
+         */
+        const SymbolicConstant* term( const Term& key ) const;
+        void addTerm( const Term& key, const SymbolicConstant& symbol );
+
         TPTP::Specification::Ptr finalize( void );
         void incrementTime( void );
 
+        /**
+           switches to the frame based state representation, a location read
+           in step t refers to the state at t and every step only carries its
+           own updates at t + 1, unchanged locations are carried over by one
+           frame axiom per declared function, if the window is non-zero all
+           frames older than the window are handed to the sink and dropped,
+           the time 0 is left for the final state bound by 'finalize'
+         */
+        void enableFrames( const std::size_t window, const FrameSink& sink = nullptr );
+        u1 frames( void ) const;
+
+        /**
+           time at which the current step binds its updates
+         */
+        int time( void ) const;
+
+        /**
+           number of formula definitions which are currently held in memory
+         */
+        std::size_t size( void ) const;
+
         ScopedEnvironment::Ptr makeEnvironment( const TPTP::Logic::Ptr& logic );
 
         const TPTP::Type::Ptr getTPTPType( const Type& type ) const;
@@ -159,8 +229,81 @@ namespace libcasm_ir
             const Constant& thenValue,
             const Constant& elseValue );
 
+        /**
+           explores both alternatives in forked environments, the then path
+           runs in a worker thread if one is available, and merges the formula
+           sets of both forks back in a deterministic order; the library
+           itself never branches on a symbolic condition, this is the entry
+           point for the interpreter which executes the branch statements
+         */
+        SymbolicConstant mergeSymbolPaths(
+            const libtptp::Atom::Ptr& tptpCondition, const Path& thenPath, const Path& elsePath );
+
+        /**
+           forks the environment, the fork only records its own delta and
+           reads through to this environment for everything before the fork,
+           this environment must not be modified until the fork is joined,
+           symbol and formula names of the fork are prefixed by its position
+           in the fork tree and therefore independent of the thread schedule
+         */
+        Ptr fork( void );
+        void join( SymbolicExecutionEnvironment& fork );
+
+        /**
+           environment which is not a fork, symbols always refer to it
+           because it outlives every fork they are created in
+         */
+        SymbolicExecutionEnvironment& root( void ) const;
+
+        void setWorkers( const std::size_t workers );
+        std::size_t workers( void ) const;
+
+        /**
+           resolves the environment which is explored by the current thread,
+           symbols only refer to the root environment
+         */
+        static SymbolicExecutionEnvironment& active( SymbolicExecutionEnvironment& environment );
+
       private:
-        void generateFunctionDefinition( const Value& value, const std::string& name );
+        struct Frame
+        {
+            int time;
+            std::vector< TPTP::FormulaDefinition::Ptr > symbolDefinitions;
+            std::vector< TPTP::FormulaDefinition::Ptr > formulae;
+        };
+
+        struct FrameUpdate
+        {
+            std::vector< TPTP::Logic::Ptr > environments;
+            std::vector< TPTP::Atom::Ptr > arguments;
+        };
+
+        struct Shared
+        {
+            std::atomic< std::size_t > busyWorkers;
+            std::atomic< std::size_t > maxWorkers;
+        };
+
+        SymbolicExecutionEnvironment(
+            SymbolicExecutionEnvironment* parent, const std::string& prefix );
+
+        const int* setTime( const Location& location ) const;
+        const TPTP::FormulaDefinition::Ptr* functionDeclaration( const std::string& name ) const;
+        const Type::Ptr* function( const std::string& name ) const;
+        void recordUpdate(
+            const std::string& varName,
+            const Type::Ptr& functionType,
+            const std::vector< Constant >& arguments );
+        TPTP::Logic::Ptr frameAxiom(
+            const std::string& varName,
+            const Type& type,
+            const std::vector< FrameUpdate >& updates ) const;
+        void flushFrame( void );
+        void addPendingDeclarations( TPTP::Specification& specification );
+        u1 acquireWorker( void );
+        void releaseWorker( void );
+
+        void generateFunctionDefinition( const Value& value, const std::string& functionName );
         std::string storeFunctionFromName( const std::string& name ) const;
         void setAtTime(
             const std::string& varName,
@@ -168,21 +311,40 @@ namespace libcasm_ir
             const TPTP::Atom::Ptr symbol,
             int time );
 
-        int m_symbolName;
-        int m_formulaName;
+        const SymbolicExecutionEnvironment* m_parent;
+        SymbolicExecutionEnvironment* m_root;
+        std::shared_ptr< Shared > m_shared;
+        const std::string m_prefix;
+        std::size_t m_symbolName;
+        std::size_t m_formulaName;
+        std::size_t m_forks;
         int m_time;
 
         std::vector< TPTP::Logic::Ptr > m_environments;
         std::vector< std::weak_ptr< ScopedEnvironment > > m_scoped_environments;
+        std::vector<
+            std::unordered_map< Term, std::shared_ptr< SymbolicConstant >, Term::Hash > >
+            m_terms;
 
         std::map< Location, int, Location::Comperator > m_symbolSetTimes;
         std::map< Location, int, Location::Comperator > m_symbolUpdateSet;
 
         std::map< std::string, TPTP::FormulaDefinition::Ptr > m_functionDeclarations;
-        std::vector< TPTP::FormulaDefinition::Ptr > m_functionDefinitons;
+        std::vector< std::pair< std::string, TPTP::FormulaDefinition::Ptr > > m_functionDefinitons;
         std::vector< TPTP::FormulaDefinition::Ptr > m_symbolDefinitions;
-        std::vector< TPTP::FormulaDefinition::Ptr > m_functions;
+        std::vector< std::pair< std::string, TPTP::FormulaDefinition::Ptr > > m_functions;
         std::vector< TPTP::FormulaDefinition::Ptr > m_formulae;
+
+        u1 m_frames;
+        std::size_t m_frameWindow;
+        FrameSink m_frameSink;
+        std::deque< Frame > m_frameHistory;
+        std::map< std::string, Type::Ptr > m_frameFunctions;
+        std::map< std::string, std::vector< FrameUpdate > > m_frameUpdates;
+        std::set< Location, Location::Comperator > m_frameLocations;
+        std::unordered_set< std::string > m_flushedDeclarations;
+        std::size_t m_flushedFunctionDefinitions;
+        std::size_t m_flushedFunctions;
     };
 }
 
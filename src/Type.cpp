@@ -42,7 +42,9 @@
 #include "Type.h"
 
 #include "Constant.h"
+#include "DomainCursor.h"
 #include "Exception.h"
+#include "RandomStream.h"
 
 #include <libstdhl/Random>
 
@@ -721,7 +723,7 @@ void BooleanType::foreach( const std::function< void( const Constant& constant )
 
 Constant BooleanType::choose( void ) const
 {
-    auto const value = ( u1 )( libstdhl::Random::uniform< u64 >() % 2 );
+    auto const value = ( u1 )( RandomStream::draw() >> 63 );
     return BooleanConstant( value );
 }
 
@@ -816,7 +818,7 @@ Constant IntegerType::choose( void ) const
     }
     else
     {
-        return IntegerConstant( libstdhl::Random::uniform< i64 >() );
+        return IntegerConstant( ( i64 )( RandomStream::draw() ) );
         // LIMITATION: currently we only address the 64-bit range for
         // this choosing value range, can be extended later even to address
         // bigger
@@ -874,9 +876,9 @@ void RationalType::foreach(
 
 Constant RationalType::choose( void ) const
 {
-    const auto n = libstdhl::Type::createInteger( libstdhl::Random::uniform< i64 >() );
+    const auto n = libstdhl::Type::createInteger( ( i64 )( RandomStream::draw() ) );
 
-    const auto d = libstdhl::Type::createInteger( libstdhl::Random::uniform< i64 >() + 1 );
+    const auto d = libstdhl::Type::createInteger( ( i64 )( RandomStream::draw() ) + 1 );
     // d = randomvalue + 1 to avoid that the denominator is zero!
 
     return RationalConstant( libstdhl::Type::createRational( n, d ) );
@@ -966,9 +968,8 @@ Constant BinaryType::choose( void ) const
 {
     return BinaryConstant(
         m_bitsize,
-        libstdhl::Random::uniform< u64 >() %
-            m_bitsize );  // TODO: FIXME: PPA: fix the randomized value modulo
-                          // mapping to full range not only the bitsize
+        RandomStream::draw() % m_bitsize );  // TODO: FIXME: PPA: fix the randomized value modulo
+                                             // mapping to full range not only the bitsize
 }
 
 void BinaryType::validate( const Constant& constant ) const
@@ -1130,17 +1131,20 @@ std::string EnumerationType::description( void ) const
 void EnumerationType::foreach(
     const std::function< void( const Constant& constant ) >& callback ) const
 {
-    for( auto element : m_kind->elements() )
+    const auto type = std::static_pointer_cast< EnumerationType >( ptr_type() );
+    const auto size = m_kind->elements().size();
+
+    for( std::size_t index = 0; index < size; index++ )
     {
-        callback( EnumerationConstant( m_kind, element ) );
+        callback( EnumerationConstant( type, index ) );
     }
 }
 
 Constant EnumerationType::choose( void ) const
 {
-    const auto e = libstdhl::Random::uniform< std::size_t >( 0, m_kind->elements().size() - 1 );
+    const auto e = RandomStream::draw( ( u64 )( m_kind->elements().size() ) );
 
-    return EnumerationConstant( m_kind, m_kind->elements()[ e ] );
+    return EnumerationConstant( std::static_pointer_cast< EnumerationType >( ptr_type() ), e );
 }
 
 void EnumerationType::validate( const Constant& constant ) const
@@ -1251,6 +1255,25 @@ void RangeType::foreach( const std::function< void( const Constant& constant ) >
 {
     if( type().isInteger() )
     {
+        i64 first = 0;
+        i64 last = 0;
+        if( m_range and DomainCursor::native( *range().from(), first ) and
+            DomainCursor::native( *range().to(), last ) )
+        {
+            // native counter, the last element is checked before the
+            // increment to not overflow at the upper limit
+            for( auto i = first; i <= last; ++i )
+            {
+                callback( IntegerConstant( i ) );
+
+                if( i == last )
+                {
+                    break;
+                }
+            }
+            return;
+        }
+
         const auto a = m_range ? static_cast< IntegerConstant& >( *range().from() ).value()
                                : libstdhl::Limits< libstdhl::Type::Integer >::min();
 
@@ -1294,6 +1317,16 @@ Constant RangeType::choose( void ) const
     {
         if( m_range )
         {
+            i64 from = 0;
+            i64 to = 0;
+            if( DomainCursor::native( *range().from(), from ) and
+                DomainCursor::native( *range().to(), to ) and from <= to )
+            {
+                return IntegerConstant( RandomStream::draw( from, to ) );
+            }
+
+            // LIMITATION: big integer ranges are not drawn from the active
+            // random stream and are therefore not reproducible by seed
             const auto& a = static_cast< IntegerConstant& >( *range().from() ).value();
             const auto& b = static_cast< IntegerConstant& >( *range().to() ).value();
 
@@ -1308,6 +1341,8 @@ Constant RangeType::choose( void ) const
     {
         if( m_range )
         {
+            // LIMITATION: decimal ranges are not drawn from the active
+            // random stream and are therefore not reproducible by seed
             const auto& a = static_cast< DecimalConstant& >( *range().from() ).value();
             const auto& b = static_cast< DecimalConstant& >( *range().to() ).value();
 
@@ -1325,11 +1360,11 @@ Constant RangeType::choose( void ) const
             const auto a = static_cast< BooleanConstant& >( *range().from() ).value().value();
             const auto b = static_cast< BooleanConstant& >( *range().to() ).value().value();
 
-            return BooleanConstant( libstdhl::Random::uniform< u8 >( a, b ) );
+            return BooleanConstant( ( u1 )( RandomStream::draw( (i64)a, (i64)b ) ) );
         }
         else
         {
-            return BooleanConstant( libstdhl::Random::uniform< u8 >( false, true ) );
+            return BooleanConstant( ( u1 )( RandomStream::draw() >> 63 ) );
         }
     }
 
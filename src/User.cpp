@@ -48,38 +48,186 @@
 #include "Function.h"
 #include "Instruction.h"
 #include "Rule.h"
+#include "Statement.h"
+
+#include <cassert>
 
 using namespace libcasm_ir;
 
-const std::vector< Use::Ptr >& User::uses( void ) const
+//
+// Use
+//
+
+Use::Use( Value& use, User* def )
+: m_def( def )
+, m_use( &use )
+, m_next( nullptr )
+, m_prev( nullptr )
+{
+    link();
+}
+
+Use::Use( Use&& other ) noexcept
+: m_def( other.m_def )
+, m_use( other.m_use )
+, m_next( other.m_next )
+, m_prev( other.m_prev )
+{
+    if( m_prev )
+    {
+        *m_prev = this;
+    }
+    if( m_next )
+    {
+        m_next->m_prev = &m_next;
+    }
+
+    other.m_def = nullptr;
+    other.m_next = nullptr;
+    other.m_prev = nullptr;
+}
+
+Use::~Use( void )
+{
+    unlink();
+}
+
+User& Use::def( void ) const
 {
-    return m_uses;
+    assert( m_def );
+    return *m_def;
 }
 
-void User::setUse( User& user )
+Value& Use::use( void ) const
 {
-    m_uses.emplace_back( libstdhl::Memory::make< Use >( *this, user ) );
+    return *m_use;
 }
 
-void User::removeUse( const User& user )
+void Use::set( User* def )
 {
-    fprintf( stderr, "removeUse: %s in %s\n", user.name().c_str(), name().c_str() );
+    if( m_def == def )
+    {
+        return;
+    }
+
+    unlink();
+    m_def = def;
+    link();
+}
+
+Use* Use::next( void ) const
+{
+    return m_next;
+}
+
+void Use::link( void )
+{
+    if( not m_def )
+    {
+        return;
+    }
+
+    m_next = m_def->m_uses;
+    if( m_next )
+    {
+        m_next->m_prev = &m_next;
+    }
 
-    std::remove_if( m_uses.begin(), m_uses.end(), [&user]( const Use::Ptr& element ) {
-        return element->use() == user;
-    } );
+    m_prev = &m_def->m_uses;
+    m_def->m_uses = this;
+}
+
+void Use::unlink( void )
+{
+    if( not m_prev )
+    {
+        return;
+    }
+
+    *m_prev = m_next;
+    if( m_next )
+    {
+        m_next->m_prev = m_prev;
+    }
+
+    m_next = nullptr;
+    m_prev = nullptr;
+}
+
+//
+// UseList
+//
+
+std::size_t UseList::size( void ) const
+{
+    std::size_t size = 0;
+
+    for( auto use = m_head; use; use = use->next() )
+    {
+        size++;
+    }
+
+    return size;
+}
+
+//
+// User
+//
+
+User::~User( void )
+{
+    // detach the remaining uses, their users are not able to reference
+    // this definition anymore
+    auto use = m_uses;
+    while( use )
+    {
+        const auto next = use->m_next;
+        use->m_def = nullptr;
+        use->m_next = nullptr;
+        use->m_prev = nullptr;
+        use = next;
+    }
+}
+
+UseList User::uses( void ) const
+{
+    return UseList( m_uses );
 }
 
 void User::replaceAllUsesWith( const Value::Ptr& value )
 {
-    for( auto u : uses() )
+    if( not value )
     {
-        fprintf( stderr, "%s -> %s\n", u->def().name().c_str(), u->use().name().c_str() );
+        throw std::domain_error( "replacement value is a null pointer" );
+    }
 
-        if( auto instr = cast< Instruction >( u->use() ) )
+    if( value.get() == this )
+    {
+        return;
+    }
+
+    // every redirected use unlinks itself from the head of the use list,
+    // the replaced operand keeps this definition alive until the end
+    Value::Ptr self = nullptr;
+
+    while( m_uses )
+    {
+        auto& use = *m_uses;
+
+        if( isa< ForallStatement >( use.use() ) )
         {
-            instr->replace( u->def(), value );
+            auto& forall = static_cast< ForallStatement& >( use.use() );
+            self = forall.domain();
+            forall.setDomain( value );
+            continue;
         }
+
+        assert( isa< Instruction >( use.use() ) );
+        auto& instr = static_cast< Instruction& >( use.use() );
+
+        const auto position = instr.position( use );
+        self = instr.operands()[ position ];
+        instr.setOperand( position, value );
     }
 }
 
@@ -48,30 +48,115 @@ namespace libcasm_ir
 {
     class User;
 
+    /**
+       operand slot of a user which links into the intrusive use list of
+       its definition, the slot is owned by the user and relinks itself
+       when it is moved, adding, removing and redirecting a use is O(1),
+       the user is an instruction or the forall statement of a domain
+     */
     class Use : public CasmIR
     {
       public:
-        using Ptr = std::shared_ptr< Use >;
+        Use( Value& use, User* def = nullptr );
 
-        Use( Value& def, User& use )
-        : m_def( def )
-        , m_use( use )
+        Use( Use&& other ) noexcept;
+
+        Use( const Use& ) = delete;
+
+        Use& operator=( const Use& ) = delete;
+
+        ~Use( void );
+
+        User& def( void ) const;
+
+        Value& use( void ) const;
+
+        /**
+           redirects the use to a new definition or detaches it if the
+           definition is a null pointer
+         */
+        void set( User* def );
+
+        Use* next( void ) const;
+
+      private:
+        void link( void );
+
+        void unlink( void );
+
+        User* m_def;
+        Value* m_use;
+        Use* m_next;
+        Use** m_prev;
+
+        friend class User;
+    };
+
+    class UseList
+    {
+      public:
+        class Iterator
+        {
+          public:
+            Iterator( Use* use )
+            : m_use( use )
+            {
+            }
+
+            Use& operator*( void ) const
+            {
+                return *m_use;
+            }
+
+            Use* operator->( void ) const
+            {
+                return m_use;
+            }
+
+            Iterator& operator++( void )
+            {
+                m_use = m_use->next();
+                return *this;
+            }
+
+            u1 operator==( const Iterator& rhs ) const
+            {
+                return m_use == rhs.m_use;
+            }
+
+            u1 operator!=( const Iterator& rhs ) const
+            {
+                return m_use != rhs.m_use;
+            }
+
+          private:
+            Use* m_use;
+        };
+
+        UseList( Use* head )
+        : m_head( head )
+        {
+        }
+
+        Iterator begin( void ) const
         {
+            return Iterator( m_head );
         }
 
-        Value& def( void ) const
+        Iterator end( void ) const
         {
-            return m_def;
+            return Iterator( nullptr );
         }
 
-        User& use( void ) const
+        u1 empty( void ) const
         {
-            return m_use;
+            return m_head == nullptr;
         }
 
+        std::size_t size( void ) const;
+
       private:
-        Value& m_def;
-        User& m_use;
+        Use* m_head;
     };
 
     class User : public Value
@@ -79,15 +164,27 @@ namespace libcasm_ir
       public:
         inline User( const Type::Ptr& type, Value::ID id = classid() )
         : Value( type, id )
-        , m_uses()
+        , m_uses( nullptr )
+        {
+        }
+
+        /**
+           a copied user has no uses, the uses of the original are kept
+         */
+        inline User( const User& other )
+        : Value( other )
+        , m_uses( nullptr )
         {
         }
 
-        const std::vector< Use::Ptr >& uses( void ) const;
+        /**
+           an assignment would copy the use list head of the other user
+         */
+        User& operator=( const User& other ) = delete;
 
-        void setUse( User& user );
+        ~User( void );
 
-        void removeUse( const User& user );
+        UseList uses( void ) const;
 
         void replaceAllUsesWith( const Value::Ptr& value );
 
@@ -99,7 +196,9 @@ namespace libcasm_ir
         static u1 classof( Value const* obj );
 
       private:
-        std::vector< Use::Ptr > m_uses;
+        Use* m_uses;
+
+        friend class Use;
     };
 }
 
@@ -54,21 +54,41 @@
 #include "Value.h"
 #include "Visitor.h"
 
+#include <algorithm>
+#include <mutex>
+
 using namespace libcasm_ir;
 
 Value::Value( const Type::Ptr& type, const ID id )
 : m_type( type->id() )
 , m_id( id )
+, m_label( nullptr )
 {
 }
 
 Value::Value( const Type::ID type, const ID id )
 : m_type( type )
 , m_id( id )
+, m_label( nullptr )
 {
     assert( type.flavor() != 0 );
 }
 
+Value::Value( const Value& other )
+: std::enable_shared_from_this< Value >( other )
+, m_type( other.m_type )
+, m_id( other.m_id )
+, m_label( nullptr )
+{
+}
+
+Value& Value::operator=( const Value& other )
+{
+    m_type = other.m_type;
+    m_id = other.m_id;
+    return *this;
+}
+
 std::string Value::description( void ) const
 {
     return type().name() + " " + name();
@@ -135,10 +155,27 @@ std::string Value::dump( void ) const
     return tmp;
 }
 
-std::string Value::label( void ) const
+const std::string& Value::label( void ) const
+{
+    const auto cached = m_label.load( std::memory_order_acquire );
+    if( cached )
+    {
+        return *cached;
+    }
+
+    const auto& label = assignLabel();
+    m_label.store( &label, std::memory_order_release );
+    return label;
+}
+
+const std::string& Value::assignLabel( void ) const
 {
     static std::unordered_map< u8, u64 > cnt;
     static std::unordered_map< const Value*, std::string > lbl;
+    static std::mutex mtx;
+
+    // the returned references stay valid, because the map nodes are stable
+    std::lock_guard< std::mutex > lock( mtx );
 
     auto result = lbl.find( this );
     if( result != lbl.end() )
@@ -156,7 +193,7 @@ std::string Value::label( void ) const
 
         if( this->type().result().isVoid() )
         {
-            return name();
+            return lbl.emplace( this, name() ).first->second;
         }
 
         return lbl.emplace( this, "%r" + std::to_string( cnt[ INSTRUCTION ]++ ) ).first->second;
@@ -193,7 +230,7 @@ std::string Value::label( void ) const
     }
     else
     {
-        return "@" + name();
+        return lbl.emplace( this, "@" + name() ).first->second;
     }
 }
 
@@ -204,9 +241,102 @@ u1 Value::operator==( const Value& rhs ) const
 
 void Value::iterate( const Traversal order, std::function< void( Value& ) > action )
 {
-    TraversalVisitor visitor( order, action );
+    if( order == Traversal::PREORDER )
+    {
+        iterate< Traversal::PREORDER >( action );
+    }
+    else
+    {
+        iterate< Traversal::POSTORDER >( action );
+    }
+}
+
+void Value::expand( Value& value, TraversalStack& stack )
+{
+    const auto begin = stack.size();
+
+    const auto push = [&stack]( Value* child ) {
+        if( child )
+        {
+            stack.emplace_back( child, false );
+        }
+    };
+
+    switch( value.id() )
+    {
+        case Value::SPECIFICATION:
+        {
+            auto& specification = static_cast< Specification& >( value );
+            push( specification.agent().get() );
+            for( const auto& constant : specification.constants() )
+            {
+                push( constant.get() );
+            }
+            for( const auto& builtin : specification.builtins() )
+            {
+                push( builtin.get() );
+            }
+            for( const auto& function : specification.functions() )
+            {
+                push( function.get() );
+            }
+            for( const auto& derived : specification.deriveds() )
+            {
+                push( derived.get() );
+            }
+            for( const auto& rule : specification.rules() )
+            {
+                push( rule.get() );
+            }
+            break;
+        }
+        case Value::DERIVED:
+        {
+            push( static_cast< Derived& >( value ).context().get() );
+            break;
+        }
+        case Value::RULE:
+        {
+            push( static_cast< Rule& >( value ).context().get() );
+            break;
+        }
+        case Value::PARALLEL_BLOCK:  // [fallthrough]
+        case Value::SEQUENTIAL_BLOCK:
+        {
+            auto& block = static_cast< ExecutionSemanticsBlock& >( value );
+            push( block.entry().get() );
+            for( const auto& child : block.blocks() )
+            {
+                push( child.get() );
+            }
+            push( block.exit().get() );
+            break;
+        }
+        case Value::TRIVIAL_STATEMENT:  // [fallthrough]
+        case Value::BRANCH_STATEMENT:   // [fallthrough]
+        case Value::FORALL_STATEMENT:
+        {
+            auto& statement = static_cast< Statement& >( value );
+            for( const auto& instruction : statement.instructions() )
+            {
+                push( instruction.get() );
+            }
+            if( value.id() != Value::TRIVIAL_STATEMENT )
+            {
+                for( const auto& child : statement.blocks() )
+                {
+                    push( child.get() );
+                }
+            }
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
 
-    accept( visitor );
+    std::reverse( stack.begin() + begin, stack.end() );
 }
 
 std::string Value::token( const Value::ID id )
@@ -287,6 +417,10 @@ std::string Value::token( const Value::ID id )
         {
             return "BranchStatement";
         }
+        case Value::FORALL_STATEMENT:
+        {
+            return "ForallStatement";
+        }
 
         case Value::CONSTANT:
         {
@@ -56,7 +56,10 @@
 #include <libstdhl/Memory>
 #include <libstdhl/Variadic>
 
+#include <atomic>
 #include <sstream>
+#include <type_traits>
+#include <vector>
 
 namespace libcasm_ir
 {
@@ -93,6 +96,7 @@ namespace libcasm_ir
             STATEMENT,
             TRIVIAL_STATEMENT,
             BRANCH_STATEMENT,
+            FORALL_STATEMENT,
 
             CONSTANT,
             VOID_CONSTANT,
@@ -232,6 +236,13 @@ namespace libcasm_ir
 
         Value( const Type::ID type, const ID id );
 
+        /**
+           a copied value has its own label
+         */
+        Value( const Value& other );
+
+        Value& operator=( const Value& other );
+
         virtual ~Value( void ) = default;
 
         virtual std::string name( void ) const = 0;
@@ -246,7 +257,12 @@ namespace libcasm_ir
 
         std::string dump( void ) const;
 
-        std::string label( void ) const;
+        /**
+           @return label of the value, it is assigned on first request and
+           stays valid for the lifetime of the process, labels can be
+           requested concurrently and an assigned label is read lock-free
+         */
+        const std::string& label( void ) const;
 
         virtual std::size_t hash( void ) const = 0;
 
@@ -260,6 +276,51 @@ namespace libcasm_ir
         virtual void iterate(
             const Traversal order, std::function< void( Value& ) > callback ) final;
 
+        /**
+           iterates the same values in the same order as the TraversalVisitor,
+           but uses an explicit stack and calls the callback directly, the
+           callback is either a `void( Value& )` or a `u1( Value& )` function
+           object where returning false terminates the traversal, the
+           callback shall not release values which are still to be visited
+
+           @return false if the traversal was terminated by the callback
+         */
+        template < Traversal Order, typename F >
+        u1 iterate( F&& callback )
+        {
+            TraversalStack stack;
+            stack.reserve( 64 );
+            stack.emplace_back( this, false );
+
+            while( not stack.empty() )
+            {
+                auto& top = stack.back();
+                auto& value = *top.first;
+
+                if( Order == Traversal::PREORDER or top.second )
+                {
+                    stack.pop_back();
+
+                    if( not invoke( callback, value ) )
+                    {
+                        return false;
+                    }
+
+                    if( Order == Traversal::PREORDER )
+                    {
+                        expand( value, stack );
+                    }
+                }
+                else
+                {
+                    top.second = true;
+                    expand( value, stack );
+                }
+            }
+
+            return true;
+        }
+
         virtual void accept( Visitor& visitor ) = 0;
 
       protected:
@@ -276,10 +337,44 @@ namespace libcasm_ir
         }
 
       private:
+        using TraversalStack = std::vector< std::pair< Value*, u1 > >;
+
+        /**
+           pushes the children of a value in reverse order onto the stack
+         */
+        static void expand( Value& value, TraversalStack& stack );
+
+        /**
+           looks up or numbers the label of this value in the process-wide
+           label table
+         */
+        const std::string& assignLabel( void ) const;
+
+        template < typename F >
+        static inline typename std::enable_if<
+            std::is_void< typename std::result_of< F&( Value& ) >::type >::value,
+            u1 >::type
+        invoke( F& callback, Value& value )
+        {
+            callback( value );
+            return true;
+        }
+
+        template < typename F >
+        static inline typename std::enable_if<
+            not std::is_void< typename std::result_of< F&( Value& ) >::type >::value,
+            u1 >::type
+        invoke( F& callback, Value& value )
+        {
+            return callback( value );
+        }
+
         Type::ID m_type;
 
         ID m_id;
 
+        mutable std::atomic< const std::string* > m_label;
+
       public:
         /**
            encodes the Value::ID to a human readable std::string
@@ -110,6 +110,11 @@ void RecursiveVisitor::visit( BranchStatement& value )
     value.instructions().accept( *this );
     value.blocks().accept( *this );
 }
+void RecursiveVisitor::visit( ForallStatement& value )
+{
+    value.instructions().accept( *this );
+    value.blocks().accept( *this );
+}
 
 //
 // TraversalVisitor
@@ -269,6 +274,21 @@ void TraversalVisitor::visit( BranchStatement& value )
         callback()( value );
     }
 }
+void TraversalVisitor::visit( ForallStatement& value )
+{
+    if( order() == PREORDER )
+    {
+        callback()( value );
+    }
+
+    value.instructions().accept( *this );
+    value.blocks().accept( *this );
+
+    if( order() == POSTORDER )
+    {
+        callback()( value );
+    }
+}
 
 void TraversalVisitor::visit( SkipInstruction& value )
 {
@@ -65,6 +65,7 @@ namespace libcasm_ir
 
     class TrivialStatement;
     class BranchStatement;
+    class ForallStatement;
 
     class SkipInstruction;
 
@@ -152,6 +153,7 @@ namespace libcasm_ir
 
         virtual void visit( TrivialStatement& value ) = 0;
         virtual void visit( BranchStatement& value ) = 0;
+        virtual void visit( ForallStatement& value ) = 0;
 
         //
         // Instructions
@@ -239,6 +241,7 @@ namespace libcasm_ir
 
         void visit( TrivialStatement& value ) override;
         void visit( BranchStatement& value ) override;
+        void visit( ForallStatement& value ) override;
 
         //
         // Instructions
@@ -338,6 +341,7 @@ namespace libcasm_ir
 
         void visit( TrivialStatement& value ) override;
         void visit( BranchStatement& value ) override;
+        void visit( ForallStatement& value ) override;
 
         //
         // Instructions
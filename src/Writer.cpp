@@ -0,0 +1,249 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "Writer.h"
+
+#include <cassert>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace libcasm_ir;
+
+Writer::Writer( std::ostream& stream, const std::size_t capacity )
+: m_target( Target::STREAM )
+, m_stream( &stream )
+, m_descriptor( -1 )
+, m_owned( false )
+, m_string( nullptr )
+, m_buffer( capacity > 0 ? capacity : 1 )
+, m_size( 0 )
+{
+}
+
+Writer::Writer( const int descriptor, const std::size_t capacity )
+: m_target( Target::DESCRIPTOR )
+, m_stream( nullptr )
+, m_descriptor( descriptor )
+, m_owned( false )
+, m_string( nullptr )
+, m_buffer( capacity > 0 ? capacity : 1 )
+, m_size( 0 )
+{
+    assert( m_descriptor >= 0 );
+}
+
+Writer::Writer( std::string& buffer, const std::size_t capacity )
+: m_target( Target::STRING )
+, m_stream( nullptr )
+, m_descriptor( -1 )
+, m_owned( false )
+, m_string( &buffer )
+, m_buffer( capacity > 0 ? capacity : 1 )
+, m_size( 0 )
+{
+}
+
+std::unique_ptr< Writer > Writer::file( const std::string& path, const std::size_t capacity )
+{
+    const auto descriptor = ::open( path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+    if( descriptor < 0 )
+    {
+        throw std::domain_error(
+            "unable to open '" + path + "': " + std::string( std::strerror( errno ) ) );
+    }
+
+    auto writer = std::make_unique< Writer >( descriptor, capacity );
+    writer->m_owned = true;
+    return writer;
+}
+
+Writer::~Writer( void )
+{
+    try
+    {
+        flush();
+    }
+    catch( ... )
+    {
+        // a destructor shall not throw, the error was already reported
+        // by the target stream or is lost together with the writer
+    }
+
+    if( m_owned )
+    {
+        ::close( m_descriptor );
+    }
+}
+
+void Writer::write( const char* data, const std::size_t size )
+{
+    if( m_size + size > m_buffer.size() )
+    {
+        drain();
+
+        if( size >= m_buffer.size() )
+        {
+            // large blocks are handed over directly to the target
+            emit( data, size );
+            return;
+        }
+    }
+
+    std::memcpy( m_buffer.data() + m_size, data, size );
+    m_size += size;
+}
+
+void Writer::flush( void )
+{
+    drain();
+
+    if( m_target == Target::STREAM )
+    {
+        m_stream->flush();
+    }
+}
+
+Writer& Writer::operator<<( const char* text )
+{
+    write( text, std::strlen( text ) );
+    return *this;
+}
+
+Writer& Writer::operator<<( const void* pointer )
+{
+    auto value = reinterpret_cast< std::uintptr_t >( pointer );
+
+    if( value == 0 )
+    {
+        // same representation as the output stream of a null pointer
+        return *this << '0';
+    }
+
+    char digits[ 2 + 2 * sizeof( std::uintptr_t ) ];
+    auto position = sizeof( digits );
+
+    while( value != 0 )
+    {
+        digits[ --position ] = "0123456789abcdef"[ value & 0xf ];
+        value >>= 4;
+    }
+    digits[ --position ] = 'x';
+    digits[ --position ] = '0';
+
+    write( &digits[ position ], sizeof( digits ) - position );
+    return *this;
+}
+
+void Writer::writeDecimal( u64 value )
+{
+    char digits[ 20 ];
+    auto position = sizeof( digits );
+
+    do
+    {
+        digits[ --position ] = '0' + ( value % 10 );
+        value /= 10;
+    } while( value != 0 );
+
+    write( &digits[ position ], sizeof( digits ) - position );
+}
+
+void Writer::drain( void )
+{
+    if( m_size > 0 )
+    {
+        const auto size = m_size;
+        m_size = 0;
+        emit( m_buffer.data(), size );
+    }
+}
+
+void Writer::emit( const char* data, const std::size_t size )
+{
+    switch( m_target )
+    {
+        case Target::STREAM:
+        {
+            m_stream->write( data, size );
+            break;
+        }
+        case Target::DESCRIPTOR:
+        {
+            std::size_t offset = 0;
+            while( offset < size )
+            {
+                const auto result = ::write( m_descriptor, data + offset, size - offset );
+                if( result < 0 )
+                {
+                    if( errno == EINTR )
+                    {
+                        continue;
+                    }
+
+                    throw std::domain_error(
+                        "unable to write: " + std::string( std::strerror( errno ) ) );
+                }
+                offset += result;
+            }
+            break;
+        }
+        case Target::STRING:
+        {
+            m_string->append( data, size );
+            break;
+        }
+    }
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
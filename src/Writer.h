@@ -0,0 +1,190 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#ifndef _LIBCASM_IR_WRITER_H_
+#define _LIBCASM_IR_WRITER_H_
+
+#include <libcasm-ir/CasmIR>
+
+#include <memory>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace libcasm_ir
+{
+    /**
+       @brief buffered output writer
+
+       A writer collects the written characters in a large buffer and hands
+       them over to its target (an output stream, a file descriptor, a file
+       or a string) only if the buffer is full, on an explicit flush or on
+       destruction. Integers and pointers are rendered directly into the
+       buffer in the same representation as an output stream would use.
+    */
+    class Writer final
+    {
+      public:
+        using Ptr = std::shared_ptr< Writer >;
+
+        static constexpr std::size_t DEFAULT_CAPACITY = 64 * 1024;
+
+        explicit Writer( std::ostream& stream, const std::size_t capacity = DEFAULT_CAPACITY );
+
+        /**
+           writes to an already opened file descriptor, the descriptor is not
+           closed by the writer
+        */
+        explicit Writer( const int descriptor, const std::size_t capacity = DEFAULT_CAPACITY );
+
+        /**
+           appends to the given string, the string shall outlive the writer
+        */
+        explicit Writer( std::string& buffer, const std::size_t capacity = DEFAULT_CAPACITY );
+
+        /**
+           creates or truncates the file at the given path, throws an
+           std::domain_error if the file cannot be opened
+        */
+        static std::unique_ptr< Writer > file(
+            const std::string& path, const std::size_t capacity = DEFAULT_CAPACITY );
+
+        Writer( const Writer& other ) = delete;
+
+        Writer& operator=( const Writer& other ) = delete;
+
+        ~Writer( void );
+
+        void write( const char* data, const std::size_t size );
+
+        void flush( void );
+
+        Writer& operator<<( const char character )
+        {
+            if( m_size == m_buffer.size() )
+            {
+                drain();
+            }
+
+            m_buffer[ m_size++ ] = character;
+            return *this;
+        }
+
+        Writer& operator<<( const char* text );
+
+        Writer& operator<<( const std::string& text )
+        {
+            write( text.data(), text.size() );
+            return *this;
+        }
+
+        Writer& operator<<( const void* pointer );
+
+        template < typename T >
+        typename std::enable_if<
+            not std::is_same< typename std::remove_cv< T >::type, char >::value,
+            Writer& >::type
+        operator<<( T* pointer )
+        {
+            return *this << static_cast< const void* >( pointer );
+        }
+
+        /**
+           integers are written in decimal representation, character types
+           are written as characters like in an output stream
+        */
+        template < typename T >
+        typename std::enable_if<
+            std::is_integral< T >::value and ( sizeof( T ) > 1 ) and
+                not std::is_same< T, bool >::value,
+            Writer& >::type
+        operator<<( const T value )
+        {
+            if( std::is_signed< T >::value and value < 0 )
+            {
+                *this << '-';
+                writeDecimal( ~static_cast< u64 >( value ) + 1 );
+            }
+            else
+            {
+                writeDecimal( static_cast< u64 >( value ) );
+            }
+            return *this;
+        }
+
+      private:
+        enum class Target
+        {
+            STREAM,
+            DESCRIPTOR,
+            STRING
+        };
+
+        void writeDecimal( u64 value );
+
+        void drain( void );
+
+        void emit( const char* data, const std::size_t size );
+
+        Target m_target;
+
+        std::ostream* m_stream;
+        int m_descriptor;
+        u1 m_owned;
+        std::string* m_string;
+
+        std::vector< char > m_buffer;
+        std::size_t m_size;
+    };
+}
+
+#endif  // _LIBCASM_IR_WRITER_H_
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -227,6 +227,60 @@ void ConsistencyCheckVisitor::visit( BranchStatement& value )
 
     RecursiveVisitor::visit( value );
 }
+void ConsistencyCheckVisitor::visit( ForallStatement& value )
+{
+    verify< ForallStatement >( value );
+
+    if( not value.variable() )
+    {
+        m_log.error( "forall '%p' %s: has no variable", &value, value.dump().c_str() );
+        m_err++;
+    }
+
+    const auto& domain = value.domain();
+    if( not domain )
+    {
+        m_log.error( "forall '%p' %s: has no domain", &value, value.dump().c_str() );
+        m_err++;
+    }
+    else if( const auto instr = cast< Instruction >( domain ) )
+    {
+        // the domain is a use of its instruction, which may be shared with
+        // a preceding statement after the elimination passes
+        if( not instr->statement() )
+        {
+            m_log.error(
+                "forall '%p' %s: domain '%s' is not computed by a statement",
+                &value,
+                value.dump().c_str(),
+                instr->dump().c_str() );
+            m_err++;
+        }
+    }
+    else if( not isa< Constant >( domain ) )
+    {
+        m_log.error(
+            "forall '%p' %s: domain '%s' is neither a constant nor an instruction",
+            &value,
+            value.dump().c_str(),
+            domain->dump().c_str() );
+        m_err++;
+    }
+
+    if( value.blocks().size() != 1 )
+    {
+        m_log.error(
+            "forall '%p' %s: shall contain exactly 1 body block", &value, value.dump().c_str() );
+        m_err++;
+    }
+
+    if( errors() > 0 )
+    {
+        return;
+    }
+
+    RecursiveVisitor::visit( value );
+}
 
 //
 // Instructions
@@ -479,7 +533,9 @@ void ConsistencyCheckVisitor::verify( Value& value )
             m_err++;
         }
 
-        if( v->instructions().size() < 1 )
+        // the domain of a forall statement can be a constant or computed by
+        // a preceding statement which requires no instruction to compute it
+        if( v->instructions().size() < 1 and not isa< ForallStatement >( v ) )
         {
             m_log.error(
                 "stmt '%p' %s: shall contain at least 1 instruction", v, v->dump().c_str() );
@@ -109,6 +109,7 @@ namespace libcasm_ir
 
         void visit( TrivialStatement& value ) override;
         void visit( BranchStatement& value ) override;
+        void visit( ForallStatement& value ) override;
 
         //
         // Instructions
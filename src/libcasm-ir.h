@@ -44,33 +44,49 @@
 
 #include <libcasm-ir/Agent>
 #include <libcasm-ir/Annotation>
+#include <libcasm-ir/Arena>
 #include <libcasm-ir/Block>
 #include <libcasm-ir/Builtin>
 #include <libcasm-ir/CasmIR>
 #include <libcasm-ir/Constant>
 #include <libcasm-ir/Derived>
+#include <libcasm-ir/DomainCursor>
 #include <libcasm-ir/Enumeration>
 #include <libcasm-ir/Exception>
 #include <libcasm-ir/Function>
 #include <libcasm-ir/Instruction>
 #include <libcasm-ir/List>
+#include <libcasm-ir/MemoTable>
 #include <libcasm-ir/Operation>
+#include <libcasm-ir/OutputSink>
+#include <libcasm-ir/Profile>
+#include <libcasm-ir/RandomStream>
 #include <libcasm-ir/Range>
 #include <libcasm-ir/Rule>
 #include <libcasm-ir/Specification>
 #include <libcasm-ir/Statement>
+#include <libcasm-ir/ThreadScope>
 #include <libcasm-ir/Type>
 #include <libcasm-ir/User>
 #include <libcasm-ir/Value>
 #include <libcasm-ir/Version>
 #include <libcasm-ir/Visitor>
+#include <libcasm-ir/Writer>
 
 #include <libcasm-ir/analyze/ConsistencyCheckPass>
 #include <libcasm-ir/analyze/IRDumpDebugPass>
 
 #include <libcasm-ir/transform/BranchEliminationPass>
+#include <libcasm-ir/transform/CommonSubexpressionEliminationPass>
+#include <libcasm-ir/transform/DeadCodeEliminationPass>
+#include <libcasm-ir/transform/DerivedInliningPass>
+#include <libcasm-ir/transform/IRDeserializePass>
+#include <libcasm-ir/transform/IRDump>
 #include <libcasm-ir/transform/IRDumpDotPass>
 #include <libcasm-ir/transform/IRDumpSourcePass>
+#include <libcasm-ir/transform/IRSerializePass>
+#include <libcasm-ir/transform/RuleSpecializationPass>
+#include <libcasm-ir/transform/StateAccessEliminationPass>
 
 namespace libcasm_ir
 {
@@ -67,6 +67,7 @@ u1 BranchEliminationPass::run( libpass::PassResult& pr )
 
     const auto& data = pr.input< ConsistencyCheckPass >();
     const auto& specification = data->specification();
+    const Arena::Scope scope( specification->arena() ? specification->arena() : Arena::active() );
 
     for( auto rule : specification->rules() )
     {
@@ -80,55 +81,63 @@ u64 BranchEliminationPass::optimize( Rule::Ptr& rule )
 {
     libpass::PassLogger log( &id, stream() );
 
-    u64 elimination = 0;
+    // a replacement releases values which are still pending in the
+    // traversal, therefore the replacements are collected in one traversal
+    // and applied afterwards, in post-order a nested select is replaced
+    // before its enclosing one
+    std::vector< std::pair< Statement::Ptr, Block::Ptr > > replacements;
 
-    rule->iterate( Traversal::POSTORDER, [&log, &elimination]( Value& value ) {
-        if( isa< SelectInstruction >( value ) )
+    rule->iterate< Traversal::POSTORDER >( [&log, &replacements]( Value& value ) {
+        if( not isa< SelectInstruction >( value ) )
         {
-            const auto instr = static_cast< SelectInstruction& >( value );
+            return;
+        }
 
-            log.info( instr.dump() );
+        auto& instr = static_cast< SelectInstruction& >( value );
 
-            const auto lhs = instr.operand( 0 );
+        log.info( instr.dump() );
 
-            if( isa< Constant >( lhs ) )
-            {
-                log.info( "    * lhs is constant" );
+        const auto lhs = instr.operand( 0 );
 
-                for( std::size_t c = 1; c < instr.operands().size(); c += 2 )
-                {
-                    const auto rhs = instr.operand( c );
+        if( not isa< Constant >( lhs ) )
+        {
+            return;
+        }
 
-                    if( *lhs == *rhs )
-                    {
-                        // found constant block branch
-                        const auto lbl = instr.operand( c + 1 );
-                        assert( isa< ExecutionSemanticsBlock >( lbl ) );
+        log.info( "    * lhs is constant" );
 
-                        log.info(
-                            "    * lhs == rhs (op" + std::to_string( c ) + ") -> " + lbl->label() );
+        for( std::size_t c = 1; c < instr.operands().size(); c += 2 )
+        {
+            const auto rhs = instr.operand( c );
 
-                        instr.statement()->replaceWith(
-                            std::static_pointer_cast< ExecutionSemanticsBlock >( lbl ) );
+            if( *lhs == *rhs )
+            {
+                // found constant block branch
+                const auto lbl = instr.operand( c + 1 );
+                assert( isa< ExecutionSemanticsBlock >( lbl ) );
 
-                        elimination++;
+                log.info( "    * lhs == rhs (op" + std::to_string( c ) + ") -> " + lbl->label() );
 
-                        return;
-                    }
-                }
+                replacements.emplace_back(
+                    instr.statement(), std::static_pointer_cast< ExecutionSemanticsBlock >( lbl ) );
+                return;
+            }
+        }
 
-                log.info( "    * rhs not in select -> skip" );
+        log.info( "    * rhs not in select -> skip" );
 
-                auto stmt = libstdhl::Memory::make< TrivialStatement >();
-                stmt->add< SkipInstruction >();
+        auto stmt = Arena::make< TrivialStatement >();
+        stmt->add< SkipInstruction >();
 
-                instr.statement()->replaceWith( stmt );
-                elimination++;
-            }
-        }
+        replacements.emplace_back( instr.statement(), stmt );
     } );
 
-    return elimination;
+    for( const auto& replacement : replacements )
+    {
+        replacement.first->replaceWith( replacement.second );
+    }
+
+    return replacements.size();
 }
 
 //
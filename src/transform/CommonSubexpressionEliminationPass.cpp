@@ -0,0 +1,377 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "CommonSubexpressionEliminationPass.h"
+
+#include <libcasm-ir/Annotation>
+#include <libcasm-ir/Builtin>
+#include <libcasm-ir/Constant>
+#include <libcasm-ir/Specification>
+#include <libcasm-ir/analyze/ConsistencyCheckPass>
+
+#include <libpass/PassLogger>
+#include <libpass/PassRegistry>
+#include <libpass/PassResult>
+#include <libpass/PassUsage>
+
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace libcasm_ir;
+
+char CommonSubexpressionEliminationPass::id = 0;
+
+static libpass::PassRegistration< CommonSubexpressionEliminationPass > PASS(
+    "IRCommonSubexpressionEliminationPass",
+    "removes recomputations of pure instructions",
+    "ir-cse",
+    0 );
+
+namespace
+{
+    /**
+       scoped table of the available pure instructions, the insertions are
+       logged and can be rolled back to a previous mark
+     */
+    class ValueTable
+    {
+      public:
+        /**
+           @return an available instruction which computes the same value
+           or a null pointer if the instruction was inserted as available
+         */
+        Instruction* insert( Instruction& instruction )
+        {
+            const auto key = hash( instruction );
+
+            const auto range = m_table.equal_range( key );
+            for( auto it = range.first; it != range.second; ++it )
+            {
+                if( equal( *it->second, instruction ) )
+                {
+                    return it->second;
+                }
+            }
+
+            m_table.emplace( key, &instruction );
+            m_log.emplace_back( key, &instruction );
+            return nullptr;
+        }
+
+        std::size_t mark( void ) const
+        {
+            return m_log.size();
+        }
+
+        void rollback( const std::size_t mark )
+        {
+            while( m_log.size() > mark )
+            {
+                const auto& entry = m_log.back();
+
+                const auto range = m_table.equal_range( entry.first );
+                for( auto it = range.first; it != range.second; ++it )
+                {
+                    if( it->second == entry.second )
+                    {
+                        m_table.erase( it );
+                        break;
+                    }
+                }
+
+                m_log.pop_back();
+            }
+        }
+
+      private:
+        /**
+           identifiers (forall variables and rule parameters) and symbolic
+           constants are only equal to themselves
+         */
+        static u1 literal( const Value& value )
+        {
+            return isa< Constant >( value ) and not isa< Identifier >( value ) and
+                   not isa< SymbolicConstant >( value );
+        }
+
+        static std::size_t hash( const Value& operand )
+        {
+            if( literal( operand ) )
+            {
+                return operand.hash();
+            }
+
+            return std::hash< const Value* >()( &operand );
+        }
+
+        static std::size_t hash( const Instruction& instruction )
+        {
+            std::size_t h = instruction.id();
+
+            for( const auto& operand : instruction.operands() )
+            {
+                h = libstdhl::Hash::combine( h, hash( *operand ) );
+            }
+
+            return h;
+        }
+
+        static u1 equal( const Instruction& lhs, const Instruction& rhs )
+        {
+            if( lhs.id() != rhs.id() or lhs.operands().size() != rhs.operands().size() or
+                not( lhs.type() == rhs.type() ) )
+            {
+                return false;
+            }
+
+            for( std::size_t c = 0; c < lhs.operands().size(); c++ )
+            {
+                const auto& a = *lhs.operands()[ c ];
+                const auto& b = *rhs.operands()[ c ];
+
+                if( &a == &b )
+                {
+                    continue;
+                }
+
+                if( not literal( a ) or not literal( b ) or not( a == b ) )
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        std::unordered_multimap< std::size_t, Instruction* > m_table;
+        std::vector< std::pair< std::size_t, Instruction* > > m_log;
+    };
+
+    class Elimination
+    {
+      public:
+        Elimination( void )
+        : m_table()
+        , m_pure()
+        , m_count( 0 )
+        {
+        }
+
+        u64 count( void ) const
+        {
+            return m_count;
+        }
+
+        void eliminate( ExecutionSemanticsBlock& block )
+        {
+            const auto mark = m_table.mark();
+
+            if( block.entry() )
+            {
+                eliminate( *block.entry() );
+            }
+
+            for( const auto& child : block.blocks() )
+            {
+                // only the children of a sequential block dominate their
+                // successors, the children of a parallel block are independent
+                const auto scope = m_table.mark();
+
+                if( isa< ExecutionSemanticsBlock >( child ) )
+                {
+                    eliminate( static_cast< ExecutionSemanticsBlock& >( *child ) );
+                }
+                else if( isa< Statement >( child ) )
+                {
+                    eliminate( static_cast< Statement& >( *child ) );
+                }
+
+                if( block.parallel() )
+                {
+                    m_table.rollback( scope );
+                }
+            }
+
+            if( block.exit() )
+            {
+                eliminate( *block.exit() );
+            }
+
+            m_table.rollback( mark );
+        }
+
+        void eliminate( Statement& statement )
+        {
+            std::unordered_set< const Instruction* > redundant;
+
+            for( const auto& instruction : statement.instructions() )
+            {
+                if( not pure( *instruction ) )
+                {
+                    continue;
+                }
+
+                if( const auto available = m_table.insert( *instruction ) )
+                {
+                    instruction->replaceAllUsesWith( available->ptr_this< Instruction >() );
+                    redundant.emplace( instruction.get() );
+                }
+            }
+
+            if( not redundant.empty() )
+            {
+                m_count += redundant.size();
+
+                statement.remove( [&redundant]( const Instruction& instruction ) {
+                    return redundant.count( &instruction ) > 0;
+                } );
+            }
+
+            for( const auto& block : statement.blocks() )
+            {
+                eliminate( *block );
+            }
+        }
+
+      private:
+        u1 pure( const Instruction& instruction )
+        {
+            if( isa< LocationInstruction >( instruction ) )
+            {
+                return true;
+            }
+
+            if( isa< OperatorInstruction >( instruction ) )
+            {
+                return pure( instruction.id() );
+            }
+
+            if( isa< CallInstruction >( instruction ) )
+            {
+                const auto& callee = instruction.operand( 0 );
+                return isa< Builtin >( callee ) and pure( callee->id() );
+            }
+
+            return false;
+        }
+
+        u1 pure( const Value::ID id )
+        {
+            auto result = m_pure.find( id );
+            if( result == m_pure.end() )
+            {
+                u1 value = false;
+
+                try
+                {
+                    const auto& properties = Annotation::find( id ).properties();
+                    value = properties.isSet( Property::PURE ) and
+                            properties.isSet( Property::SIDE_EFFECT_FREE );
+                }
+                catch( const std::domain_error& )
+                {
+                    // no annotation available, the instruction is kept
+                }
+
+                result = m_pure.emplace( id, value ).first;
+            }
+
+            return result->second;
+        }
+
+        ValueTable m_table;
+        std::unordered_map< u8, u1 > m_pure;
+        u64 m_count;
+    };
+}
+
+void CommonSubexpressionEliminationPass::usage( libpass::PassUsage& pu )
+{
+    pu.require< ConsistencyCheckPass >();
+}
+
+u1 CommonSubexpressionEliminationPass::run( libpass::PassResult& pr )
+{
+    libpass::PassLogger log( &id, stream() );
+
+    const auto& data = pr.input< ConsistencyCheckPass >();
+    const auto& specification = data->specification();
+
+    u64 elimination = 0;
+
+    for( const auto& derived : specification->deriveds() )
+    {
+        elimination += optimize( *derived );
+    }
+
+    for( const auto& rule : specification->rules() )
+    {
+        elimination += optimize( *rule );
+    }
+
+    log.info( "eliminated " + std::to_string( elimination ) + " instructions" );
+
+    return true;
+}
+
+u64 CommonSubexpressionEliminationPass::optimize( Rule& rule )
+{
+    Elimination elimination;
+    elimination.eliminate( *rule.context() );
+    return elimination.count();
+}
+
+u64 CommonSubexpressionEliminationPass::optimize( Derived& derived )
+{
+    Elimination elimination;
+    elimination.eliminate( *derived.context() );
+    return elimination.count();
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
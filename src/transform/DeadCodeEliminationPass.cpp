@@ -0,0 +1,461 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "DeadCodeEliminationPass.h"
+
+#include <libcasm-ir/Annotation>
+#include <libcasm-ir/Builtin>
+#include <libcasm-ir/Constant>
+#include <libcasm-ir/analyze/ConsistencyCheckPass>
+
+#include <libpass/PassLogger>
+#include <libpass/PassRegistry>
+#include <libpass/PassResult>
+#include <libpass/PassUsage>
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace libcasm_ir;
+
+char DeadCodeEliminationPass::id = 0;
+
+static libpass::PassRegistration< DeadCodeEliminationPass > PASS(
+    "IRDeadCodeEliminationPass",
+    "removes unused instructions and unreachable declarations",
+    "ir-dce",
+    0 );
+
+namespace
+{
+    /**
+       removes the unused instructions without side effects of a body, the
+       instructions are visited from the last to the first so that operands
+       which are only used by removed instructions are removed as well, the
+       result instruction of a derived is always kept
+     */
+    class InstructionElimination
+    {
+      public:
+        InstructionElimination( const Value* result = nullptr )
+        : m_result( result )
+        , m_effectFree()
+        , m_count( 0 )
+        {
+        }
+
+        u64 count( void ) const
+        {
+            return m_count;
+        }
+
+        void eliminate( ExecutionSemanticsBlock& block )
+        {
+            if( block.exit() )
+            {
+                eliminate( *block.exit() );
+            }
+
+            // a later statement may use the instructions of an earlier one,
+            // therefore the children are visited from the last to the first
+            std::vector< Block* > children;
+            children.reserve( block.blocks().size() );
+            for( const auto& child : block.blocks() )
+            {
+                children.emplace_back( child.get() );
+            }
+
+            for( auto it = children.rbegin(); it != children.rend(); ++it )
+            {
+                auto& child = **it;
+
+                if( isa< ExecutionSemanticsBlock >( child ) )
+                {
+                    eliminate( static_cast< ExecutionSemanticsBlock& >( child ) );
+                }
+                else if( isa< Statement >( child ) )
+                {
+                    eliminate( static_cast< Statement& >( child ) );
+                }
+            }
+
+            if( block.entry() )
+            {
+                eliminate( *block.entry() );
+            }
+        }
+
+        void eliminate( Statement& statement )
+        {
+            for( const auto& block : statement.blocks() )
+            {
+                eliminate( *block );
+            }
+
+            std::vector< Instruction* > instructions;
+            instructions.reserve( statement.instructions().size() );
+            for( const auto& instruction : statement.instructions() )
+            {
+                instructions.emplace_back( instruction.get() );
+            }
+
+            std::unordered_set< const Value* > unused;
+
+            for( auto it = instructions.rbegin(); it != instructions.rend(); ++it )
+            {
+                const auto& instruction = **it;
+
+                if( not removable( instruction ) )
+                {
+                    continue;
+                }
+
+                u1 used = false;
+                for( const auto& use : instruction.uses() )
+                {
+                    if( unused.count( &use.use() ) == 0 )
+                    {
+                        used = true;
+                        break;
+                    }
+                }
+
+                if( not used )
+                {
+                    unused.emplace( &instruction );
+                }
+            }
+
+            if( not unused.empty() )
+            {
+                m_count += unused.size();
+
+                statement.remove( [&unused]( const Instruction& instruction ) {
+                    return unused.count( &instruction ) > 0;
+                } );
+            }
+        }
+
+      private:
+        u1 removable( const Instruction& instruction )
+        {
+            if( &instruction == m_result )
+            {
+                return false;
+            }
+
+            switch( instruction.id() )
+            {
+                case Value::LOCATION_INSTRUCTION:  // [fallthrough]
+                case Value::LOOKUP_INSTRUCTION:    // [fallthrough]
+                case Value::SELF_INSTRUCTION:
+                {
+                    return true;
+                }
+                case Value::CALL_INSTRUCTION:
+                {
+                    const auto& callee = instruction.operand( 0 );
+                    if( isa< Derived >( callee ) )
+                    {
+                        return true;
+                    }
+                    return isa< Builtin >( callee ) and effectFree( callee->id() );
+                }
+                default:
+                {
+                    return isa< OperatorInstruction >( instruction ) and
+                           effectFree( instruction.id() );
+                }
+            }
+        }
+
+        u1 effectFree( const Value::ID id )
+        {
+            auto result = m_effectFree.find( id );
+            if( result == m_effectFree.end() )
+            {
+                u1 value = false;
+
+                try
+                {
+                    const auto& properties = Annotation::find( id ).properties();
+                    value = properties.isSet( Property::SIDE_EFFECT_FREE );
+                }
+                catch( const std::domain_error& )
+                {
+                    // no annotation available, the instruction is kept
+                }
+
+                result = m_effectFree.emplace( id, value ).first;
+            }
+
+            return result->second;
+        }
+
+        const Value* m_result;
+        std::unordered_map< u8, u1 > m_effectFree;
+        u64 m_count;
+    };
+
+    /**
+       marks all declarations which are reachable from the roots through the
+       bodies of the reached rules and deriveds
+     */
+    class Reachability
+    {
+      public:
+        Reachability( void )
+        : m_reached()
+        , m_pending()
+        {
+        }
+
+        /**
+           @return false if no root is a rule or derived
+         */
+        u1 reach( const std::vector< Value::Ptr >& roots )
+        {
+            for( const auto& root : roots )
+            {
+                mark( *root );
+            }
+
+            if( m_pending.empty() )
+            {
+                return false;
+            }
+
+            while( not m_pending.empty() )
+            {
+                auto& value = *m_pending.back();
+                m_pending.pop_back();
+
+                value.iterate< Traversal::PREORDER >( [this]( Value& child ) {
+                    if( isa< Instruction >( child ) )
+                    {
+                        for( const auto& operand :
+                             static_cast< Instruction& >( child ).operands() )
+                        {
+                            mark( *operand );
+                        }
+                    }
+                } );
+            }
+
+            return true;
+        }
+
+        u1 reached( const Value& value ) const
+        {
+            return m_reached.count( &value ) > 0;
+        }
+
+      private:
+        void mark( Value& value )
+        {
+            switch( value.id() )
+            {
+                case Value::RULE_REFERENCE_CONSTANT:
+                {
+                    const auto& constant = static_cast< RuleReferenceConstant& >( value );
+                    if( constant.defined() )
+                    {
+                        mark( *constant.value() );
+                    }
+                    break;
+                }
+                case Value::FUNCTION_REFERENCE_CONSTANT:
+                {
+                    const auto& constant = static_cast< FunctionReferenceConstant& >( value );
+                    if( constant.defined() )
+                    {
+                        mark( *constant.value() );
+                    }
+                    break;
+                }
+                case Value::RULE:  // [fallthrough]
+                case Value::DERIVED:
+                {
+                    if( m_reached.emplace( &value ).second )
+                    {
+                        m_pending.emplace_back( &value );
+                    }
+                    break;
+                }
+                default:
+                {
+                    if( isa< Function >( value ) or isa< Builtin >( value ) )
+                    {
+                        m_reached.emplace( &value );
+                    }
+                    break;
+                }
+            }
+        }
+
+        std::unordered_set< const Value* > m_reached;
+        std::vector< Value* > m_pending;
+    };
+}
+
+DeadCodeEliminationPass::DeadCodeEliminationPass( void )
+: m_roots()
+, m_functionRemoval( false )
+{
+}
+
+void DeadCodeEliminationPass::usage( libpass::PassUsage& pu )
+{
+    pu.require< ConsistencyCheckPass >();
+}
+
+u1 DeadCodeEliminationPass::run( libpass::PassResult& pr )
+{
+    libpass::PassLogger log( &id, stream() );
+
+    const auto& data = pr.input< ConsistencyCheckPass >();
+    const auto& specification = data->specification();
+
+    const auto elimination = optimize( *specification );
+
+    log.info( "eliminated " + std::to_string( elimination ) + " instructions and declarations" );
+
+    return true;
+}
+
+void DeadCodeEliminationPass::setRoots( const std::vector< Value::Ptr >& roots )
+{
+    m_roots = roots;
+}
+
+const std::vector< Value::Ptr >& DeadCodeEliminationPass::roots( void ) const
+{
+    return m_roots;
+}
+
+void DeadCodeEliminationPass::setFunctionRemoval( const u1 functionRemoval )
+{
+    m_functionRemoval = functionRemoval;
+}
+
+u1 DeadCodeEliminationPass::functionRemoval( void ) const
+{
+    return m_functionRemoval;
+}
+
+u64 DeadCodeEliminationPass::optimize( Specification& specification )
+{
+    u64 elimination = 0;
+
+    // removing unused instructions first drops the references of unused
+    // derived calls before the reachability is computed
+    for( const auto& derived : specification.deriveds() )
+    {
+        elimination += optimize( *derived );
+    }
+
+    for( const auto& rule : specification.rules() )
+    {
+        elimination += optimize( *rule );
+    }
+
+    auto roots = m_roots;
+    if( roots.empty() )
+    {
+        for( const auto& constant : specification.constants() )
+        {
+            if( isa< RuleReferenceConstant >( constant ) )
+            {
+                roots.emplace_back( constant );
+            }
+        }
+    }
+
+    Reachability reachability;
+    if( not reachability.reach( roots ) )
+    {
+        // without an entry point every declaration would be unreachable
+        return elimination;
+    }
+
+    const auto functionRemoval = m_functionRemoval;
+    specification.remove( [&reachability, &elimination, functionRemoval]( const Value& value ) {
+        if( isa< Constant >( value ) or reachability.reached( value ) or
+            ( isa< Function >( value ) and not functionRemoval ) )
+        {
+            return false;
+        }
+
+        elimination++;
+        return true;
+    } );
+
+    return elimination;
+}
+
+u64 DeadCodeEliminationPass::optimize( Rule& rule )
+{
+    InstructionElimination elimination;
+    elimination.eliminate( *rule.context() );
+    return elimination.count();
+}
+
+u64 DeadCodeEliminationPass::optimize( Derived& derived )
+{
+    auto& context = *derived.context();
+    const auto& instructions = context.instructions();
+
+    InstructionElimination elimination(
+        instructions.size() > 0 ? instructions.back().get() : nullptr );
+    elimination.eliminate( context );
+    return elimination.count();
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -0,0 +1,431 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "DerivedInliningPass.h"
+
+#include <libcasm-ir/Builtin>
+#include <libcasm-ir/Exception>
+#include <libcasm-ir/Instruction>
+#include <libcasm-ir/analyze/ConsistencyCheckPass>
+
+#include <libpass/PassLogger>
+#include <libpass/PassRegistry>
+#include <libpass/PassResult>
+#include <libpass/PassUsage>
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+using namespace libcasm_ir;
+
+char DerivedInliningPass::id = 0;
+
+const std::size_t DerivedInliningPass::THRESHOLD;
+
+static libpass::PassRegistration< DerivedInliningPass > PASS(
+    "IRDerivedInliningPass", "inlines small deriveds at their call sites", "ir-inline", 0 );
+
+namespace
+{
+    /**
+       copies the bodies of small deriveds into the statements which call
+       them, a derived is never inlined into itself
+     */
+    class DerivedInlining
+    {
+      public:
+        DerivedInlining( const Derived* self = nullptr )
+        : m_self( self )
+        , m_inlinable()
+        , m_count( 0 )
+        {
+        }
+
+        u64 count( void ) const
+        {
+            return m_count;
+        }
+
+        void inlineCalls( ExecutionSemanticsBlock& block )
+        {
+            if( block.entry() )
+            {
+                inlineCalls( *block.entry() );
+            }
+
+            for( const auto& child : block.blocks() )
+            {
+                if( isa< ExecutionSemanticsBlock >( child ) )
+                {
+                    inlineCalls( static_cast< ExecutionSemanticsBlock& >( *child ) );
+                }
+                else if( isa< Statement >( child ) )
+                {
+                    inlineCalls( static_cast< Statement& >( *child ) );
+                }
+            }
+
+            if( block.exit() )
+            {
+                inlineCalls( *block.exit() );
+            }
+        }
+
+        void inlineCalls( Statement& statement )
+        {
+            for( const auto& block : statement.blocks() )
+            {
+                inlineCalls( *block );
+            }
+
+            std::vector< Instruction::Ptr > instructions;
+            instructions.reserve( statement.instructions().size() );
+
+            u1 found = false;
+            for( const auto& instruction : statement.instructions() )
+            {
+                found |= ( callee( *instruction ) != nullptr );
+                instructions.emplace_back( instruction );
+            }
+
+            if( not found )
+            {
+                return;
+            }
+
+            // the instructions are added again in their order, the copied
+            // body of an inlined derived takes the place of its call
+            statement.remove( []( const Instruction& ) { return true; } );
+
+            for( const auto& instruction : instructions )
+            {
+                const auto derived = callee( *instruction );
+                if( not derived )
+                {
+                    statement.add( instruction );
+                    continue;
+                }
+
+                std::unordered_map< const Value*, Value::Ptr > copies;
+                Instruction::Ptr result = nullptr;
+
+                for( const auto& original : derived->context()->instructions() )
+                {
+                    std::vector< Value::Ptr > operands;
+                    operands.reserve( original->operands().size() );
+
+                    for( const auto& operand : original->operands() )
+                    {
+                        const auto copy = copies.find( operand.get() );
+                        operands.emplace_back( copy != copies.end() ? copy->second : operand );
+                    }
+
+                    result = clone( *original, operands );
+                    copies.emplace( original.get(), result );
+                    statement.add( result );
+                }
+
+                instruction->replaceAllUsesWith( result );
+                m_count++;
+            }
+        }
+
+      private:
+        /**
+           @return the derived called by 'instruction' if it can be inlined
+         */
+        Derived* callee( const Instruction& instruction )
+        {
+            if( not isa< CallInstruction >( instruction ) or instruction.operands().size() != 1 )
+            {
+                return nullptr;
+            }
+
+            const auto& value = instruction.operand( 0 );
+            if( not isa< Derived >( value ) or value.get() == m_self )
+            {
+                return nullptr;
+            }
+
+            auto& derived = static_cast< Derived& >( *value );
+            return inlinable( derived ) ? &derived : nullptr;
+        }
+
+        u1 inlinable( const Derived& derived )
+        {
+            auto result = m_inlinable.find( &derived );
+            if( result != m_inlinable.end() )
+            {
+                return result->second;
+            }
+
+            u1 value = false;
+            const auto& context = derived.context();
+            const auto& relation = static_cast< const RelationType& >( derived.type() );
+
+            if( context and isa< TrivialStatement >( context ) and context->blocks().empty() and
+                relation.arguments().size() == 0 and context->instructions().size() > 0 and
+                context->instructions().size() <= DerivedInliningPass::THRESHOLD )
+            {
+                value = true;
+                for( const auto& instruction : context->instructions() )
+                {
+                    if( not cloneable( *instruction ) )
+                    {
+                        value = false;
+                        break;
+                    }
+                }
+            }
+
+            m_inlinable.emplace( &derived, value );
+            return value;
+        }
+
+        static u1 cloneable( const Instruction& instruction )
+        {
+            switch( instruction.id() )
+            {
+                case Value::CALL_INSTRUCTION:
+                {
+                    const auto& callee = instruction.operand( 0 );
+                    return isa< Builtin >( callee ) or isa< Derived >( callee );
+                }
+                case Value::LOOKUP_INSTRUCTION:    // [fallthrough]
+                case Value::LOCATION_INSTRUCTION:  // [fallthrough]
+                case Value::INV_INSTRUCTION:       // [fallthrough]
+                case Value::ADD_INSTRUCTION:       // [fallthrough]
+                case Value::SUB_INSTRUCTION:       // [fallthrough]
+                case Value::MUL_INSTRUCTION:       // [fallthrough]
+                case Value::DIV_INSTRUCTION:       // [fallthrough]
+                case Value::POW_INSTRUCTION:       // [fallthrough]
+                case Value::MOD_INSTRUCTION:       // [fallthrough]
+                case Value::EQU_INSTRUCTION:       // [fallthrough]
+                case Value::NEQ_INSTRUCTION:       // [fallthrough]
+                case Value::LTH_INSTRUCTION:       // [fallthrough]
+                case Value::LEQ_INSTRUCTION:       // [fallthrough]
+                case Value::GTH_INSTRUCTION:       // [fallthrough]
+                case Value::GEQ_INSTRUCTION:       // [fallthrough]
+                case Value::OR_INSTRUCTION:        // [fallthrough]
+                case Value::XOR_INSTRUCTION:       // [fallthrough]
+                case Value::AND_INSTRUCTION:       // [fallthrough]
+                case Value::IMP_INSTRUCTION:       // [fallthrough]
+                case Value::NOT_INSTRUCTION:
+                {
+                    return true;
+                }
+                default:
+                {
+                    return false;
+                }
+            }
+        }
+
+        static Instruction::Ptr clone(
+            const Instruction& instruction, const std::vector< Value::Ptr >& operands )
+        {
+            const std::vector< Value::Ptr > arguments(
+                operands.begin() + std::min< std::size_t >( 1, operands.size() ), operands.end() );
+
+            switch( instruction.id() )
+            {
+                case Value::CALL_INSTRUCTION:
+                {
+                    return Arena::make< CallInstruction >( operands[ 0 ], arguments );
+                }
+                case Value::LOOKUP_INSTRUCTION:
+                {
+                    return Arena::make< LookupInstruction >( operands[ 0 ] );
+                }
+                case Value::LOCATION_INSTRUCTION:
+                {
+                    return Arena::make< LocationInstruction >( operands[ 0 ], arguments );
+                }
+                case Value::INV_INSTRUCTION:
+                {
+                    return Arena::make< InvInstruction >( operands[ 0 ] );
+                }
+                case Value::ADD_INSTRUCTION:
+                {
+                    return Arena::make< AddInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::SUB_INSTRUCTION:
+                {
+                    return Arena::make< SubInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::MUL_INSTRUCTION:
+                {
+                    return Arena::make< MulInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::DIV_INSTRUCTION:
+                {
+                    return Arena::make< DivInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::POW_INSTRUCTION:
+                {
+                    return Arena::make< PowInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::MOD_INSTRUCTION:
+                {
+                    return Arena::make< ModInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::EQU_INSTRUCTION:
+                {
+                    return Arena::make< EquInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::NEQ_INSTRUCTION:
+                {
+                    return Arena::make< NeqInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::LTH_INSTRUCTION:
+                {
+                    return Arena::make< LthInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::LEQ_INSTRUCTION:
+                {
+                    return Arena::make< LeqInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::GTH_INSTRUCTION:
+                {
+                    return Arena::make< GthInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::GEQ_INSTRUCTION:
+                {
+                    return Arena::make< GeqInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::OR_INSTRUCTION:
+                {
+                    return Arena::make< OrInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::XOR_INSTRUCTION:
+                {
+                    return Arena::make< XorInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::AND_INSTRUCTION:
+                {
+                    return Arena::make< AndInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::IMP_INSTRUCTION:
+                {
+                    return Arena::make< ImpInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::NOT_INSTRUCTION:
+                {
+                    return Arena::make< NotInstruction >( operands[ 0 ] );
+                }
+                default:
+                {
+                    break;
+                }
+            }
+
+            throw InternalException(
+                "unable to inline instruction '" + instruction.description() + "'" );
+        }
+
+        const Derived* m_self;
+        std::unordered_map< const Derived*, u1 > m_inlinable;
+        u64 m_count;
+    };
+}
+
+void DerivedInliningPass::usage( libpass::PassUsage& pu )
+{
+    pu.require< ConsistencyCheckPass >();
+}
+
+u1 DerivedInliningPass::run( libpass::PassResult& pr )
+{
+    libpass::PassLogger log( &id, stream() );
+
+    const auto& data = pr.input< ConsistencyCheckPass >();
+    const auto& specification = data->specification();
+
+    const auto inlined = optimize( *specification );
+
+    log.info( "inlined " + std::to_string( inlined ) + " derived calls" );
+
+    return true;
+}
+
+u64 DerivedInliningPass::optimize( Specification& specification )
+{
+    const Arena::Scope scope( specification.arena() ? specification.arena() : Arena::active() );
+
+    u64 inlined = 0;
+
+    for( const auto& derived : specification.deriveds() )
+    {
+        inlined += optimize( *derived );
+    }
+
+    for( const auto& rule : specification.rules() )
+    {
+        inlined += optimize( *rule );
+    }
+
+    return inlined;
+}
+
+u64 DerivedInliningPass::optimize( Rule& rule )
+{
+    DerivedInlining inlining;
+    inlining.inlineCalls( *rule.context() );
+    return inlining.count();
+}
+
+u64 DerivedInliningPass::optimize( Derived& derived )
+{
+    DerivedInlining inlining( &derived );
+    inlining.inlineCalls( *derived.context() );
+    return inlining.count();
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
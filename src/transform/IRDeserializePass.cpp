@@ -0,0 +1,1168 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "IRDeserializePass.h"
+
+#include <libcasm-ir/Exception>
+#include <libcasm-ir/Specification>
+
+#include <libpass/PassLogger>
+#include <libpass/PassRegistry>
+#include <libpass/PassResult>
+#include <libpass/PassUsage>
+
+#include <algorithm>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace libcasm_ir;
+
+//
+//
+// IRDeserializePass
+//
+
+char IRDeserializePass::id = 0;
+
+static libpass::PassRegistration< IRDeserializePass > PASS(
+    "IRDeserializePass",
+    "deserializes the CASM IR from the binary IR format",
+    "ir-deserialize",
+    0 );
+
+IRDeserializePass::IRDeserializePass( void )
+: m_path( "./obj/out.ir.bin" )
+, m_lazy( false )
+{
+}
+
+u1 IRDeserializePass::run( libpass::PassResult& pr )
+{
+    libpass::PassLogger log( &id, stream() );
+
+    try
+    {
+        const auto deserializer = libstdhl::Memory::make< IRDeserializer >( m_path );
+        pr.setOutput< IRDeserializePass >( deserializer->specification( m_lazy ) );
+    }
+    catch( const InternalException& e )
+    {
+        log.error( "unsuccessful deserialization of '" + m_path + "': " + std::string( e.what() ) );
+        return false;
+    }
+
+    return true;
+}
+
+void IRDeserializePass::setPath( const std::string& path )
+{
+    m_path = path;
+}
+
+const std::string& IRDeserializePass::path( void ) const
+{
+    return m_path;
+}
+
+void IRDeserializePass::setLazy( const u1 lazy )
+{
+    m_lazy = lazy;
+}
+
+u1 IRDeserializePass::lazy( void ) const
+{
+    return m_lazy;
+}
+
+//
+//
+// IRDeserializer
+//
+
+IRDeserializer::IRDeserializer( const std::vector< u8 >& bytes )
+: m_bytes( bytes )
+, m_data( m_bytes.data() )
+, m_size( m_bytes.size() )
+, m_mapped( false )
+, m_decoded( false )
+{
+    decodeHeader();
+}
+
+IRDeserializer::IRDeserializer( const std::string& filename )
+: m_bytes()
+, m_data( nullptr )
+, m_size( 0 )
+, m_mapped( false )
+, m_decoded( false )
+{
+    const auto fd = ::open( filename.c_str(), O_RDONLY );
+    if( fd < 0 )
+    {
+        throw InternalException( "unable to open '" + filename + "'" );
+    }
+
+    struct stat status;
+    if( ::fstat( fd, &status ) != 0 )
+    {
+        ::close( fd );
+        throw InternalException( "unable to stat '" + filename + "'" );
+    }
+
+    m_size = status.st_size;
+
+    if( m_size > 0 )
+    {
+        const auto data = ::mmap( nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+        if( data == MAP_FAILED )
+        {
+            ::close( fd );
+            throw InternalException( "unable to map '" + filename + "'" );
+        }
+
+        m_data = static_cast< const u8* >( data );
+        m_mapped = true;
+    }
+
+    ::close( fd );
+
+    try
+    {
+        decodeHeader();
+    }
+    catch( ... )
+    {
+        if( m_mapped )
+        {
+            ::munmap( const_cast< u8* >( m_data ), m_size );
+        }
+        throw;
+    }
+}
+
+IRDeserializer::~IRDeserializer( void )
+{
+    if( m_mapped )
+    {
+        ::munmap( const_cast< u8* >( m_data ), m_size );
+    }
+}
+
+Specification::Ptr IRDeserializer::specification( const u1 lazy )
+{
+    if( m_decoded )
+    {
+        if( const auto specification = m_specification.lock() )
+        {
+            return specification;
+        }
+
+        throw InternalException( "decoded specification of binary IR was already released" );
+    }
+
+    decodeTypes();
+
+    auto cursor = section( IRBinary::Section::GLOBALS );
+
+    const auto name = string( cursor.getVarint() );
+    const auto specification = libstdhl::Memory::make< Specification >( name );
+
+    if( cursor.get() )
+    {
+        specification->setAgent( Arena::make< Agent >( type( cursor.getVarint() ) ) );
+    }
+
+    std::vector< u64 > types( cursor.getCount() );
+    for( auto& index : types )
+    {
+        index = cursor.getVarint();
+    }
+
+    std::vector< u64 > constants( cursor.getCount() );
+    for( auto& index : constants )
+    {
+        index = cursor.getVarint();
+    }
+
+    const auto decodeBody = [this, &cursor]( void ) -> Body {
+        const Body body = { cursor.getVarint(), cursor.getVarint() };
+        if( body.size > m_length[ IRBinary::Section::CODE ] or
+            body.offset > m_length[ IRBinary::Section::CODE ] - body.size )
+        {
+            throw InternalException( "invalid body in binary IR" );
+        }
+        return body;
+    };
+
+    const auto deriveds = cursor.getVarint();
+    for( u64 c = 0; c < deriveds; c++ )
+    {
+        const auto name = string( cursor.getVarint() );
+        const auto derivedType = type( cursor.getVarint() );
+        m_deriveds.emplace_back( Arena::make< Derived >( name, derivedType ) );
+        m_derivedBodies.emplace_back( decodeBody() );
+    }
+
+    std::vector< Rule::Ptr > rules( cursor.getCount() );
+    for( std::size_t c = 0; c < rules.size(); c++ )
+    {
+        const auto name = string( cursor.getVarint() );
+        const auto ruleType = type( cursor.getVarint() );
+        rules[ c ] = Arena::make< Rule >( name, ruleType );
+
+        const auto parameters = cursor.getVarint();
+        for( u64 p = 0; p < parameters; p++ )
+        {
+            const auto parameter = constant( cursor.getVarint() );
+            if( not isa< Identifier >( parameter ) )
+            {
+                throw InternalException( "invalid rule parameter in binary IR" );
+            }
+
+            rules[ c ]->addParameter( std::static_pointer_cast< Identifier >( parameter ) );
+        }
+
+        m_rules.emplace_back( rules[ c ] );
+        m_ruleBodies.emplace_back( decodeBody() );
+        m_ruleIndex.emplace( rules[ c ].get(), c );
+    }
+
+    const auto builtins = cursor.getVarint();
+    const auto specificationBuiltins = cursor.getVarint();
+    for( u64 c = 0; c < builtins; c++ )
+    {
+        const auto id = ( Value::ID )( cursor.getVarint() );
+        const auto builtinType = type( cursor.getVarint() );
+        m_builtins.emplace_back( Builtin::create( id, builtinType ) );
+    }
+
+    const auto functions = cursor.getVarint();
+    const auto specificationFunctions = cursor.getVarint();
+    for( u64 c = 0; c < functions; c++ )
+    {
+        const auto name = string( cursor.getVarint() );
+        const auto functionType = type( cursor.getVarint() );
+        m_functions.emplace_back( Arena::make< Function >( name, functionType ) );
+    }
+
+    if( specificationBuiltins > builtins or specificationFunctions > functions )
+    {
+        throw InternalException( "invalid global table in binary IR" );
+    }
+
+    for( const auto index : types )
+    {
+        specification->add( type( index ) );
+    }
+
+    for( u64 c = 0; c < specificationBuiltins; c++ )
+    {
+        specification->add( m_builtins[ c ] );
+    }
+
+    for( u64 c = 0; c < specificationFunctions; c++ )
+    {
+        specification->add( m_functions[ c ] );
+    }
+
+    for( const auto& derived : m_deriveds )
+    {
+        specification->add( derived );
+    }
+
+    for( const auto& rule : rules )
+    {
+        specification->add( rule );
+    }
+
+    for( const auto index : constants )
+    {
+        const auto value = constant( index );
+        specification->add( std::static_pointer_cast< Constant >( value ) );
+    }
+
+    m_specification = specification;
+    m_decoded = true;
+
+    for( std::size_t c = 0; c < m_deriveds.size(); c++ )
+    {
+        const auto& body = m_derivedBodies[ c ];
+        if( body.size == 0 )
+        {
+            continue;
+        }
+
+        auto code = this->body( body );
+        const auto id = ( Value::ID )( code.getVarint() );
+        if( id != Value::TRIVIAL_STATEMENT and id != Value::BRANCH_STATEMENT )
+        {
+            throw InternalException( "invalid derived context in binary IR" );
+        }
+
+        Statement::Ptr context;
+        if( id == Value::TRIVIAL_STATEMENT )
+        {
+            context = Arena::make< TrivialStatement >();
+        }
+        else
+        {
+            context = Arena::make< BranchStatement >();
+        }
+
+        m_deriveds[ c ]->setContext( context );
+
+        std::vector< Instruction::Ptr > locals;
+        decode( code, *context, locals );
+    }
+
+    if( lazy )
+    {
+        // the loaders keep the deserializer and its mapping alive as long as
+        // there are rules left which were not accessed yet, a body decoded
+        // on first access is placed into the arena active during decoding,
+        // the arena is only used while the deserializer is locked
+
+        const auto self = shared_from_this();
+        const auto arena = Arena::active();
+        for( const auto& rule : rules )
+        {
+            rule->setContextLoader( [self, arena]( Rule& stub ) {
+                std::lock_guard< std::mutex > lock( self->m_mutex );
+                const Arena::Scope scope( arena );
+                self->decode( stub );
+            } );
+        }
+    }
+    else
+    {
+        for( const auto& rule : rules )
+        {
+            materialize( *rule );
+        }
+    }
+
+    return specification;
+}
+
+void IRDeserializer::materialize( Rule& rule )
+{
+    if( not rule.materialized() )
+    {
+        // invokes the pending loader which materializes the rule, the lock of
+        // the rule is always acquired before the lock of the deserializer
+        rule.context();
+        return;
+    }
+
+    std::lock_guard< std::mutex > lock( m_mutex );
+    decode( rule );
+}
+
+void IRDeserializer::decode( Rule& rule )
+{
+    const auto result = m_ruleIndex.find( &rule );
+    if( result == m_ruleIndex.end() )
+    {
+        throw InternalException( "rule '" + rule.name() + "' is not part of the binary IR" );
+    }
+
+    const auto& body = m_ruleBodies[ result->second ];
+    if( rule.context() or body.size == 0 )
+    {
+        return;
+    }
+
+    auto cursor = this->body( body );
+    const auto id = ( Value::ID )( cursor.getVarint() );
+    if( id != Value::PARALLEL_BLOCK )
+    {
+        throw InternalException( "invalid context of rule '" + rule.name() + "' in binary IR" );
+    }
+
+    const auto context = ParallelBlock::create( cursor.get() != 0 );
+
+    std::vector< Instruction::Ptr > locals;
+    decode( cursor, *context, locals );
+
+    rule.setContext( context );
+}
+
+void IRDeserializer::decodeHeader( void )
+{
+    IRBinary::Cursor cursor( m_data, m_size );
+
+    if( m_size < IRBinary::HEADER_SIZE or cursor.getFixed( 4 ) != IRBinary::MAGIC )
+    {
+        throw InternalException( "invalid binary IR header" );
+    }
+
+    const auto major = cursor.getFixed( 2 );
+    const auto minor = cursor.getFixed( 2 );
+    if( major != IRBinary::VERSION_MAJOR or minor > IRBinary::VERSION_MINOR )
+    {
+        throw InternalException(
+            "unsupported binary IR version " + std::to_string( major ) + "." +
+            std::to_string( minor ) );
+    }
+
+    for( std::size_t c = 0; c < IRBinary::Section::_SECTION_SIZE_; c++ )
+    {
+        m_offset[ c ] = cursor.getFixed( 8 );
+        m_length[ c ] = cursor.getFixed( 8 );
+
+        if( m_length[ c ] > m_size or m_offset[ c ] > m_size - m_length[ c ] )
+        {
+            throw InternalException( "invalid binary IR section " + std::to_string( c ) );
+        }
+    }
+
+    // every string and constant has an offset of 8 bytes in its table
+
+    auto strings = section( IRBinary::Section::STRINGS );
+    m_strings = strings.getFixed( 8 );
+    if( m_strings > strings.remaining() / 8 )
+    {
+        throw InternalException( "invalid string table in binary IR" );
+    }
+
+    auto constants = section( IRBinary::Section::CONSTANTS );
+    const auto size = constants.getFixed( 8 );
+    if( size > constants.remaining() / 8 )
+    {
+        throw InternalException( "invalid constant table in binary IR" );
+    }
+    m_constants.resize( size );
+}
+
+void IRDeserializer::decodeTypes( void )
+{
+    auto cursor = section( IRBinary::Section::TYPES );
+
+    const auto size = cursor.getVarint();
+    for( u64 c = 0; c < size; c++ )
+    {
+        m_types.emplace_back( decodeType( cursor ) );
+    }
+}
+
+Type::Ptr IRDeserializer::decodeType( IRBinary::Cursor& cursor )
+{
+    const auto decodeArguments = [this, &cursor]( void ) -> Types {
+        Types types;
+        const auto size = cursor.getVarint();
+        for( u64 c = 0; c < size; c++ )
+        {
+            types.add( type( cursor.getVarint() ) );
+        }
+        return types;
+    };
+
+    const auto kind = ( Type::Kind )( cursor.get() );
+
+    switch( kind )
+    {
+        case Type::Kind::VOID:
+        {
+            return libstdhl::Memory::get< VoidType >();
+        }
+        case Type::Kind::LABEL:
+        {
+            return libstdhl::Memory::get< LabelType >();
+        }
+        case Type::Kind::LOCATION:
+        {
+            return libstdhl::Memory::get< LocationType >();
+        }
+        case Type::Kind::RELATION:
+        {
+            const auto result = type( cursor.getVarint() );
+            return libstdhl::Memory::make< RelationType >( result, decodeArguments() );
+        }
+        case Type::Kind::BOOLEAN:
+        {
+            return libstdhl::Memory::get< BooleanType >();
+        }
+        case Type::Kind::INTEGER:
+        {
+            if( cursor.get() )
+            {
+                const auto range = type( cursor.getVarint() );
+                if( not range->isRange() )
+                {
+                    throw InternalException( "invalid integer type range in binary IR" );
+                }
+                return libstdhl::Memory::make< IntegerType >(
+                    std::static_pointer_cast< RangeType >( range ) );
+            }
+            return libstdhl::Memory::get< IntegerType >();
+        }
+        case Type::Kind::RATIONAL:
+        {
+            return libstdhl::Memory::get< RationalType >();
+        }
+        case Type::Kind::BINARY:
+        {
+            return libstdhl::Memory::make< BinaryType >( ( u16 )( cursor.getVarint() ) );
+        }
+        case Type::Kind::DECIMAL:
+        {
+            return libstdhl::Memory::get< DecimalType >();
+        }
+        case Type::Kind::STRING:
+        {
+            return libstdhl::Memory::get< StringType >();
+        }
+        case Type::Kind::ENUMERATION:
+        {
+            const auto name = string( cursor.getVarint() );
+
+            std::vector< std::string > elements( cursor.getCount() );
+            for( auto& element : elements )
+            {
+                element = string( cursor.getVarint() );
+            }
+
+            auto result = m_enumerations.find( name );
+            if( result == m_enumerations.end() )
+            {
+                const auto enumeration = libstdhl::Memory::make< Enumeration >( name, elements );
+                result = m_enumerations.emplace( name, enumeration ).first;
+            }
+
+            return libstdhl::Memory::make< EnumerationType >( result->second );
+        }
+        case Type::Kind::RANGE:
+        {
+            if( cursor.get() )
+            {
+                const auto from = constant( cursor.getVarint() );
+                const auto to = constant( cursor.getVarint() );
+                return libstdhl::Memory::make< RangeType >(
+                    libstdhl::Memory::make< Range >( from, to ) );
+            }
+            return libstdhl::Memory::make< RangeType >( type( cursor.getVarint() ) );
+        }
+        case Type::Kind::TUPLE:
+        {
+            return libstdhl::Memory::make< TupleType >( decodeArguments() );
+        }
+        case Type::Kind::RECORD:
+        {
+            const auto types = decodeArguments();
+
+            std::vector< std::string > identifiers( types.size() );
+            for( auto& identifier : identifiers )
+            {
+                identifier = string( cursor.getVarint() );
+            }
+
+            return libstdhl::Memory::make< RecordType >( types, identifiers );
+        }
+        case Type::Kind::LIST:
+        {
+            return libstdhl::Memory::make< ListType >( type( cursor.getVarint() ) );
+        }
+        case Type::Kind::OBJECT:
+        {
+            return libstdhl::Memory::make< ObjectType >( string( cursor.getVarint() ) );
+        }
+        case Type::Kind::RULE_REFERENCE:  // [fallthrough]
+        case Type::Kind::FUNCTION_REFERENCE:
+        {
+            const auto relation = type( cursor.getVarint() );
+            if( not relation->isRelation() )
+            {
+                throw InternalException( "invalid reference type in binary IR" );
+            }
+
+            const auto relationType = std::static_pointer_cast< RelationType >( relation );
+            if( kind == Type::Kind::RULE_REFERENCE )
+            {
+                return libstdhl::Memory::make< RuleReferenceType >( relationType );
+            }
+            return libstdhl::Memory::make< FunctionReferenceType >( relationType );
+        }
+        default:
+        {
+            break;
+        }
+    }
+
+    throw InternalException( "unsupported type kind " + std::to_string( (u32)kind ) );
+}
+
+Value::Ptr IRDeserializer::decodeConstant( IRBinary::Cursor& cursor )
+{
+    const auto id = ( Value::ID )( cursor.getVarint() );
+    const auto constantType = type( cursor.getVarint() );
+    const u1 defined = cursor.get() != 0;
+
+    if( not defined )
+    {
+        return libstdhl::Memory::make< Constant >( Constant::undef( constantType ) );
+    }
+
+    switch( id )
+    {
+        case Value::VOID_CONSTANT:
+        {
+            return libstdhl::Memory::make< VoidConstant >();
+        }
+        case Value::BOOLEAN_CONSTANT:
+        {
+            return libstdhl::Memory::make< BooleanConstant >( ( u1 )( cursor.get() != 0 ) );
+        }
+        case Value::INTEGER_CONSTANT:
+        {
+            return libstdhl::Memory::make< IntegerConstant >(
+                string( cursor.getVarint() ), libstdhl::Type::DECIMAL );
+        }
+        case Value::BINARY_CONSTANT:
+        {
+            const auto value = string( cursor.getVarint() );
+            return libstdhl::Memory::make< BinaryConstant >(
+                constantType, libstdhl::Type::createNatural( value, libstdhl::Type::DECIMAL ) );
+        }
+        case Value::STRING_CONSTANT:
+        {
+            return libstdhl::Memory::make< StringConstant >( string( cursor.getVarint() ) );
+        }
+        case Value::ENUMERATION_CONSTANT:
+        {
+            if( not constantType->isEnumeration() )
+            {
+                throw InternalException( "invalid enumeration constant in binary IR" );
+            }
+            return libstdhl::Memory::make< EnumerationConstant >(
+                std::static_pointer_cast< EnumerationType >( constantType ),
+                string( cursor.getVarint() ) );
+        }
+        case Value::RANGE_CONSTANT:
+        {
+            if( not constantType->isRange() )
+            {
+                throw InternalException( "invalid range constant in binary IR" );
+            }
+            const auto rangeType = std::static_pointer_cast< RangeType >( constantType );
+            return libstdhl::Memory::make< RangeConstant >( rangeType, rangeType->ptr_range() );
+        }
+        case Value::DOMAIN_CONSTANT:
+        {
+            return libstdhl::Memory::make< DomainConstant >( constantType );
+        }
+        case Value::RULE_REFERENCE_CONSTANT:
+        {
+            const auto value = global( cursor.getVarint() );
+            if( not isa< Rule >( value ) )
+            {
+                throw InternalException( "invalid rule reference constant in binary IR" );
+            }
+            return libstdhl::Memory::make< RuleReferenceConstant >(
+                std::static_pointer_cast< Rule >( value ) );
+        }
+        case Value::FUNCTION_REFERENCE_CONSTANT:
+        {
+            const auto value = global( cursor.getVarint() );
+            if( isa< Derived >( value ) )
+            {
+                return libstdhl::Memory::make< FunctionReferenceConstant >(
+                    std::static_pointer_cast< Derived >( value ) );
+            }
+            else if( isa< Builtin >( value ) )
+            {
+                return libstdhl::Memory::make< FunctionReferenceConstant >(
+                    std::static_pointer_cast< Builtin >( value ) );
+            }
+            else if( isa< Function >( value ) )
+            {
+                return libstdhl::Memory::make< FunctionReferenceConstant >(
+                    std::static_pointer_cast< Function >( value ) );
+            }
+            throw InternalException( "invalid function reference constant in binary IR" );
+        }
+        case Value::IDENTIFIER:
+        {
+            const auto value = string( cursor.getVarint() );
+            return libstdhl::Memory::make< Identifier >( constantType, value );
+        }
+        default:
+        {
+            break;
+        }
+    }
+
+    throw InternalException( "unsupported constant " + std::to_string( id ) );
+}
+
+void IRDeserializer::decode(
+    IRBinary::Cursor& cursor,
+    ExecutionSemanticsBlock& block,
+    std::vector< Instruction::Ptr >& locals )
+{
+    const auto size = cursor.getVarint();
+    for( u64 c = 0; c < size; c++ )
+    {
+        const auto id = ( Value::ID )( cursor.getVarint() );
+
+        switch( id )
+        {
+            case Value::PARALLEL_BLOCK:
+            {
+                const auto child = ParallelBlock::create( cursor.get() != 0 );
+                block.add( child );
+                decode( cursor, *child, locals );
+                break;
+            }
+            case Value::SEQUENTIAL_BLOCK:
+            {
+                const auto child = SequentialBlock::create( cursor.get() != 0 );
+                block.add( child );
+                decode( cursor, *child, locals );
+                break;
+            }
+            case Value::TRIVIAL_STATEMENT:
+            {
+                const auto child = Arena::make< TrivialStatement >();
+                block.add( child );
+                decode( cursor, *child, locals );
+                break;
+            }
+            case Value::BRANCH_STATEMENT:
+            {
+                const auto child = Arena::make< BranchStatement >();
+                block.add( child );
+                decode( cursor, *child, locals );
+                break;
+            }
+            case Value::FORALL_STATEMENT:
+            {
+                const auto child = Arena::make< ForallStatement >();
+                block.add( child );
+                decode( cursor, *child, locals );
+                break;
+            }
+            default:
+            {
+                throw InternalException( "unsupported block " + std::to_string( id ) );
+            }
+        }
+    }
+}
+
+void IRDeserializer::decode(
+    IRBinary::Cursor& cursor, Statement& statement, std::vector< Instruction::Ptr >& locals )
+{
+    if( isa< BranchStatement >( statement ) or isa< ForallStatement >( statement ) )
+    {
+        const auto size = cursor.getVarint();
+        for( u64 c = 0; c < size; c++ )
+        {
+            const auto id = ( Value::ID )( cursor.getVarint() );
+
+            ExecutionSemanticsBlock::Ptr block;
+            if( id == Value::PARALLEL_BLOCK )
+            {
+                block = ParallelBlock::create( cursor.get() != 0 );
+            }
+            else if( id == Value::SEQUENTIAL_BLOCK )
+            {
+                block = SequentialBlock::create( cursor.get() != 0 );
+            }
+            else
+            {
+                throw InternalException( "unsupported branch block " + std::to_string( id ) );
+            }
+
+            statement.add( block );
+            decode( cursor, *block, locals );
+        }
+    }
+
+    const auto size = cursor.getVarint();
+    for( u64 c = 0; c < size; c++ )
+    {
+        const auto instruction = decodeInstruction( cursor, statement, locals );
+        statement.add( instruction );
+        locals.emplace_back( instruction );
+    }
+
+    if( const auto forall = cast< ForallStatement >( statement ) )
+    {
+        const auto variable = reference( cursor.getVarint(), statement, locals );
+        if( not isa< Identifier >( variable ) )
+        {
+            throw InternalException( "invalid forall variable in binary IR" );
+        }
+
+        forall->setVariable( std::static_pointer_cast< Identifier >( variable ) );
+        forall->setDomain( reference( cursor.getVarint(), statement, locals ) );
+    }
+}
+
+Instruction::Ptr IRDeserializer::decodeInstruction(
+    IRBinary::Cursor& cursor, Statement& statement, std::vector< Instruction::Ptr >& locals )
+{
+    const auto id = ( Value::ID )( cursor.getVarint() );
+    const auto instructionType = type( cursor.getVarint() );
+
+    std::vector< Value::Ptr > operands( cursor.getCount() );
+    for( auto& operand : operands )
+    {
+        operand = reference( cursor.getVarint(), statement, locals );
+    }
+
+    const auto operand = [&operands, id]( const std::size_t position ) -> const Value::Ptr& {
+        if( position >= operands.size() )
+        {
+            throw InternalException(
+                "missing operand " + std::to_string( position ) + " of instruction " +
+                std::to_string( id ) );
+        }
+        return operands[ position ];
+    };
+
+    const std::vector< Value::Ptr > arguments(
+        operands.begin() + std::min< std::size_t >( 1, operands.size() ), operands.end() );
+
+    switch( id )
+    {
+        case Value::SKIP_INSTRUCTION:
+        {
+            return Arena::make< SkipInstruction >();
+        }
+        case Value::FORK_INSTRUCTION:
+        {
+            return Arena::make< ForkInstruction >();
+        }
+        case Value::MERGE_INSTRUCTION:
+        {
+            return Arena::make< MergeInstruction >();
+        }
+        case Value::LOOKUP_INSTRUCTION:
+        {
+            return Arena::make< LookupInstruction >( operand( 0 ) );
+        }
+        case Value::UPDATE_INSTRUCTION:
+        {
+            return Arena::make< UpdateInstruction >( operand( 0 ), operand( 1 ) );
+        }
+        case Value::LOCAL_INSTRUCTION:
+        {
+            return Arena::make< LocalInstruction >( operand( 0 ), operand( 1 ) );
+        }
+        case Value::LOCATION_INSTRUCTION:
+        {
+            return Arena::make< LocationInstruction >( operand( 0 ), arguments );
+        }
+        case Value::CALL_INSTRUCTION:
+        {
+            const auto& callee = operand( 0 );
+            if( isa< Rule >( callee ) or isa< Derived >( callee ) or isa< Builtin >( callee ) )
+            {
+                return Arena::make< CallInstruction >( callee, arguments );
+            }
+
+            const auto instruction = Arena::make< CallInstruction >( instructionType );
+            for( const auto& value : operands )
+            {
+                instruction->add( value );
+            }
+            return instruction;
+        }
+        case Value::SELECT_INSTRUCTION:
+        {
+            return Arena::make< SelectInstruction >( operand( 0 ), operands );
+        }
+        case Value::SELF_INSTRUCTION:
+        {
+            const auto instruction = Arena::make< SelfInstruction >( instructionType );
+            for( const auto& value : operands )
+            {
+                instruction->add( value );
+            }
+            return instruction;
+        }
+        case Value::INV_INSTRUCTION:
+        {
+            return Arena::make< InvInstruction >( operand( 0 ) );
+        }
+        case Value::ADD_INSTRUCTION:
+        {
+            return Arena::make< AddInstruction >( operand( 0 ), operand( 1 ) );
+        }
+        case Value::SUB_INSTRUCTION:
+        {
+            return Arena::make< SubInstruction >( operand( 0 ), operand( 1 ) );
+        }
+        case Value::MUL_INSTRUCTION:
+        {
+            return Arena::make< MulInstruction >( operand( 0 ), operand( 1 ) );
+        }
+        case Value::DIV_INSTRUCTION:
+        {
+            return Arena::make< DivInstruction >( operand( 0 ), operand( 1 ) );
+        }
+        case Value::POW_INSTRUCTION:
+        {
+            return Arena::make< PowInstruction >( operand( 0 ), operand( 1 ) );
+        }
+        case Value::MOD_INSTRUCTION:
+        {
+            return Arena::make< ModInstruction >( operand( 0 ), operand( 1 ) );
+        }
+        case Value::EQU_INSTRUCTION:
+        {
+            return Arena::make< EquInstruction >( operand( 0 ), operand( 1 ) );
+        }
+        case Value::NEQ_INSTRUCTION:
+        {
+            return Arena::make< NeqInstruction >( operand( 0 ), operand( 1 ) );
+        }
+        case Value::LTH_INSTRUCTION:
+        {
+            return Arena::make< LthInstruction >( operand( 0 ), operand( 1 ) );
+        }
+        case Value::LEQ_INSTRUCTION:
+        {
+            return Arena::make< LeqInstruction >( operand( 0 ), operand( 1 ) );
+        }
+        case Value::GTH_INSTRUCTION:
+        {
+            return Arena::make< GthInstruction >( operand( 0 ), operand( 1 ) );
+        }
+        case Value::GEQ_INSTRUCTION:
+        {
+            return Arena::make< GeqInstruction >( operand( 0 ), operand( 1 ) );
+        }
+        case Value::OR_INSTRUCTION:
+        {
+            return Arena::make< OrInstruction >( operand( 0 ), operand( 1 ) );
+        }
+        case Value::XOR_INSTRUCTION:
+        {
+            return Arena::make< XorInstruction >( operand( 0 ), operand( 1 ) );
+        }
+        case Value::AND_INSTRUCTION:
+        {
+            return Arena::make< AndInstruction >( operand( 0 ), operand( 1 ) );
+        }
+        case Value::IMP_INSTRUCTION:
+        {
+            return Arena::make< ImpInstruction >( operand( 0 ), operand( 1 ) );
+        }
+        case Value::NOT_INSTRUCTION:
+        {
+            return Arena::make< NotInstruction >( operand( 0 ) );
+        }
+        default:
+        {
+            break;
+        }
+    }
+
+    throw InternalException( "unsupported instruction " + std::to_string( id ) );
+}
+
+IRBinary::Cursor IRDeserializer::section( const IRBinary::Section section ) const
+{
+    const auto offset = m_offset[ section ];
+    return IRBinary::Cursor( m_data, offset + m_length[ section ], offset );
+}
+
+IRBinary::Cursor IRDeserializer::body( const Body& body ) const
+{
+    const auto offset = m_offset[ IRBinary::Section::CODE ] + body.offset;
+    return IRBinary::Cursor( m_data, offset + body.size, offset );
+}
+
+std::string IRDeserializer::string( const u64 index ) const
+{
+    if( index >= m_strings )
+    {
+        throw InternalException( "invalid string reference " + std::to_string( index ) );
+    }
+
+    auto cursor = section( IRBinary::Section::STRINGS );
+    cursor.seek( cursor.offset() + 8 + index * 8 );
+    const auto offset = cursor.getFixed( 8 );
+
+    cursor.seek( m_offset[ IRBinary::Section::STRINGS ] + 8 + m_strings * 8 + offset );
+    const auto size = cursor.getVarint();
+    const auto bytes = cursor.getBytes( size );
+
+    return std::string( reinterpret_cast< const char* >( bytes ), size );
+}
+
+Type::Ptr IRDeserializer::type( const u64 index ) const
+{
+    if( index >= m_types.size() )
+    {
+        throw InternalException( "invalid type reference " + std::to_string( index ) );
+    }
+
+    return m_types[ index ];
+}
+
+Value::Ptr IRDeserializer::constant( const u64 index )
+{
+    if( index >= m_constants.size() )
+    {
+        throw InternalException( "invalid constant reference " + std::to_string( index ) );
+    }
+
+    auto& value = m_constants[ index ];
+    if( not value )
+    {
+        auto cursor = section( IRBinary::Section::CONSTANTS );
+        cursor.seek( cursor.offset() + 8 + index * 8 );
+        const auto offset = cursor.getFixed( 8 );
+
+        cursor.seek(
+            m_offset[ IRBinary::Section::CONSTANTS ] + 8 + m_constants.size() * 8 + offset );
+        value = decodeConstant( cursor );
+    }
+
+    return value;
+}
+
+Value::Ptr IRDeserializer::global( const u64 reference ) const
+{
+    const auto index = reference >> IRBinary::REFERENCE_BITS;
+    const auto kind =
+        ( IRBinary::Reference )( reference & ( ( 1 << IRBinary::REFERENCE_BITS ) - 1 ) );
+
+    switch( kind )
+    {
+        case IRBinary::Reference::FUNCTION:
+        {
+            if( index < m_functions.size() )
+            {
+                return m_functions[ index ];
+            }
+            break;
+        }
+        case IRBinary::Reference::DERIVED:
+        {
+            if( index < m_deriveds.size() )
+            {
+                return m_deriveds[ index ];
+            }
+            break;
+        }
+        case IRBinary::Reference::BUILTIN:
+        {
+            if( index < m_builtins.size() )
+            {
+                return m_builtins[ index ];
+            }
+            break;
+        }
+        case IRBinary::Reference::RULE:
+        {
+            if( index < m_rules.size() )
+            {
+                if( const auto rule = m_rules[ index ].lock() )
+                {
+                    return rule;
+                }
+            }
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+
+    throw InternalException( "invalid global reference " + std::to_string( reference ) );
+}
+
+Value::Ptr IRDeserializer::reference(
+    const u64 reference, Statement& statement, const std::vector< Instruction::Ptr >& locals )
+{
+    const auto index = reference >> IRBinary::REFERENCE_BITS;
+    const auto kind =
+        ( IRBinary::Reference )( reference & ( ( 1 << IRBinary::REFERENCE_BITS ) - 1 ) );
+
+    switch( kind )
+    {
+        case IRBinary::Reference::INSTRUCTION:
+        {
+            if( index < locals.size() )
+            {
+                return locals[ index ];
+            }
+            break;
+        }
+        case IRBinary::Reference::BLOCK:
+        {
+            if( isa< BranchStatement >( statement ) and index < statement.blocks().size() )
+            {
+                return statement.blocks().at( index );
+            }
+            break;
+        }
+        case IRBinary::Reference::CONSTANT:
+        {
+            return constant( index );
+        }
+        default:
+        {
+            return global( reference );
+        }
+    }
+
+    throw InternalException( "invalid local reference " + std::to_string( reference ) );
+}
+
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -0,0 +1,220 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#ifndef _LIBCASM_IR_IR_DESERIALIZE_PASS_H_
+#define _LIBCASM_IR_IR_DESERIALIZE_PASS_H_
+
+#include <libcasm-ir/Specification>
+#include <libcasm-ir/analyze/ConsistencyCheckPass>
+#include <libcasm-ir/transform/IRSerializePass>
+
+#include <libpass/Pass>
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/**
+   @brief    deserializes a CASM IR from the binary IR format
+
+   The binary IR file is mapped into memory and only the global section is
+   decoded eagerly. Strings and constants are decoded on first use and every
+   rule body can be materialized on its own. In the lazy mode the rules of
+   the specification are stubs which decode their context on first access.
+*/
+
+namespace libcasm_ir
+{
+    class IRDeserializePass final : public libpass::Pass
+    {
+      public:
+        using Output = ConsistencyCheckPass::Data;
+
+        static char id;
+
+        IRDeserializePass( void );
+
+        u1 run( libpass::PassResult& pr ) override;
+
+        void setPath( const std::string& path );
+
+        const std::string& path( void ) const;
+
+        /**
+           enables the lazy mode, rule contexts are decoded on first access
+        */
+        void setLazy( const u1 lazy );
+
+        u1 lazy( void ) const;
+
+      private:
+        std::string m_path;
+        u1 m_lazy;
+    };
+
+    class IRDeserializer : public std::enable_shared_from_this< IRDeserializer >
+    {
+      public:
+        using Ptr = std::shared_ptr< IRDeserializer >;
+
+        /**
+           decodes a binary IR from an in-memory copy of the given bytes
+        */
+        IRDeserializer( const std::vector< u8 >& bytes );
+
+        /**
+           decodes a binary IR from the given file which is mapped read-only
+           into memory for the lifetime of the deserializer
+        */
+        IRDeserializer( const std::string& filename );
+
+        ~IRDeserializer( void );
+
+        IRDeserializer( const IRDeserializer& ) = delete;
+        IRDeserializer& operator=( const IRDeserializer& ) = delete;
+
+        /**
+           decodes the specification and all its global values, in the lazy
+           mode the rules are created as stubs whose context is decoded on
+           its first access, which requires the deserializer to be owned by
+           a shared pointer
+        */
+        Specification::Ptr specification( const u1 lazy = false );
+
+        /**
+           decodes the context of a rule of the decoded specification, rules
+           which already have a context are left untouched, the context is
+           only set after its body was decoded successfully
+        */
+        void materialize( Rule& rule );
+
+      private:
+        struct Body
+        {
+            u64 offset;
+            u64 size;
+        };
+
+        void decodeHeader( void );
+
+        void decodeTypes( void );
+
+        void decode( Rule& rule );
+
+        Type::Ptr decodeType( IRBinary::Cursor& cursor );
+
+        Value::Ptr decodeConstant( IRBinary::Cursor& cursor );
+
+        void decode(
+            IRBinary::Cursor& cursor,
+            ExecutionSemanticsBlock& block,
+            std::vector< Instruction::Ptr >& locals );
+
+        void decode(
+            IRBinary::Cursor& cursor,
+            Statement& statement,
+            std::vector< Instruction::Ptr >& locals );
+
+        Instruction::Ptr decodeInstruction(
+            IRBinary::Cursor& cursor,
+            Statement& statement,
+            std::vector< Instruction::Ptr >& locals );
+
+        IRBinary::Cursor section( const IRBinary::Section section ) const;
+
+        IRBinary::Cursor body( const Body& body ) const;
+
+        std::string string( const u64 index ) const;
+
+        Type::Ptr type( const u64 index ) const;
+
+        Value::Ptr constant( const u64 index );
+
+        Value::Ptr global( const u64 reference ) const;
+
+        Value::Ptr reference(
+            const u64 reference,
+            Statement& statement,
+            const std::vector< Instruction::Ptr >& locals );
+
+        std::vector< u8 > m_bytes;
+        const u8* m_data;
+        std::size_t m_size;
+        u1 m_mapped;
+
+        u64 m_offset[ IRBinary::Section::_SECTION_SIZE_ ];
+        u64 m_length[ IRBinary::Section::_SECTION_SIZE_ ];
+
+        u64 m_strings;
+        std::vector< Type::Ptr > m_types;
+        std::vector< Value::Ptr > m_constants;
+        std::unordered_map< std::string, Enumeration::Ptr > m_enumerations;
+
+        std::vector< Builtin::Ptr > m_builtins;
+        std::vector< Function::Ptr > m_functions;
+        std::vector< Derived::Ptr > m_deriveds;
+        std::vector< std::weak_ptr< Rule > > m_rules;
+
+        std::vector< Body > m_derivedBodies;
+        std::vector< Body > m_ruleBodies;
+        std::unordered_map< const Rule*, std::size_t > m_ruleIndex;
+
+        std::weak_ptr< Specification > m_specification;
+        u1 m_decoded;
+
+        // guards the decoding state and the arena allocations of lazily
+        // materialized rules which can be accessed by different threads
+        std::mutex m_mutex;
+    };
+}
+
+#endif  // _LIBCASM_IR_IR_DESERIALIZE_PASS_H_
+
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
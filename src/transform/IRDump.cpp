@@ -0,0 +1,140 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "IRDump.h"
+
+#include <libcasm-ir/Derived>
+#include <libcasm-ir/Rule>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+
+using namespace libcasm_ir;
+
+void IRDump::label( Specification& specification, const Label& label )
+{
+    for( const auto& derived : specification.deriveds() )
+    {
+        label( *derived );
+    }
+
+    for( const auto& rule : specification.rules() )
+    {
+        label( *rule );
+    }
+}
+
+void IRDump::render(
+    Specification& specification, Writer& writer, const Render& render, std::size_t threads )
+{
+    std::vector< Value* > shards;
+    shards.reserve( specification.deriveds().size() + specification.rules().size() );
+
+    for( const auto& derived : specification.deriveds() )
+    {
+        shards.emplace_back( derived.get() );
+    }
+
+    for( const auto& rule : specification.rules() )
+    {
+        shards.emplace_back( rule.get() );
+    }
+
+    if( threads == 0 )
+    {
+        threads = std::max( std::thread::hardware_concurrency(), 1u );
+    }
+    threads = std::min( threads, shards.size() );
+
+    std::vector< std::string > buffers( shards.size() );
+    std::vector< std::exception_ptr > errors( shards.size() );
+    std::atomic< std::size_t > next( 0 );
+
+    const auto worker = [&]() {
+        for( auto shard = next++; shard < shards.size(); shard = next++ )
+        {
+            try
+            {
+                Writer buffer( buffers[ shard ] );
+                render( *shards[ shard ], buffer );
+            }
+            catch( ... )
+            {
+                errors[ shard ] = std::current_exception();
+            }
+        }
+    };
+
+    std::vector< std::thread > workers;
+    workers.reserve( threads );
+    for( std::size_t c = 1; c < threads; c++ )
+    {
+        workers.emplace_back( worker );
+    }
+    worker();
+
+    for( auto& thread : workers )
+    {
+        thread.join();
+    }
+
+    for( std::size_t c = 0; c < shards.size(); c++ )
+    {
+        if( errors[ c ] )
+        {
+            std::rethrow_exception( errors[ c ] );
+        }
+
+        writer << buffers[ c ];
+    }
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
@@ -0,0 +1,100 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#ifndef _LIBCASM_IR_IR_DUMP_H_
+#define _LIBCASM_IR_IR_DUMP_H_
+
+#include <libcasm-ir/Specification>
+#include <libcasm-ir/Writer>
+
+#include <functional>
+
+/**
+   @brief    common parts of the IR dump passes
+
+   The labels of the values are numbered on their first request, therefore
+   a parallel dump first requests the labels of the derived and rule bodies
+   in the same order as the sequential dump would. Afterwards the bodies are
+   independent of each other and can be rendered in parallel into separate
+   buffers, which are concatenated in declaration order to the same output
+   as a sequential dump.
+*/
+
+namespace libcasm_ir
+{
+    class IRDump
+    {
+      public:
+        using Render = std::function< void( Value& value, Writer& writer ) >;
+
+        using Label = std::function< void( Value& value ) >;
+
+        /**
+           requests the labels of the deriveds and rules in declaration order
+           through the given callback, which mirrors the label requests of
+           the sequential dump of a derived or rule
+        */
+        static void label( Specification& specification, const Label& label );
+
+        /**
+           renders the deriveds and rules of the specification on the given
+           number of threads (zero selects the hardware concurrency) and
+           writes the buffers in declaration order to the writer
+        */
+        static void render(
+            Specification& specification,
+            Writer& writer,
+            const Render& render,
+            std::size_t threads = 0 );
+    };
+}
+
+#endif  // _LIBCASM_IR_IR_DUMP_H_
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
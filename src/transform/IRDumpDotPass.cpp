@@ -49,6 +49,9 @@
 #include <libpass/PassResult>
 #include <libpass/PassUsage>
 
+#include <iomanip>
+#include <sstream>
+
 using namespace libcasm_ir;
 
 char IRDumpDotPass::id = 0;
@@ -59,6 +62,14 @@ static libpass::PassRegistration< IRDumpDotPass > PASS(
     "ir-dump-dot",
     0 );
 
+IRDumpDotPass::IRDumpDotPass( void )
+: m_path( "./obj/out.ir.dot" )
+, m_descriptor( -1 )
+, m_threads( 1 )
+, m_profile( nullptr )
+{
+}
+
 void IRDumpDotPass::usage( libpass::PassUsage& pu )
 {
     pu.require< ConsistencyCheckPass >();
@@ -71,12 +82,23 @@ u1 IRDumpDotPass::run( libpass::PassResult& pr )
     const auto& data = pr.input< ConsistencyCheckPass >();
     const auto& specification = data->specification();
 
-    std::ofstream dotfile( "./obj/out.ir.dot" );
-    IRDumpDotVisitor visitor{ dotfile };
-
     try
     {
+        std::unique_ptr< Writer > dotfile;
+        if( m_descriptor >= 0 )
+        {
+            dotfile = std::make_unique< Writer >( m_descriptor );
+        }
+        else
+        {
+            dotfile = Writer::file( m_path );
+        }
+
+        IRDumpDotVisitor visitor{ *dotfile };
+        visitor.setThreads( m_threads );
+        visitor.setProfile( m_profile );
         specification->accept( visitor );
+        dotfile->flush();
     }
     catch( ... )
     {
@@ -91,13 +113,79 @@ u1 IRDumpDotPass::run( libpass::PassResult& pr )
     return true;
 }
 
-static inline std::string indention( Value& value );
+void IRDumpDotPass::setPath( const std::string& path )
+{
+    m_path = path;
+}
+
+const std::string& IRDumpDotPass::path( void ) const
+{
+    return m_path;
+}
+
+void IRDumpDotPass::setDescriptor( const int descriptor )
+{
+    m_descriptor = descriptor;
+}
+
+int IRDumpDotPass::descriptor( void ) const
+{
+    return m_descriptor;
+}
+
+void IRDumpDotPass::setThreads( const std::size_t threads )
+{
+    m_threads = threads;
+}
+
+std::size_t IRDumpDotPass::threads( void ) const
+{
+    return m_threads;
+}
+
+void IRDumpDotPass::setProfile( const Profile* profile )
+{
+    m_profile = profile;
+}
+
+const Profile* IRDumpDotPass::profile( void ) const
+{
+    return m_profile;
+}
+
+static inline const char* indention( Value& value );
+
+static void label( Value& value );
+
+IRDumpDotVisitor::IRDumpDotVisitor( Writer& writer )
+: m_writer()
+, m_stream( writer )
+, m_threads( 1 )
+, m_profile( nullptr )
+, m_maximum( 0 )
+{
+}
 
 IRDumpDotVisitor::IRDumpDotVisitor( std::ostream& stream )
-: m_stream( stream )
+: m_writer( std::make_unique< Writer >( stream ) )
+, m_stream( *m_writer )
+, m_threads( 1 )
+, m_profile( nullptr )
+, m_maximum( 0 )
 {
 }
 
+void IRDumpDotVisitor::setThreads( const std::size_t threads )
+{
+    m_threads = threads;
+}
+
+void IRDumpDotVisitor::setProfile( const Profile* profile )
+{
+    m_profile = profile;
+    m_maximum = profile ? profile->maximum() : 0;
+}
+
 //
 // General
 //
@@ -147,13 +235,36 @@ void IRDumpDotVisitor::visit( Specification& value )
         m_stream << "  Rules -> \"" << v.get() << "_B\";\n";
     }
 
-    RecursiveVisitor::visit( value );
+    if( m_threads == 1 )
+    {
+        RecursiveVisitor::visit( value );
+    }
+    else
+    {
+        value.agent()->accept( *this );
+        value.constants().accept( *this );
+        value.builtins().accept( *this );
+        value.functions().accept( *this );
+
+        IRDump::label( value, []( Value& shard ) { label( shard ); } );
+        IRDump::render(
+            value,
+            m_stream,
+            [this]( Value& shard, Writer& writer ) {
+                IRDumpDotVisitor visitor{ writer };
+                visitor.m_profile = m_profile;
+                visitor.m_maximum = m_maximum;
+                shard.accept( visitor );
+            },
+            m_threads );
+    }
 
     m_stream << "}\n";
+    m_stream.flush();
 }
 void IRDumpDotVisitor::visit( Agent& value )
 {
-    m_stream << "  # " << value.dump() << "\n";
+    m_stream << "  # " << describe( value ) << "\n";
 
     m_stream << "  \"" << &value << "\""
              << "  [shape=plaintext, label=<\n"
@@ -176,21 +287,21 @@ void IRDumpDotVisitor::visit( Agent& value )
 }
 void IRDumpDotVisitor::visit( Function& value )
 {
-    m_stream << "  # " << value.dump() << "\n";
+    m_stream << "  # " << describe( value ) << "\n";
 
-    m_stream << "  \"" << &value << "\" [label=\"" << value.dump() << "\"];\n";
+    m_stream << "  \"" << &value << "\" [label=\"" << describe( value ) << "\"];\n";
 }
 void IRDumpDotVisitor::visit( Derived& value )
 {
-    m_stream << "  # " << value.dump() << "\n";
+    m_stream << "  # " << describe( value ) << "\n";
 
-    m_stream << "  \"" << &value << "\" [label=\"" << value.dump() << "\"];\n";
+    m_stream << "  \"" << &value << "\" [label=\"" << describe( value ) << "\"];\n";
 
     RecursiveVisitor::visit( value );
 }
 void IRDumpDotVisitor::visit( Rule& value )
 {
-    m_stream << "  # " << value.dump() << "\n";
+    m_stream << "  # " << describe( value ) << "\n";
 
     m_stream << "  subgraph \"" << &value << "\" { \n"
              << "    label=\"" << value.name() << "\"\n"
@@ -198,10 +309,10 @@ void IRDumpDotVisitor::visit( Rule& value )
 
     // begin (B) and end (E) connection points of the sub-graph
 
-    m_stream << "  \"" << &value << "_B\" [label=\"B: " << value.dump()
+    m_stream << "  \"" << &value << "_B\" [label=\"B: " << describe( value )
              << "\"]\n";  // TODO: , style=invis
 
-    m_stream << "  \"" << &value << "_E\"   [label=\"E: " << value.dump() << "\"]\n";
+    m_stream << "  \"" << &value << "_E\"   [label=\"E: " << describe( value ) << "\"]\n";
 
     m_stream << "  \"" << &value << "_B\" -> \"" << value.context().get() << "_B\"\n";
 
@@ -213,30 +324,30 @@ void IRDumpDotVisitor::visit( Rule& value )
 }
 void IRDumpDotVisitor::visit( Builtin& value )
 {
-    m_stream << "  # " << value.dump() << "\n";
+    m_stream << "  # " << describe( value ) << "\n";
 
-    m_stream << "  \"" << &value << "\" [label=\"" << value.dump() << "\"];\n";
+    m_stream << "  \"" << &value << "\" [label=\"" << describe( value ) << "\"];\n";
 }
 
 void IRDumpDotVisitor::visit( Enumeration& value )
 {
-    m_stream << "  # " << value.dump() << "\n";
+    m_stream << "  # " << describe( value ) << "\n";
 
-    m_stream << "  \"" << &value << "\" [label=\"" << value.dump() << "\"];\n";
+    m_stream << "  \"" << &value << "\" [label=\"" << describe( value ) << "\"];\n";
 }
 
 void IRDumpDotVisitor::visit( Range& value )
 {
-    m_stream << "  # " << value.dump() << "\n";
+    m_stream << "  # " << describe( value ) << "\n";
 
-    m_stream << "  \"" << &value << "\" [label=\"" << value.dump() << "\"];\n";
+    m_stream << "  \"" << &value << "\" [label=\"" << describe( value ) << "\"];\n";
 }
 
 void IRDumpDotVisitor::visit( List& value )
 {
-    m_stream << "  # " << value.dump() << "\n";
+    m_stream << "  # " << describe( value ) << "\n";
 
-    m_stream << "  \"" << &value << "\" [label=\"" << value.dump() << "\"];\n";
+    m_stream << "  \"" << &value << "\" [label=\"" << describe( value ) << "\"];\n";
 }
 
 void IRDumpDotVisitor::visit( ParallelBlock& value )
@@ -274,6 +385,14 @@ void IRDumpDotVisitor::visit( BranchStatement& value )
 
     m_stream << "  }\n";
 }
+void IRDumpDotVisitor::visit( ForallStatement& value )
+{
+    dump( value );
+
+    RecursiveVisitor::visit( value );
+
+    m_stream << "  }\n";
+}
 
 //
 // Instructions
@@ -468,17 +587,17 @@ void IRDumpDotVisitor::visit( Identifier& value )
 
 void IRDumpDotVisitor::dump( ExecutionSemanticsBlock& value ) const
 {
-    m_stream << "  # " << value.dump() << "\n";
+    m_stream << "  # " << describe( value ) << "\n";
 
     m_stream << "  subgraph \"" << &value << "\" {\n"
-             << "    label=\"" << value.dump() << "\"\n";
+             << "    label=\"" << describe( value ) << "\"\n";
 
     // begin (B) and end (E) connection points of the sub-graph
 
-    m_stream << "  \"" << &value << "_B\" [label=\"B: " << value.dump()
+    m_stream << "  \"" << &value << "_B\" [label=\"B: " << describe( value )
              << "\"]\n";  // TODO: , style=invis
 
-    m_stream << "  \"" << &value << "_E\"   [label=\"E: " << value.dump() << "\"]\n";
+    m_stream << "  \"" << &value << "_E\"   [label=\"E: " << describe( value ) << "\"]\n";
 
     m_stream << "  \"" << &value << "_B\" -> \"" << &value << "_E\" [style=dashed, color=gray];\n";
 
@@ -571,17 +690,18 @@ void IRDumpDotVisitor::dump( Statement& value ) const
         }
     }
 
-    m_stream << "  # " << value.dump() << "\n";
+    m_stream << "  # " << describe( value ) << "\n";
 
     m_stream << "  subgraph \"" << &value << "\" {\n"
              << "    label=\"" << label << ": " << scope << "\"\n";
 
     // begin (B) and end (E) connection points of the sub-graph
 
-    m_stream << "  \"" << &value << "_B\" [label=\"B: " << value.dump()
-             << "\"]\n";  // TODO: , style=invis
+    m_stream << "  \"" << &value << "_B\" [label=\"B: " << describe( value ) << "\"";
+    annotate( value );
+    m_stream << "]\n";  // TODO: , style=invis
 
-    m_stream << "  \"" << &value << "_E\"   [label=\"E: " << value.dump() << "\"]\n";
+    m_stream << "  \"" << &value << "_E\"   [label=\"E: " << describe( value ) << "\"]\n";
 
     if( value.scope() )
     {
@@ -595,7 +715,13 @@ void IRDumpDotVisitor::dump( Statement& value ) const
                  << "_B\" [style=dashed, color=blue];\n";
     }
 
-    m_stream << "  \"" << &value << "_B\" -> \"" << value.instructions().front().get() << "\"\n";
+    // the domain of a forall statement can be a constant which requires no
+    // instruction
+    if( value.instructions().size() > 0 )
+    {
+        m_stream << "  \"" << &value << "_B\" -> \"" << value.instructions().front().get()
+                 << "\"\n";
+    }
 
     for( auto instr : value.instructions() )
     {
@@ -609,10 +735,12 @@ void IRDumpDotVisitor::dump( Statement& value ) const
 
 void IRDumpDotVisitor::dump( Instruction& value ) const
 {
-    m_stream << "  # " << value.dump() << "\n";
+    m_stream << "  # " << describe( value ) << "\n";
 
-    m_stream << "  \"" << &value << "\" [shape=box, color=red, label=\"" << value.dump()
-             << "\"];\n";
+    m_stream << "  \"" << &value << "\" [shape=box, color=red, label=\"" << describe( value )
+             << "\"";
+    annotate( value );
+    m_stream << "];\n";
 
     if( isa< ForkInstruction >( value ) or isa< MergeInstruction >( value ) )
     {
@@ -621,48 +749,118 @@ void IRDumpDotVisitor::dump( Instruction& value ) const
     }
     else
     {
-        std::string tmp = "";
-        u1 first = true;
+        m_stream << "  #" << indention( value ) << value.label() << " = " << value.name() << " ";
 
-        for( auto operand : value.operands() )
+        u1 first = true;
+        for( const auto& operand : value.operands() )
         {
             if( not first )
             {
-                tmp += ", ";
+                m_stream << ", ";
             }
             else
             {
                 first = false;
             }
 
-            tmp += operand->type().name();
-            tmp += " ";
-            tmp += operand->label();
+            m_stream << name( operand->type() ) << " " << operand->label();
         }
 
-        std::string uses = "{";
-        for( auto u : value.uses() )
+        m_stream << "                 ;; uses = {";
+        for( const auto& u : value.uses() )
         {
-            uses += u->use().label();
-            uses += " : ";
-            uses += u->use().name();
-            uses += ", ";
+            m_stream << u.use().label() << " : " << u.use().name() << ", ";
         }
-        uses += "}";
+        m_stream << "}\n";
+    }
+}
 
-        m_stream << "  #" << indention( value ) << value.label() << " = " << value.name() << " "
-                 << tmp << "                 ;; uses = " << uses << "\n";
+void IRDumpDotVisitor::annotate( const Value& value ) const
+{
+    if( not m_profile )
+    {
+        return;
     }
+
+    const auto annotation = m_profile->annotation( value, m_maximum );
+    if( annotation.empty() )
+    {
+        return;
+    }
+
+    // white (cold) to red (hot) in the HSV color space of graphviz
+    std::ostringstream color;
+    color << std::fixed << std::setprecision( 3 ) << "0.000 "
+          << m_profile->heat( value, m_maximum ) << " 1.000";
+
+    m_stream << ", style=filled, fillcolor=\"" << color.str() << "\", tooltip=\"" << annotation
+             << "\"";
 }
 
 void IRDumpDotVisitor::dump( Constant& value ) const
 {
-    m_stream << "  # " << value.dump() << "\n";
+    m_stream << "  # " << describe( value ) << "\n";
 
-    m_stream << "  \"" << &value << "\" [label=\"" << value.dump() << "\"];\n";
+    m_stream << "  \"" << &value << "\" [label=\"" << describe( value ) << "\"];\n";
 }
 
-static inline std::string indention( Value& value )
+const std::string& IRDumpDotVisitor::name( const Type& type ) const
+{
+    auto result = m_typeNames.find( &type );
+    if( result == m_typeNames.end() )
+    {
+        result = m_typeNames.emplace( &type, type.name() ).first;
+    }
+
+    return result->second;
+}
+
+namespace libcasm_ir
+{
+    Writer& operator<<( Writer& writer, const IRDumpDotVisitor::Description& description )
+    {
+        const auto& visitor = description.visitor;
+        const auto& value = description.value;
+
+        writer << "[" << visitor.name( value.type() ) << "] ";
+
+        if( not value.type().isVoid() )
+        {
+            writer << value.label() << " = ";
+        }
+
+        if( isa< Constant >( value ) or isa< Builtin >( value ) or isa< Function >( value ) )
+        {
+            writer << visitor.name( value.type() ) << " ";
+        }
+
+        if( not isa< Function >( value ) )
+        {
+            writer << value.name();
+        }
+
+        if( const auto instr = cast< Instruction >( value ) )
+        {
+            if( isa< ForkInstruction >( value ) or isa< MergeInstruction >( value ) )
+            {
+                writer << " " << instr->statement()->scope()->name();
+            }
+
+            u1 first = true;
+            for( const auto& operand : instr->operands() )
+            {
+                writer << ( first ? " " : ", " );
+                first = false;
+
+                writer << visitor.name( operand->type() ) << " " << operand->label();
+            }
+        }
+
+        return writer;
+    }
+}
+
+static inline const char* indention( Value& value )
 {
 #define INDENT "  "
 
@@ -680,6 +878,105 @@ static inline std::string indention( Value& value )
     }
 }
 
+/**
+   requests the labels of the description of a value
+*/
+static void labelDescription( const Value& value )
+{
+    if( not value.type().isVoid() )
+    {
+        value.label();
+    }
+
+    if( const auto instruction = cast< Instruction >( value ) )
+    {
+        for( const auto& operand : instruction->operands() )
+        {
+            operand->label();
+        }
+    }
+}
+
+/**
+   requests the labels of a value and its children in the same order as
+   the visitor dumps them
+*/
+static void label( Value& value )
+{
+    if( isa< Derived >( value ) )
+    {
+        labelDescription( value );
+        label( *static_cast< Derived& >( value ).context() );
+    }
+    else if( isa< Rule >( value ) )
+    {
+        labelDescription( value );
+        label( *static_cast< Rule& >( value ).context() );
+    }
+    else if( isa< ExecutionSemanticsBlock >( value ) )
+    {
+        auto& block = static_cast< ExecutionSemanticsBlock& >( value );
+
+        labelDescription( block );
+        label( *block.entry() );
+        for( const auto& child : block.blocks() )
+        {
+            label( *child );
+        }
+        label( *block.exit() );
+    }
+    else if( isa< Statement >( value ) )
+    {
+        auto& statement = static_cast< Statement& >( value );
+        const auto scope = statement.scope();
+
+        statement.label();
+        scope->label();
+        if( scope->entry().get() == &statement or scope->exit().get() == &statement )
+        {
+            if( scope->scope() )
+            {
+                scope->scope()->label();
+            }
+        }
+        labelDescription( statement );
+
+        for( const auto& instruction : statement.instructions() )
+        {
+            label( *instruction );
+        }
+
+        if( not isa< TrivialStatement >( statement ) )
+        {
+            for( const auto& child : statement.blocks() )
+            {
+                label( *child );
+            }
+        }
+    }
+    else if( isa< Instruction >( value ) )
+    {
+        labelDescription( value );
+
+        if( isa< ForkInstruction >( value ) or isa< MergeInstruction >( value ) )
+        {
+            return;
+        }
+
+        auto& instruction = static_cast< Instruction& >( value );
+
+        instruction.label();
+        for( const auto& operand : instruction.operands() )
+        {
+            operand->label();
+        }
+        for( const auto& u : instruction.uses() )
+        {
+            u.use().label();
+        }
+    }
+}
+
 //
 //  Local variables:
 //  mode: c++
@@ -42,11 +42,15 @@
 #ifndef _LIBCASM_IR_IR_DUMP_DOT_PASS_H_
 #define _LIBCASM_IR_IR_DUMP_DOT_PASS_H_
 
+#include <libcasm-ir/Profile>
 #include <libcasm-ir/Specification>
+#include <libcasm-ir/Writer>
+#include <libcasm-ir/transform/IRDump>
 
 #include <libpass/Pass>
 
 #include <fstream>
+#include <unordered_map>
 #include <unordered_set>
 
 /**
@@ -62,16 +66,59 @@ namespace libcasm_ir
       public:
         static char id;
 
+        IRDumpDotPass( void );
+
         void usage( libpass::PassUsage& pu ) override;
 
         u1 run( libpass::PassResult& pr ) override;
+
+        void setPath( const std::string& path );
+
+        const std::string& path( void ) const;
+
+        /**
+           dumps to an already opened file descriptor, a negative descriptor
+           selects the path again
+        */
+        void setDescriptor( const int descriptor );
+
+        int descriptor( void ) const;
+
+        /**
+           renders the deriveds and rules on the given number of threads,
+           zero selects the hardware concurrency, the output is the same as
+           with one thread
+        */
+        void setThreads( const std::size_t threads );
+
+        std::size_t threads( void ) const;
+
+        /**
+           annotates the instructions and branches with their heat in the
+           given profile, a null pointer disables the annotation
+        */
+        void setProfile( const Profile* profile );
+
+        const Profile* profile( void ) const;
+
+      private:
+        std::string m_path;
+        int m_descriptor;
+        std::size_t m_threads;
+        const Profile* m_profile;
     };
 
     class IRDumpDotVisitor final : public RecursiveVisitor
     {
       public:
+        IRDumpDotVisitor( Writer& writer );
+
         IRDumpDotVisitor( std::ostream& stream );
 
+        void setThreads( const std::size_t threads );
+
+        void setProfile( const Profile* profile );
+
         //
         // General
         //
@@ -92,6 +139,7 @@ namespace libcasm_ir
 
         void visit( TrivialStatement& value ) override;
         void visit( BranchStatement& value ) override;
+        void visit( ForallStatement& value ) override;
 
         //
         // Instructions
@@ -161,8 +209,36 @@ namespace libcasm_ir
         void dump( Instruction& value ) const;
         void dump( Constant& value ) const;
 
-        std::ostream& m_stream;
+        /**
+           fills the node of an instruction or branch by its heat
+        */
+        void annotate( const Value& value ) const;
+
+        /**
+           renders the same text as Value::dump directly into the writer
+        */
+        struct Description
+        {
+            const IRDumpDotVisitor& visitor;
+            const Value& value;
+        };
+
+        Description describe( const Value& value ) const
+        {
+            return Description{ *this, value };
+        }
+
+        friend Writer& operator<<( Writer& writer, const Description& description );
+
+        const std::string& name( const Type& type ) const;
+
+        std::unique_ptr< Writer > m_writer;
+        Writer& m_stream;
+        std::size_t m_threads;
+        const Profile* m_profile;
+        u64 m_maximum;
         std::unordered_set< u8 > m_first;
+        mutable std::unordered_map< const Type*, std::string > m_typeNames;
     };
 }
 
@@ -59,6 +59,14 @@ static libpass::PassRegistration< IRDumpSourcePass > PASS(
     "ir-dump",
     0 );
 
+IRDumpSourcePass::IRDumpSourcePass( void )
+: m_path()
+, m_descriptor( -1 )
+, m_threads( 1 )
+, m_profile( nullptr )
+{
+}
+
 void IRDumpSourcePass::usage( libpass::PassUsage& pu )
 {
     pu.require< ConsistencyCheckPass >();
@@ -71,19 +79,110 @@ u1 IRDumpSourcePass::run( libpass::PassResult& pr )
     const auto& data = pr.input< ConsistencyCheckPass >();
     const auto& specification = data->specification();
 
-    IRDumpSourceVisitor visitor{ std::cout };
-    data->specification()->accept( visitor );
+    try
+    {
+        std::unique_ptr< Writer > writer;
+        if( m_descriptor >= 0 )
+        {
+            writer = std::make_unique< Writer >( m_descriptor );
+        }
+        else if( not m_path.empty() )
+        {
+            writer = Writer::file( m_path );
+        }
+        else
+        {
+            writer = std::make_unique< Writer >( std::cout );
+        }
+
+        IRDumpSourceVisitor visitor{ *writer };
+        visitor.setThreads( m_threads );
+        visitor.setProfile( m_profile );
+        specification->accept( visitor );
+        writer->flush();
+    }
+    catch( const std::domain_error& e )
+    {
+        log.error( "unsuccessful dump of specification: " + std::string( e.what() ) );
+        return false;
+    }
 
     return true;
 }
 
-static inline std::string indention( Value& value );
+void IRDumpSourcePass::setPath( const std::string& path )
+{
+    m_path = path;
+}
+
+const std::string& IRDumpSourcePass::path( void ) const
+{
+    return m_path;
+}
+
+void IRDumpSourcePass::setDescriptor( const int descriptor )
+{
+    m_descriptor = descriptor;
+}
+
+int IRDumpSourcePass::descriptor( void ) const
+{
+    return m_descriptor;
+}
+
+void IRDumpSourcePass::setThreads( const std::size_t threads )
+{
+    m_threads = threads;
+}
+
+std::size_t IRDumpSourcePass::threads( void ) const
+{
+    return m_threads;
+}
+
+void IRDumpSourcePass::setProfile( const Profile* profile )
+{
+    m_profile = profile;
+}
+
+const Profile* IRDumpSourcePass::profile( void ) const
+{
+    return m_profile;
+}
+
+static inline const char* indention( Value& value );
+
+static void label( Value& value );
+
+IRDumpSourceVisitor::IRDumpSourceVisitor( Writer& writer )
+: m_writer()
+, m_stream( writer )
+, m_threads( 1 )
+, m_profile( nullptr )
+, m_maximum( 0 )
+{
+}
 
 IRDumpSourceVisitor::IRDumpSourceVisitor( std::ostream& stream )
-: m_stream( stream )
+: m_writer( std::make_unique< Writer >( stream ) )
+, m_stream( *m_writer )
+, m_threads( 1 )
+, m_profile( nullptr )
+, m_maximum( 0 )
 {
 }
 
+void IRDumpSourceVisitor::setThreads( const std::size_t threads )
+{
+    m_threads = threads;
+}
+
+void IRDumpSourceVisitor::setProfile( const Profile* profile )
+{
+    m_profile = profile;
+    m_maximum = profile ? profile->maximum() : 0;
+}
+
 //
 // General
 //
@@ -92,9 +191,32 @@ void IRDumpSourceVisitor::visit( Specification& value )
 {
     m_stream << ";; " << value.name() << "\n";
 
-    RecursiveVisitor::visit( value );
+    if( m_threads == 1 )
+    {
+        RecursiveVisitor::visit( value );
+    }
+    else
+    {
+        value.agent()->accept( *this );
+        value.constants().accept( *this );
+        value.builtins().accept( *this );
+        value.functions().accept( *this );
+
+        IRDump::label( value, []( Value& shard ) { label( shard ); } );
+        IRDump::render(
+            value,
+            m_stream,
+            [this]( Value& shard, Writer& writer ) {
+                IRDumpSourceVisitor visitor{ writer };
+                visitor.m_profile = m_profile;
+                visitor.m_maximum = m_maximum;
+                shard.accept( visitor );
+            },
+            m_threads );
+    }
 
     m_stream << "\n";
+    m_stream.flush();
 }
 void IRDumpSourceVisitor::visit( Agent& value )
 {
@@ -105,7 +227,7 @@ void IRDumpSourceVisitor::visit( Agent& value )
         m_stream << "\n";
     }
 
-    m_stream << value.name() << " = " << value.type().name();
+    m_stream << value.name() << " = " << name( value.type() );
 
     m_stream << "\n";
 }
@@ -118,12 +240,12 @@ void IRDumpSourceVisitor::visit( Function& value )
         m_stream << "\n";
     }
 
-    m_stream << value.name() << " = " << value.type().name() << "\n";
+    m_stream << value.name() << " = " << name( value.type() ) << "\n";
 }
 void IRDumpSourceVisitor::visit( Derived& value )
 {
     m_stream << "\n"
-             << value.name() << " " << value.type().name() << " =\n"
+             << value.name() << " " << name( value.type() ) << " =\n"
              << "[\n";
 
     RecursiveVisitor::visit( value );
@@ -133,7 +255,7 @@ void IRDumpSourceVisitor::visit( Derived& value )
 void IRDumpSourceVisitor::visit( Rule& value )
 {
     m_stream << "\n"
-             << value.name() << " " << value.type().name() << " =\n"
+             << value.name() << " " << name( value.type() ) << " =\n"
              << "{\n";
 
     RecursiveVisitor::visit( value );
@@ -149,7 +271,7 @@ void IRDumpSourceVisitor::visit( Builtin& value )
         m_stream << "\n";
     }
 
-    m_stream << value.label() << " = " << value.type().name() << " " << value.name() << "\n";
+    m_stream << value.label() << " = " << name( value.type() ) << " " << value.name() << "\n";
 }
 
 void IRDumpSourceVisitor::visit( Enumeration& value )
@@ -177,6 +299,18 @@ void IRDumpSourceVisitor::visit( BranchStatement& value )
     dump( value );
     RecursiveVisitor::visit( value );
 }
+void IRDumpSourceVisitor::visit( ForallStatement& value )
+{
+    dump( value );
+    value.instructions().accept( *this );
+
+    const auto& variable = *value.variable();
+    const auto& domain = *value.domain();
+    m_stream << "    forall " << name( variable.type() ) << " " << variable.label() << " in "
+             << name( domain.type() ) << " " << domain.label() << "\n";
+
+    value.blocks().accept( *this );
+}
 
 //
 // Instructions
@@ -403,7 +537,9 @@ void IRDumpSourceVisitor::dump( Statement& value ) const
         }
     }
 
-    m_stream << nline << indention( value ) << label << ": " << scope << "\n";
+    m_stream << nline << indention( value ) << label << ": " << scope;
+    annotate( value, "    ;; " );
+    m_stream << "\n";
 }
 
 void IRDumpSourceVisitor::dump( Instruction& value ) const
@@ -415,40 +551,62 @@ void IRDumpSourceVisitor::dump( Instruction& value ) const
     }
     else
     {
-        std::string tmp = "";
-        u1 first = true;
+        // labels are assigned on first request, therefore the operands and
+        // uses are labeled before the instruction itself
+        for( const auto& operand : value.operands() )
+        {
+            operand->label();
+        }
+        for( const auto& u : value.uses() )
+        {
+            u.use().label();
+        }
 
-        for( auto operand : value.operands() )
+        m_stream << indention( value );
+        if( not value.type().isVoid() )
+        {
+            m_stream << value.label() << " = ";
+        }
+
+        m_stream << value.name() << " ";
+
+        u1 first = true;
+        for( const auto& operand : value.operands() )
         {
             if( not first )
             {
-                tmp += ", ";
+                m_stream << ", ";
             }
             else
             {
                 first = false;
             }
 
-            tmp += operand->type().name();
-            tmp += " ";
-            tmp += operand->label();
+            m_stream << name( operand->type() ) << " " << operand->label();
         }
 
-        std::string uses = "{";
-        for( auto u : value.uses() )
+        m_stream << "    ;; uses = {";
+        for( const auto& u : value.uses() )
         {
-            uses += u->use().label();
-            uses += ", ";
+            m_stream << u.use().label() << ", ";
         }
-        uses += "}";
+        m_stream << "}";
+        annotate( value, ", " );
+        m_stream << "\n";
+    }
+}
 
-        m_stream << indention( value );
-        if( not value.type().isVoid() )
-        {
-            m_stream << value.label() << " = ";
-        }
+void IRDumpSourceVisitor::annotate( const Value& value, const char* separator ) const
+{
+    if( not m_profile )
+    {
+        return;
+    }
 
-        m_stream << value.name() << " " << tmp << "    ;; uses = " << uses << "\n";
+    const auto annotation = m_profile->annotation( value, m_maximum );
+    if( not annotation.empty() )
+    {
+        m_stream << separator << annotation;
     }
 }
 
@@ -463,10 +621,21 @@ void IRDumpSourceVisitor::dump( Constant& value ) const
         m_stream << "\n";
     }
 
-    m_stream << value.label() << " = " << value.type().name() << " " << value.name() << "\n";
+    m_stream << value.label() << " = " << name( value.type() ) << " " << value.name() << "\n";
 }
 
-static inline std::string indention( Value& value )
+const std::string& IRDumpSourceVisitor::name( const Type& type ) const
+{
+    auto result = m_typeNames.find( &type );
+    if( result == m_typeNames.end() )
+    {
+        result = m_typeNames.emplace( &type, type.name() ).first;
+    }
+
+    return result->second;
+}
+
+static inline const char* indention( Value& value )
 {
 #define INDENT "  "
 
@@ -484,6 +653,89 @@ static inline std::string indention( Value& value )
     }
 }
 
+/**
+   requests the labels of a value and its children in the same order as
+   the visitor dumps them
+*/
+static void label( Value& value )
+{
+    if( isa< Derived >( value ) )
+    {
+        label( *static_cast< Derived& >( value ).context() );
+    }
+    else if( isa< Rule >( value ) )
+    {
+        label( *static_cast< Rule& >( value ).context() );
+    }
+    else if( isa< ExecutionSemanticsBlock >( value ) )
+    {
+        auto& block = static_cast< ExecutionSemanticsBlock& >( value );
+
+        label( *block.entry() );
+        for( const auto& child : block.blocks() )
+        {
+            label( *child );
+        }
+        label( *block.exit() );
+    }
+    else if( isa< Statement >( value ) )
+    {
+        auto& statement = static_cast< Statement& >( value );
+        const auto scope = statement.scope();
+
+        statement.label();
+        scope->label();
+        if( scope->entry().get() == &statement or scope->exit().get() == &statement )
+        {
+            if( scope->scope() )
+            {
+                scope->scope()->label();
+            }
+        }
+
+        for( const auto& instruction : statement.instructions() )
+        {
+            label( *instruction );
+        }
+
+        if( const auto forall = cast< ForallStatement >( statement ) )
+        {
+            forall->variable()->label();
+            forall->domain()->label();
+        }
+
+        if( not isa< TrivialStatement >( statement ) )
+        {
+            for( const auto& child : statement.blocks() )
+            {
+                label( *child );
+            }
+        }
+    }
+    else if( isa< Instruction >( value ) )
+    {
+        if( isa< ForkInstruction >( value ) or isa< MergeInstruction >( value ) )
+        {
+            return;
+        }
+
+        auto& instruction = static_cast< Instruction& >( value );
+
+        for( const auto& operand : instruction.operands() )
+        {
+            operand->label();
+        }
+        for( const auto& u : instruction.uses() )
+        {
+            u.use().label();
+        }
+        if( not instruction.type().isVoid() )
+        {
+            instruction.label();
+        }
+    }
+}
+
 //
 //  Local variables:
 //  mode: c++
@@ -0,0 +1,894 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "IRSerializePass.h"
+
+#include <libcasm-ir/Exception>
+#include <libcasm-ir/Specification>
+#include <libcasm-ir/analyze/ConsistencyCheckPass>
+
+#include <libpass/PassLogger>
+#include <libpass/PassRegistry>
+#include <libpass/PassResult>
+#include <libpass/PassUsage>
+
+#include <fstream>
+
+using namespace libcasm_ir;
+
+//
+//
+// IRBinary
+//
+
+void IRBinary::Buffer::put( const u8 value )
+{
+    m_bytes.emplace_back( value );
+}
+
+void IRBinary::Buffer::putFixed( const u64 value, const std::size_t bytes )
+{
+    assert( bytes <= sizeof( u64 ) );
+
+    for( std::size_t i = 0; i < bytes; i++ )
+    {
+        put( ( u8 )( value >> ( 8 * i ) ) );
+    }
+}
+
+void IRBinary::Buffer::putVarint( u64 value )
+{
+    while( value >= 0x80 )
+    {
+        put( ( u8 )( ( value & 0x7f ) | 0x80 ) );
+        value >>= 7;
+    }
+
+    put( (u8)value );
+}
+
+void IRBinary::Buffer::putBytes( const void* data, const std::size_t size )
+{
+    const auto bytes = static_cast< const u8* >( data );
+    m_bytes.insert( m_bytes.end(), bytes, bytes + size );
+}
+
+void IRBinary::Buffer::putBuffer( const Buffer& buffer )
+{
+    m_bytes.insert( m_bytes.end(), buffer.m_bytes.begin(), buffer.m_bytes.end() );
+}
+
+const std::vector< u8 >& IRBinary::Buffer::bytes( void ) const
+{
+    return m_bytes;
+}
+
+std::size_t IRBinary::Buffer::size( void ) const
+{
+    return m_bytes.size();
+}
+
+IRBinary::Cursor::Cursor( const u8* data, const std::size_t size, const std::size_t offset )
+: m_data( data )
+, m_size( size )
+, m_offset( offset )
+{
+}
+
+u8 IRBinary::Cursor::get( void )
+{
+    if( m_offset >= m_size )
+    {
+        throw InternalException(
+            "unexpected end of binary IR at offset " + std::to_string( m_offset ) );
+    }
+
+    return m_data[ m_offset++ ];
+}
+
+u64 IRBinary::Cursor::getFixed( const std::size_t bytes )
+{
+    assert( bytes <= sizeof( u64 ) );
+
+    u64 value = 0;
+    for( std::size_t i = 0; i < bytes; i++ )
+    {
+        value |= ( (u64)get() ) << ( 8 * i );
+    }
+
+    return value;
+}
+
+u64 IRBinary::Cursor::getVarint( void )
+{
+    u64 value = 0;
+
+    for( u32 shift = 0; shift < 64; shift += 7 )
+    {
+        const auto byte = get();
+        value |= ( (u64)( byte & 0x7f ) ) << shift;
+
+        if( ( byte & 0x80 ) == 0 )
+        {
+            return value;
+        }
+    }
+
+    throw InternalException(
+        "malformed integer in binary IR at offset " + std::to_string( m_offset ) );
+}
+
+u64 IRBinary::Cursor::getCount( const std::size_t size )
+{
+    assert( size > 0 );
+
+    const auto count = getVarint();
+    if( count > remaining() / size )
+    {
+        throw InternalException(
+            "invalid count " + std::to_string( count ) + " in binary IR at offset " +
+            std::to_string( m_offset ) );
+    }
+
+    return count;
+}
+
+const u8* IRBinary::Cursor::getBytes( const std::size_t size )
+{
+    if( size > m_size or m_offset > m_size - size )
+    {
+        throw InternalException(
+            "unexpected end of binary IR at offset " + std::to_string( m_offset ) );
+    }
+
+    const auto bytes = m_data + m_offset;
+    m_offset += size;
+    return bytes;
+}
+
+void IRBinary::Cursor::seek( const std::size_t offset )
+{
+    m_offset = offset;
+}
+
+std::size_t IRBinary::Cursor::offset( void ) const
+{
+    return m_offset;
+}
+
+std::size_t IRBinary::Cursor::remaining( void ) const
+{
+    return m_offset < m_size ? m_size - m_offset : 0;
+}
+
+//
+//
+// IRSerializePass
+//
+
+char IRSerializePass::id = 0;
+
+static libpass::PassRegistration< IRSerializePass > PASS(
+    "IRSerializePass", "serializes the CASM IR to the binary IR format", "ir-serialize", 0 );
+
+IRSerializePass::IRSerializePass( void )
+: m_path( "./obj/out.ir.bin" )
+{
+}
+
+void IRSerializePass::usage( libpass::PassUsage& pu )
+{
+    pu.require< ConsistencyCheckPass >();
+}
+
+u1 IRSerializePass::run( libpass::PassResult& pr )
+{
+    libpass::PassLogger log( &id, stream() );
+
+    const auto& data = pr.input< ConsistencyCheckPass >();
+    const auto& specification = data->specification();
+
+    std::vector< u8 > bytes;
+
+    try
+    {
+        IRSerializer serializer( specification );
+        bytes = serializer.serialize();
+    }
+    catch( const InternalException& e )
+    {
+        log.error( "unsuccessful serialization of specification: " + std::string( e.what() ) );
+        return false;
+    }
+
+    std::ofstream file( m_path, std::ios::out | std::ios::binary | std::ios::trunc );
+    if( not file )
+    {
+        log.error( "unable to open '" + m_path + "'" );
+        return false;
+    }
+
+    file.write( reinterpret_cast< const char* >( bytes.data() ), bytes.size() );
+
+    return true;
+}
+
+void IRSerializePass::setPath( const std::string& path )
+{
+    m_path = path;
+}
+
+const std::string& IRSerializePass::path( void ) const
+{
+    return m_path;
+}
+
+//
+//
+// IRSerializer
+//
+
+IRSerializer::IRSerializer( const Specification::Ptr& specification )
+: m_specification( specification )
+, m_statement( nullptr )
+{
+    assert( m_specification );
+}
+
+std::vector< u8 > IRSerializer::serialize( void )
+{
+    // builtins and functions of the specification are interned first to
+    // restore their positions, references to other ones are appended later
+
+    for( const auto& builtin : m_specification->builtins() )
+    {
+        internBuiltin( *builtin );
+    }
+
+    for( const auto& function : m_specification->functions() )
+    {
+        internFunction( *function );
+    }
+
+    for( const auto& derived : m_specification->deriveds() )
+    {
+        m_derivedIndex.emplace( derived.get(), m_derivedIndex.size() );
+    }
+
+    for( const auto& rule : m_specification->rules() )
+    {
+        m_ruleIndex.emplace( rule.get(), m_ruleIndex.size() );
+    }
+
+    std::vector< std::pair< u64, u64 > > derivedBodies;
+    for( const auto& derived : m_specification->deriveds() )
+    {
+        const auto offset = m_code.size();
+        m_locals.clear();
+        m_statement = nullptr;
+
+        if( const auto context = derived->context() )
+        {
+            encode( m_code, static_cast< Block& >( *context ) );
+        }
+
+        derivedBodies.emplace_back( offset, m_code.size() - offset );
+    }
+
+    std::vector< std::pair< u64, u64 > > ruleBodies;
+    for( const auto& rule : m_specification->rules() )
+    {
+        const auto offset = m_code.size();
+        m_locals.clear();
+        m_statement = nullptr;
+
+        if( const auto context = rule->context() )
+        {
+            encode( m_code, static_cast< Block& >( *context ) );
+        }
+
+        ruleBodies.emplace_back( offset, m_code.size() - offset );
+    }
+
+    IRBinary::Buffer globals;
+
+    globals.putVarint( internString( m_specification->name() ) );
+
+    const auto agent = m_specification->agent();
+    globals.put( agent ? 1 : 0 );
+    if( agent )
+    {
+        globals.putVarint( internType( agent->type() ) );
+    }
+
+    globals.putVarint( m_specification->types().size() );
+    for( const auto& type : m_specification->types() )
+    {
+        globals.putVarint( internType( *type ) );
+    }
+
+    globals.putVarint( m_specification->constants().size() );
+    for( const auto& constant : m_specification->constants() )
+    {
+        globals.putVarint( internConstant( *constant ) );
+    }
+
+    globals.putVarint( derivedBodies.size() );
+    std::size_t position = 0;
+    for( const auto& derived : m_specification->deriveds() )
+    {
+        globals.putVarint( internString( derived->name() ) );
+        globals.putVarint( internType( derived->type() ) );
+        globals.putVarint( derivedBodies[ position ].first );
+        globals.putVarint( derivedBodies[ position ].second );
+        position++;
+    }
+
+    globals.putVarint( ruleBodies.size() );
+    position = 0;
+    for( const auto& rule : m_specification->rules() )
+    {
+        globals.putVarint( internString( rule->name() ) );
+        globals.putVarint( internType( rule->type() ) );
+        globals.putVarint( rule->parameters().size() );
+        for( const auto& parameter : rule->parameters() )
+        {
+            globals.putVarint( internConstant( *parameter ) );
+        }
+        globals.putVarint( ruleBodies[ position ].first );
+        globals.putVarint( ruleBodies[ position ].second );
+        position++;
+    }
+
+    globals.putVarint( m_builtinIndex.size() );
+    globals.putVarint( m_specification->builtins().size() );
+    globals.putBuffer( m_builtins );
+
+    globals.putVarint( m_functionIndex.size() );
+    globals.putVarint( m_specification->functions().size() );
+    globals.putBuffer( m_functions );
+
+    IRBinary::Buffer strings;
+    strings.putFixed( m_stringOffsets.size(), 8 );
+    for( const auto offset : m_stringOffsets )
+    {
+        strings.putFixed( offset, 8 );
+    }
+    strings.putBuffer( m_strings );
+
+    IRBinary::Buffer types;
+    types.putVarint( m_typeRecordIndex.size() );
+    types.putBuffer( m_types );
+
+    IRBinary::Buffer constants;
+    constants.putFixed( m_constantOffsets.size(), 8 );
+    for( const auto offset : m_constantOffsets )
+    {
+        constants.putFixed( offset, 8 );
+    }
+    constants.putBuffer( m_constants );
+
+    const IRBinary::Buffer* sections[ IRBinary::Section::_SECTION_SIZE_ ] = {
+        &strings, &types, &constants, &globals, &m_code
+    };
+
+    IRBinary::Buffer file;
+    file.putFixed( IRBinary::MAGIC, 4 );
+    file.putFixed( IRBinary::VERSION_MAJOR, 2 );
+    file.putFixed( IRBinary::VERSION_MINOR, 2 );
+
+    u64 offset = IRBinary::HEADER_SIZE;
+    for( const auto section : sections )
+    {
+        file.putFixed( offset, 8 );
+        file.putFixed( section->size(), 8 );
+        offset += section->size();
+    }
+
+    for( const auto section : sections )
+    {
+        file.putBuffer( *section );
+    }
+
+    assert( file.size() == offset );
+    return file.bytes();
+}
+
+u64 IRSerializer::internString( const std::string& value )
+{
+    const auto result = m_stringIndex.find( value );
+    if( result != m_stringIndex.end() )
+    {
+        return result->second;
+    }
+
+    const u64 index = m_stringOffsets.size();
+    m_stringOffsets.emplace_back( m_strings.size() );
+    m_strings.putVarint( value.size() );
+    m_strings.putBytes( value.data(), value.size() );
+
+    m_stringIndex.emplace( value, index );
+    return index;
+}
+
+u64 IRSerializer::internType( const Type& type )
+{
+    const auto result = m_typeIndex.find( &type );
+    if( result != m_typeIndex.end() )
+    {
+        return result->second;
+    }
+
+    // all referenced types are interned before the record of this type is
+    // emitted, therefore a type only refers to types with smaller indices
+
+    IRBinary::Buffer record;
+    record.put( (u8)type.kind() );
+
+    switch( type.kind() )
+    {
+        case Type::Kind::VOID:      // [fallthrough]
+        case Type::Kind::LABEL:     // [fallthrough]
+        case Type::Kind::LOCATION:  // [fallthrough]
+        case Type::Kind::BOOLEAN:   // [fallthrough]
+        case Type::Kind::RATIONAL:  // [fallthrough]
+        case Type::Kind::DECIMAL:   // [fallthrough]
+        case Type::Kind::STRING:
+        {
+            break;
+        }
+        case Type::Kind::RELATION:  // [fallthrough]
+        case Type::Kind::TUPLE:
+        {
+            if( type.isRelation() )
+            {
+                record.putVarint( internType( type.result() ) );
+            }
+            record.putVarint( type.arguments().size() );
+            for( const auto& argument : type.arguments() )
+            {
+                record.putVarint( internType( *argument ) );
+            }
+            break;
+        }
+        case Type::Kind::RECORD:
+        {
+            const auto& recordType = static_cast< const RecordType& >( type );
+            record.putVarint( type.arguments().size() );
+            for( const auto& argument : type.arguments() )
+            {
+                record.putVarint( internType( *argument ) );
+            }
+            for( const auto& identifier : recordType.identifiers() )
+            {
+                record.putVarint( internString( identifier ) );
+            }
+            break;
+        }
+        case Type::Kind::INTEGER:
+        {
+            const auto& integerType = static_cast< const IntegerType& >( type );
+            const auto range = integerType.range();
+            record.put( range ? 1 : 0 );
+            if( range )
+            {
+                record.putVarint( internType( *range ) );
+            }
+            break;
+        }
+        case Type::Kind::BINARY:
+        {
+            record.putVarint( static_cast< const BinaryType& >( type ).bitsize() );
+            break;
+        }
+        case Type::Kind::ENUMERATION:
+        {
+            const auto& kind = static_cast< const EnumerationType& >( type ).kind();
+            record.putVarint( internString( kind.name() ) );
+            record.putVarint( kind.elements().size() );
+            for( const auto& element : kind.elements() )
+            {
+                record.putVarint( internString( element ) );
+            }
+            break;
+        }
+        case Type::Kind::RANGE:
+        {
+            const auto range = static_cast< const RangeType& >( type ).ptr_range();
+            record.put( range ? 1 : 0 );
+            if( range )
+            {
+                if( not isa< Constant >( range->from() ) or not isa< Constant >( range->to() ) )
+                {
+                    throw InternalException( "unable to serialize non-constant range '" +
+                                             type.description() + "'" );
+                }
+
+                record.putVarint(
+                    internConstant( static_cast< const Constant& >( *range->from() ) ) );
+                record.putVarint(
+                    internConstant( static_cast< const Constant& >( *range->to() ) ) );
+            }
+            else
+            {
+                record.putVarint( internType( type.result() ) );
+            }
+            break;
+        }
+        case Type::Kind::LIST:
+        {
+            record.putVarint( internType( type.result() ) );
+            break;
+        }
+        case Type::Kind::OBJECT:
+        {
+            record.putVarint( internString( type.name() ) );
+            break;
+        }
+        case Type::Kind::RULE_REFERENCE:  // [fallthrough]
+        case Type::Kind::FUNCTION_REFERENCE:
+        {
+            const auto& referenceType = static_cast< const ReferenceType& >( type );
+            record.putVarint( internType( *referenceType.dereference() ) );
+            break;
+        }
+        default:
+        {
+            throw InternalException(
+                "unable to serialize unsupported type '" + type.description() + "'" );
+        }
+    }
+
+    // structurally equal types share one entry
+
+    const std::string key( record.bytes().begin(), record.bytes().end() );
+    const auto entry = m_typeRecordIndex.find( key );
+    if( entry != m_typeRecordIndex.end() )
+    {
+        m_typeIndex.emplace( &type, entry->second );
+        return entry->second;
+    }
+
+    const u64 index = m_typeRecordIndex.size();
+    m_types.putBuffer( record );
+
+    m_typeRecordIndex.emplace( key, index );
+    m_typeIndex.emplace( &type, index );
+    return index;
+}
+
+u64 IRSerializer::internConstant( const Constant& constant )
+{
+    // constants are pooled by their encoding, equal constants share one entry
+
+    IRBinary::Buffer entry;
+    entry.putVarint( constant.id() );
+    entry.putVarint( internType( constant.type() ) );
+    entry.put( constant.defined() ? 1 : 0 );
+
+    if( constant.defined() )
+    {
+        switch( constant.id() )
+        {
+            case Value::VOID_CONSTANT:   // [fallthrough]
+            case Value::RANGE_CONSTANT:  // [fallthrough]
+            case Value::DOMAIN_CONSTANT:
+            {
+                break;
+            }
+            case Value::BOOLEAN_CONSTANT:
+            {
+                const auto& value = static_cast< const BooleanConstant& >( constant ).value();
+                entry.put( value == true ? 1 : 0 );
+                break;
+            }
+            case Value::INTEGER_CONSTANT:      // [fallthrough]
+            case Value::BINARY_CONSTANT:       // [fallthrough]
+            case Value::ENUMERATION_CONSTANT:
+            {
+                entry.putVarint( internString( constant.name() ) );
+                break;
+            }
+            case Value::IDENTIFIER:
+            {
+                const auto& identifier = static_cast< const Identifier& >( constant );
+                entry.putVarint( internString( identifier.toString() ) );
+                break;
+            }
+            case Value::STRING_CONSTANT:
+            {
+                const auto value = static_cast< const StringConstant& >( constant ).value();
+                entry.putVarint( internString( value ) );
+                break;
+            }
+            case Value::DECIMAL_CONSTANT:
+            {
+                // a decimal has no exact portable encoding yet, a lossy one
+                // would silently change the semantics of the specification
+                throw InternalException(
+                    "unable to serialize decimal constant '" + constant.description() +
+                    "' exactly" );
+            }
+            case Value::RULE_REFERENCE_CONSTANT:
+            {
+                const auto rule = static_cast< const RuleReferenceConstant& >( constant ).value();
+                entry.putVarint( reference( *rule ) );
+                break;
+            }
+            case Value::FUNCTION_REFERENCE_CONSTANT:
+            {
+                const auto value =
+                    static_cast< const FunctionReferenceConstant& >( constant ).value();
+                entry.putVarint( reference( *value ) );
+                break;
+            }
+            default:
+            {
+                throw InternalException(
+                    "unable to serialize unsupported constant '" + constant.description() + "'" );
+            }
+        }
+    }
+
+    const std::string key( entry.bytes().begin(), entry.bytes().end() );
+    const auto result = m_constantIndex.find( key );
+    if( result != m_constantIndex.end() )
+    {
+        return result->second;
+    }
+
+    const u64 index = m_constantOffsets.size();
+    m_constantOffsets.emplace_back( m_constants.size() );
+    m_constants.putBuffer( entry );
+
+    m_constantIndex.emplace( key, index );
+    return index;
+}
+
+u64 IRSerializer::internBuiltin( const Builtin& builtin )
+{
+    const auto result = m_builtinIndex.find( &builtin );
+    if( result != m_builtinIndex.end() )
+    {
+        return result->second;
+    }
+
+    const auto type = internType( builtin.type() );
+    m_builtins.putVarint( builtin.id() );
+    m_builtins.putVarint( type );
+
+    const u64 index = m_builtinIndex.size();
+    m_builtinIndex.emplace( &builtin, index );
+    return index;
+}
+
+u64 IRSerializer::internFunction( const Function& function )
+{
+    const auto result = m_functionIndex.find( &function );
+    if( result != m_functionIndex.end() )
+    {
+        return result->second;
+    }
+
+    const auto name = internString( function.name() );
+    const auto type = internType( function.type() );
+    m_functions.putVarint( name );
+    m_functions.putVarint( type );
+
+    const u64 index = m_functionIndex.size();
+    m_functionIndex.emplace( &function, index );
+    return index;
+}
+
+u64 IRSerializer::reference( const Value& value )
+{
+    IRBinary::Reference kind;
+    u64 index = 0;
+
+    if( isa< Instruction >( value ) )
+    {
+        const auto result = m_locals.find( &value );
+        if( result == m_locals.end() )
+        {
+            throw InternalException(
+                "unable to serialize forward or foreign reference to '" + value.dump() + "'" );
+        }
+
+        kind = IRBinary::Reference::INSTRUCTION;
+        index = result->second;
+    }
+    else if( isa< ExecutionSemanticsBlock >( value ) )
+    {
+        if( not m_statement or not isa< BranchStatement >( m_statement ) )
+        {
+            throw InternalException( "unable to serialize block reference to '" + value.dump() +
+                                     "' outside of a branch statement" );
+        }
+
+        kind = IRBinary::Reference::BLOCK;
+
+        u1 found = false;
+        for( const auto& block : m_statement->blocks() )
+        {
+            if( block.get() == &value )
+            {
+                found = true;
+                break;
+            }
+            index++;
+        }
+
+        if( not found )
+        {
+            throw InternalException(
+                "unable to serialize foreign block reference to '" + value.dump() + "'" );
+        }
+    }
+    else if( isa< Constant >( value ) )
+    {
+        kind = IRBinary::Reference::CONSTANT;
+        index = internConstant( static_cast< const Constant& >( value ) );
+    }
+    else if( isa< Builtin >( value ) )
+    {
+        kind = IRBinary::Reference::BUILTIN;
+        index = internBuiltin( static_cast< const Builtin& >( value ) );
+    }
+    else if( isa< Function >( value ) )
+    {
+        kind = IRBinary::Reference::FUNCTION;
+        index = internFunction( static_cast< const Function& >( value ) );
+    }
+    else if( isa< Derived >( value ) or isa< Rule >( value ) )
+    {
+        const auto& symbols = isa< Derived >( value ) ? m_derivedIndex : m_ruleIndex;
+        const auto result = symbols.find( &value );
+        if( result == symbols.end() )
+        {
+            throw InternalException(
+                "unable to serialize reference to '" + value.dump() +
+                "' which is not part of specification '" + m_specification->name() + "'" );
+        }
+
+        kind = isa< Derived >( value ) ? IRBinary::Reference::DERIVED : IRBinary::Reference::RULE;
+        index = result->second;
+    }
+    else
+    {
+        throw InternalException( "unable to serialize unsupported operand '" + value.dump() + "'" );
+    }
+
+    return ( index << IRBinary::REFERENCE_BITS ) | kind;
+}
+
+void IRSerializer::encode( IRBinary::Buffer& buffer, Block& block )
+{
+    buffer.putVarint( block.id() );
+
+    if( isa< ExecutionSemanticsBlock >( block ) )
+    {
+        encode( buffer, static_cast< ExecutionSemanticsBlock& >( block ) );
+    }
+    else if( isa< Statement >( block ) )
+    {
+        encode( buffer, static_cast< Statement& >( block ) );
+    }
+    else
+    {
+        throw InternalException( "unable to serialize unsupported block '" + block.dump() + "'" );
+    }
+}
+
+void IRSerializer::encode( IRBinary::Buffer& buffer, ExecutionSemanticsBlock& block )
+{
+    // the entry and exit statements are re-created by the block itself
+
+    buffer.put( block.entry() ? 0 : 1 );
+
+    buffer.putVarint( block.blocks().size() );
+    for( const auto& child : block.blocks() )
+    {
+        encode( buffer, *child );
+    }
+}
+
+void IRSerializer::encode( IRBinary::Buffer& buffer, Statement& statement )
+{
+    // inner blocks are emitted before the instructions of the statement,
+    // because the select instruction refers to them through their position
+
+    if( isa< BranchStatement >( statement ) or isa< ForallStatement >( statement ) )
+    {
+        buffer.putVarint( statement.blocks().size() );
+        for( const auto& block : statement.blocks() )
+        {
+            encode( buffer, static_cast< Block& >( *block ) );
+        }
+    }
+
+    m_statement = &statement;
+
+    buffer.putVarint( statement.instructions().size() );
+    for( const auto& instruction : statement.instructions() )
+    {
+        encode( buffer, *instruction );
+    }
+
+    // the domain of a forall statement may be one of its instructions and is
+    // therefore emitted after them
+
+    if( const auto forall = cast< ForallStatement >( statement ) )
+    {
+        if( not forall->variable() or not forall->domain() )
+        {
+            throw InternalException(
+                "unable to serialize incomplete forall statement '" + statement.dump() + "'" );
+        }
+
+        buffer.putVarint( reference( *forall->variable() ) );
+        buffer.putVarint( reference( *forall->domain() ) );
+    }
+}
+
+void IRSerializer::encode( IRBinary::Buffer& buffer, Instruction& instruction )
+{
+    buffer.putVarint( instruction.id() );
+    buffer.putVarint( internType( instruction.type() ) );
+
+    buffer.putVarint( instruction.operands().size() );
+    for( const auto& operand : instruction.operands() )
+    {
+        buffer.putVarint( reference( *operand ) );
+    }
+
+    m_locals.emplace( &instruction, m_locals.size() );
+}
+
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
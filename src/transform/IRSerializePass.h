@@ -0,0 +1,247 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#ifndef _LIBCASM_IR_IR_SERIALIZE_PASS_H_
+#define _LIBCASM_IR_IR_SERIALIZE_PASS_H_
+
+#include <libcasm-ir/Specification>
+
+#include <libpass/Pass>
+
+#include <unordered_map>
+#include <vector>
+
+/**
+   @brief    serializes the CASM IR into the binary IR format
+
+   The binary IR format consists of a fixed size header followed by the
+   string, type, constant, global and code sections. Every section is
+   addressed by an absolute offset stored in the header. The string and
+   constant sections start with an offset table to provide random access to
+   single entries. Values reference each other through indices and never
+   through pointers, therefore a binary IR file can be mapped into memory and
+   every rule body can be decoded independently.
+*/
+
+namespace libcasm_ir
+{
+    namespace IRBinary
+    {
+        static constexpr u32 MAGIC = 0x52494d43;  // "CMIR"
+
+        static constexpr u16 VERSION_MAJOR = 2;
+        static constexpr u16 VERSION_MINOR = 0;
+
+        enum Section : u8
+        {
+            STRINGS = 0,
+            TYPES,
+            CONSTANTS,
+            GLOBALS,
+            CODE,
+            _SECTION_SIZE_
+        };
+
+        static constexpr std::size_t HEADER_SIZE = 8 + ( 16 * Section::_SECTION_SIZE_ );
+
+        /**
+           tag of an index based operand reference, stored in the lower
+           REFERENCE_BITS of an encoded reference
+        */
+        enum Reference : u8
+        {
+            INSTRUCTION = 0,
+            BLOCK,
+            CONSTANT,
+            FUNCTION,
+            DERIVED,
+            BUILTIN,
+            RULE,
+            _REFERENCE_SIZE_
+        };
+
+        static constexpr u8 REFERENCE_BITS = 3;
+
+        static_assert(
+            Reference::_REFERENCE_SIZE_ <= ( 1 << REFERENCE_BITS ),
+            "length of 'IRBinary::Reference' shall fit into 'IRBinary::REFERENCE_BITS'" );
+
+        class Buffer
+        {
+          public:
+            void put( const u8 value );
+
+            void putFixed( const u64 value, const std::size_t bytes );
+
+            void putVarint( u64 value );
+
+            void putBytes( const void* data, const std::size_t size );
+
+            void putBuffer( const Buffer& buffer );
+
+            const std::vector< u8 >& bytes( void ) const;
+
+            std::size_t size( void ) const;
+
+          private:
+            std::vector< u8 > m_bytes;
+        };
+
+        class Cursor
+        {
+          public:
+            Cursor( const u8* data, const std::size_t size, const std::size_t offset = 0 );
+
+            u8 get( void );
+
+            u64 getFixed( const std::size_t bytes );
+
+            u64 getVarint( void );
+
+            /**
+               reads the number of the following entries and checks that at
+               least 'size' bytes per entry are left
+            */
+            u64 getCount( const std::size_t size = 1 );
+
+            const u8* getBytes( const std::size_t size );
+
+            void seek( const std::size_t offset );
+
+            std::size_t offset( void ) const;
+
+            std::size_t remaining( void ) const;
+
+          private:
+            const u8* m_data;
+            std::size_t m_size;
+            std::size_t m_offset;
+        };
+    }
+
+    class IRSerializePass final : public libpass::Pass
+    {
+      public:
+        static char id;
+
+        IRSerializePass( void );
+
+        void usage( libpass::PassUsage& pu ) override;
+
+        u1 run( libpass::PassResult& pr ) override;
+
+        void setPath( const std::string& path );
+
+        const std::string& path( void ) const;
+
+      private:
+        std::string m_path;
+    };
+
+    class IRSerializer
+    {
+      public:
+        IRSerializer( const Specification::Ptr& specification );
+
+        std::vector< u8 > serialize( void );
+
+      private:
+        u64 internString( const std::string& value );
+
+        u64 internType( const Type& type );
+
+        u64 internConstant( const Constant& constant );
+
+        u64 internBuiltin( const Builtin& builtin );
+
+        u64 internFunction( const Function& function );
+
+        u64 reference( const Value& value );
+
+        void encode( IRBinary::Buffer& buffer, Block& block );
+
+        void encode( IRBinary::Buffer& buffer, ExecutionSemanticsBlock& block );
+
+        void encode( IRBinary::Buffer& buffer, Statement& statement );
+
+        void encode( IRBinary::Buffer& buffer, Instruction& instruction );
+
+        const Specification::Ptr m_specification;
+
+        IRBinary::Buffer m_strings;
+        std::vector< u64 > m_stringOffsets;
+        std::unordered_map< std::string, u64 > m_stringIndex;
+
+        IRBinary::Buffer m_types;
+        std::unordered_map< const Type*, u64 > m_typeIndex;
+        std::unordered_map< std::string, u64 > m_typeRecordIndex;
+
+        IRBinary::Buffer m_constants;
+        std::vector< u64 > m_constantOffsets;
+        std::unordered_map< std::string, u64 > m_constantIndex;
+
+        IRBinary::Buffer m_builtins;
+        std::unordered_map< const Value*, u64 > m_builtinIndex;
+
+        IRBinary::Buffer m_functions;
+        std::unordered_map< const Value*, u64 > m_functionIndex;
+
+        std::unordered_map< const Value*, u64 > m_derivedIndex;
+        std::unordered_map< const Value*, u64 > m_ruleIndex;
+
+        IRBinary::Buffer m_code;
+        std::unordered_map< const Value*, u64 > m_locals;
+        Statement* m_statement;
+    };
+}
+
+#endif  // _LIBCASM_IR_IR_SERIALIZE_PASS_H_
+
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
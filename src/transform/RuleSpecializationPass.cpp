@@ -0,0 +1,759 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "RuleSpecializationPass.h"
+
+#include <libcasm-ir/Block>
+#include <libcasm-ir/Builtin>
+#include <libcasm-ir/Constant>
+#include <libcasm-ir/Exception>
+#include <libcasm-ir/Instruction>
+#include <libcasm-ir/Operation>
+#include <libcasm-ir/Statement>
+#include <libcasm-ir/analyze/ConsistencyCheckPass>
+#include <libcasm-ir/transform/BranchEliminationPass>
+
+#include <libpass/PassLogger>
+#include <libpass/PassRegistry>
+#include <libpass/PassResult>
+#include <libpass/PassUsage>
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+using namespace libcasm_ir;
+
+char RuleSpecializationPass::id = 0;
+
+const std::size_t RuleSpecializationPass::THRESHOLD;
+const std::size_t RuleSpecializationPass::BUDGET;
+
+static libpass::PassRegistration< RuleSpecializationPass > PASS(
+    "IRRuleSpecializationPass",
+    "specializes rules for frequently called constant arguments",
+    "ir-specialize",
+    0 );
+
+namespace
+{
+    /**
+       a rule together with the constant arguments of a call
+     */
+    struct CallSite
+    {
+        const Rule* rule;
+        std::vector< Constant > arguments;
+
+        u1 operator==( const CallSite& rhs ) const
+        {
+            if( rule != rhs.rule or arguments.size() != rhs.arguments.size() )
+            {
+                return false;
+            }
+
+            for( std::size_t index = 0; index < arguments.size(); index++ )
+            {
+                if( arguments[ index ] != rhs.arguments[ index ] )
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    };
+
+    struct CallSiteHash
+    {
+        std::size_t operator()( const CallSite& site ) const
+        {
+            auto hash = std::hash< const Rule* >()( site.rule );
+
+            for( const auto& argument : site.arguments )
+            {
+                hash = libstdhl::Hash::combine( hash, argument.hash() );
+            }
+
+            return hash;
+        }
+    };
+
+    /**
+       all calls of a rule with the same constant arguments
+     */
+    struct Candidate
+    {
+        Rule::Ptr rule;
+        std::vector< Value::Ptr > arguments;
+        std::vector< Instruction* > calls;
+        u64 executions;
+    };
+
+    /**
+       copies the context of a rule and substitutes its parameters by
+       constant arguments, operator instructions whose operands are all
+       constant are folded during the copy
+     */
+    class RuleCloner
+    {
+      public:
+        RuleCloner( const Rule& rule, const std::vector< Value::Ptr >& arguments )
+        : m_copies()
+        , m_folded( 0 )
+        {
+            assert( rule.parameters().size() == arguments.size() );
+
+            for( std::size_t index = 0; index < arguments.size(); index++ )
+            {
+                m_copies.emplace( rule.parameters()[ index ].get(), arguments[ index ] );
+            }
+        }
+
+        u64 folded( void ) const
+        {
+            return m_folded;
+        }
+
+        ParallelBlock::Ptr clone( ParallelBlock& context )
+        {
+            const auto block = ParallelBlock::create( not context.entry() );
+            clone( context, *block );
+            return block;
+        }
+
+        /**
+           @return number of instructions of the context of 'rule'
+         */
+        static std::size_t size( Rule& rule )
+        {
+            std::size_t size = 0;
+
+            rule.iterate< Traversal::PREORDER >( [&size]( Value& value ) {
+                if( isa< Instruction >( value ) )
+                {
+                    size++;
+                }
+            } );
+
+            return size;
+        }
+
+      private:
+        void clone( ExecutionSemanticsBlock& from, ExecutionSemanticsBlock& to )
+        {
+            for( const auto& child : from.blocks() )
+            {
+                if( isa< ExecutionSemanticsBlock >( child ) )
+                {
+                    auto& block = static_cast< ExecutionSemanticsBlock& >( *child );
+                    const auto copy = create( block );
+                    to.add( copy );
+                    clone( block, *copy );
+                }
+                else if( isa< Statement >( child ) )
+                {
+                    auto& statement = static_cast< Statement& >( *child );
+                    const auto copy = create( statement );
+                    to.add( copy );
+                    clone( statement, *copy );
+                }
+                else
+                {
+                    throw InternalException(
+                        "unable to specialize block '" + child->description() + "'" );
+                }
+            }
+        }
+
+        void clone( Statement& from, Statement& to )
+        {
+            if( not isa< TrivialStatement >( from ) )
+            {
+                for( const auto& block : from.blocks() )
+                {
+                    const auto copy = to.add( create( *block ) );
+                    m_copies.emplace( block.get(), copy );
+                    clone( *block, *copy );
+                }
+            }
+
+            for( const auto& instruction : from.instructions() )
+            {
+                std::vector< Value::Ptr > operands;
+                operands.reserve( instruction->operands().size() );
+
+                for( const auto& operand : instruction->operands() )
+                {
+                    operands.emplace_back( value( operand ) );
+                }
+
+                const auto constant = fold( *instruction, operands );
+                if( constant )
+                {
+                    m_copies.emplace( instruction.get(), constant );
+                    m_folded++;
+                    continue;
+                }
+
+                const auto copy = clone( *instruction, operands );
+                to.add( copy );
+                m_copies.emplace( instruction.get(), copy );
+            }
+
+            if( to.instructions().size() == 0 and isa< TrivialStatement >( to ) )
+            {
+                to.add< SkipInstruction >();
+            }
+
+            if( const auto forall = cast< ForallStatement >( from ) )
+            {
+                auto& copy = static_cast< ForallStatement& >( to );
+                copy.setVariable( forall->variable() );
+                copy.setDomain( value( forall->domain() ) );
+            }
+        }
+
+        Value::Ptr value( const Value::Ptr& original ) const
+        {
+            const auto copy = m_copies.find( original.get() );
+            return copy != m_copies.end() ? copy->second : original;
+        }
+
+        static ExecutionSemanticsBlock::Ptr create( const ExecutionSemanticsBlock& block )
+        {
+            if( isa< ParallelBlock >( block ) )
+            {
+                return ParallelBlock::create( not block.entry() );
+            }
+            else
+            {
+                return SequentialBlock::create( not block.entry() );
+            }
+        }
+
+        static Statement::Ptr create( const Statement& statement )
+        {
+            switch( statement.id() )
+            {
+                case Value::TRIVIAL_STATEMENT:
+                {
+                    return Arena::make< TrivialStatement >();
+                }
+                case Value::BRANCH_STATEMENT:
+                {
+                    return Arena::make< BranchStatement >();
+                }
+                case Value::FORALL_STATEMENT:
+                {
+                    return Arena::make< ForallStatement >();
+                }
+                default:
+                {
+                    break;
+                }
+            }
+
+            throw InternalException(
+                "unable to specialize statement '" + statement.description() + "'" );
+        }
+
+        /**
+           @return the constant result of 'instruction' if it is an operator
+                   instruction with defined constant operands, otherwise nullptr
+         */
+        static Value::Ptr fold(
+            const Instruction& instruction, const std::vector< Value::Ptr >& operands )
+        {
+            if( not isa< OperatorInstruction >( instruction ) )
+            {
+                return nullptr;
+            }
+
+            std::vector< Constant > values;
+            values.reserve( operands.size() );
+            Types types;
+
+            for( const auto& operand : operands )
+            {
+                if( not isa< Constant >( operand ) or isa< Identifier >( operand ) )
+                {
+                    return nullptr;
+                }
+
+                const auto& constant = static_cast< const Constant& >( *operand );
+                if( not constant.defined() or constant.symbolic() )
+                {
+                    return nullptr;
+                }
+
+                values.emplace_back( constant );
+                types.add( operand->type().ptr_type() );
+            }
+
+            const auto type =
+                libstdhl::Memory::get< RelationType >( instruction.type().ptr_type(), types );
+
+            Constant result;
+            Operation::execute( instruction.id(), type, result, values.data(), values.size() );
+            return libstdhl::Memory::make< Constant >( result );
+        }
+
+        static Instruction::Ptr clone(
+            const Instruction& instruction, const std::vector< Value::Ptr >& operands )
+        {
+            const std::vector< Value::Ptr > arguments(
+                operands.begin() + std::min< std::size_t >( 1, operands.size() ), operands.end() );
+
+            switch( instruction.id() )
+            {
+                case Value::SKIP_INSTRUCTION:
+                {
+                    return Arena::make< SkipInstruction >();
+                }
+                case Value::LOOKUP_INSTRUCTION:
+                {
+                    return Arena::make< LookupInstruction >( operands[ 0 ] );
+                }
+                case Value::UPDATE_INSTRUCTION:
+                {
+                    return Arena::make< UpdateInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::LOCAL_INSTRUCTION:
+                {
+                    return Arena::make< LocalInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::LOCATION_INSTRUCTION:
+                {
+                    return Arena::make< LocationInstruction >( operands[ 0 ], arguments );
+                }
+                case Value::CALL_INSTRUCTION:
+                {
+                    const auto& callee = operands[ 0 ];
+                    if( isa< Rule >( callee ) or isa< Derived >( callee ) or
+                        isa< Builtin >( callee ) )
+                    {
+                        return Arena::make< CallInstruction >( callee, arguments );
+                    }
+
+                    const auto copy =
+                        Arena::make< CallInstruction >( instruction.type().ptr_type() );
+                    for( const auto& operand : operands )
+                    {
+                        copy->add( operand );
+                    }
+                    return copy;
+                }
+                case Value::SELECT_INSTRUCTION:
+                {
+                    return Arena::make< SelectInstruction >( operands[ 0 ], operands );
+                }
+                case Value::SELF_INSTRUCTION:
+                {
+                    const auto copy =
+                        Arena::make< SelfInstruction >( instruction.type().ptr_type() );
+                    for( const auto& operand : operands )
+                    {
+                        copy->add( operand );
+                    }
+                    return copy;
+                }
+                case Value::INV_INSTRUCTION:
+                {
+                    return Arena::make< InvInstruction >( operands[ 0 ] );
+                }
+                case Value::ADD_INSTRUCTION:
+                {
+                    return Arena::make< AddInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::SUB_INSTRUCTION:
+                {
+                    return Arena::make< SubInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::MUL_INSTRUCTION:
+                {
+                    return Arena::make< MulInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::DIV_INSTRUCTION:
+                {
+                    return Arena::make< DivInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::POW_INSTRUCTION:
+                {
+                    return Arena::make< PowInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::MOD_INSTRUCTION:
+                {
+                    return Arena::make< ModInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::EQU_INSTRUCTION:
+                {
+                    return Arena::make< EquInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::NEQ_INSTRUCTION:
+                {
+                    return Arena::make< NeqInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::LTH_INSTRUCTION:
+                {
+                    return Arena::make< LthInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::LEQ_INSTRUCTION:
+                {
+                    return Arena::make< LeqInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::GTH_INSTRUCTION:
+                {
+                    return Arena::make< GthInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::GEQ_INSTRUCTION:
+                {
+                    return Arena::make< GeqInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::OR_INSTRUCTION:
+                {
+                    return Arena::make< OrInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::XOR_INSTRUCTION:
+                {
+                    return Arena::make< XorInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::AND_INSTRUCTION:
+                {
+                    return Arena::make< AndInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::IMP_INSTRUCTION:
+                {
+                    return Arena::make< ImpInstruction >( operands[ 0 ], operands[ 1 ] );
+                }
+                case Value::NOT_INSTRUCTION:
+                {
+                    return Arena::make< NotInstruction >( operands[ 0 ] );
+                }
+                default:
+                {
+                    break;
+                }
+            }
+
+            throw InternalException(
+                "unable to specialize instruction '" + instruction.description() + "'" );
+        }
+
+        std::unordered_map< const Value*, Value::Ptr > m_copies;
+        u64 m_folded;
+    };
+
+    /**
+       @return 'argument' as it is shown in the name of a specialization,
+               defined strings are quoted to keep the argument list readable
+     */
+    std::string display( const Value& argument )
+    {
+        const auto string = cast< StringConstant >( argument );
+        if( not string or not string->defined() )
+        {
+            return argument.name();
+        }
+
+        std::string text = "\"";
+        for( const auto character : string->value() )
+        {
+            if( character == '"' or character == '\\' )
+            {
+                text += '\\';
+            }
+            text += character;
+        }
+        return text + "\"";
+    }
+
+    /**
+       replaces 'call' in its statement by a call of 'rule' without arguments
+     */
+    void redirect( Instruction& call, const Rule::Ptr& rule )
+    {
+        const auto statement = call.statement();
+        assert( statement );
+
+        std::vector< Instruction::Ptr > instructions;
+        instructions.reserve( statement->instructions().size() );
+        for( const auto& instruction : statement->instructions() )
+        {
+            instructions.emplace_back( instruction );
+        }
+
+        statement->remove( []( const Instruction& ) { return true; } );
+
+        for( const auto& instruction : instructions )
+        {
+            if( instruction.get() != &call )
+            {
+                statement->add( instruction );
+                continue;
+            }
+
+            const auto copy = Arena::make< CallInstruction >( rule );
+            statement->add( copy );
+            instruction->replaceAllUsesWith( copy );
+        }
+    }
+}
+
+RuleSpecializationPass::RuleSpecializationPass( void )
+: m_threshold( THRESHOLD )
+, m_budget( BUDGET )
+, m_profile( nullptr )
+{
+}
+
+void RuleSpecializationPass::usage( libpass::PassUsage& pu )
+{
+    pu.require< ConsistencyCheckPass >();
+}
+
+u1 RuleSpecializationPass::run( libpass::PassResult& pr )
+{
+    libpass::PassLogger log( &id, stream() );
+
+    const auto& data = pr.input< ConsistencyCheckPass >();
+    const auto& specification = data->specification();
+
+    const auto redirected = optimize( *specification );
+
+    log.info( "redirected " + std::to_string( redirected ) + " rule calls" );
+
+    return true;
+}
+
+u64 RuleSpecializationPass::optimize( Specification& specification )
+{
+    libpass::PassLogger log( &id, stream() );
+    const Arena::Scope scope( specification.arena() ? specification.arena() : Arena::active() );
+
+    std::unordered_map< const Rule*, Rule::Ptr > rules;
+    for( const auto& rule : specification.rules() )
+    {
+        rules.emplace( rule.get(), rule );
+    }
+
+    // the candidates are kept in the order of their first call to obtain a
+    // deterministic selection for equal call counts, each call site gets its
+    // own specialization and the name of it is only used for display
+    std::unordered_map< CallSite, std::size_t, CallSiteHash > index;
+    std::vector< Candidate > candidates;
+
+    for( const auto& caller : specification.rules() )
+    {
+        caller->iterate< Traversal::PREORDER >( [&]( Value& value ) {
+            if( not isa< CallInstruction >( value ) )
+            {
+                return;
+            }
+
+            auto& call = static_cast< Instruction& >( value );
+            const auto& symbol = call.operand( 0 );
+
+            const Rule* callee = nullptr;
+            if( isa< Rule >( symbol ) )
+            {
+                callee = static_cast< const Rule* >( symbol.get() );
+            }
+            else if( isa< RuleReferenceConstant >( symbol ) )
+            {
+                const auto& reference = static_cast< const RuleReferenceConstant& >( *symbol );
+                if( reference.defined() )
+                {
+                    callee = reference.value();
+                }
+            }
+
+            const auto rule = rules.find( callee );
+            if( rule == rules.end() or rule->second->parameters().empty() or
+                rule->second->parameters().size() != call.operands().size() - 1 )
+            {
+                return;
+            }
+
+            CallSite site{ rule->first, {} };
+            std::vector< Value::Ptr > arguments;
+
+            for( std::size_t position = 1; position < call.operands().size(); position++ )
+            {
+                const auto& argument = call.operand( position );
+                if( not isa< Constant >( argument ) or isa< Identifier >( argument ) or
+                    static_cast< const Constant& >( *argument ).symbolic() )
+                {
+                    return;
+                }
+
+                site.arguments.emplace_back( static_cast< const Constant& >( *argument ) );
+                arguments.emplace_back( argument );
+            }
+
+            const auto result = index.emplace( std::move( site ), candidates.size() );
+            if( result.second )
+            {
+                candidates.emplace_back( Candidate{ rule->second, arguments, {}, 0 } );
+            }
+
+            candidates[ result.first->second ].calls.emplace_back( &call );
+        } );
+    }
+
+    if( m_profile )
+    {
+        for( auto& candidate : candidates )
+        {
+            for( const auto call : candidate.calls )
+            {
+                const auto counter = m_profile->find( *call );
+                candidate.executions += counter ? counter->executions() : 0;
+            }
+        }
+    }
+
+    std::stable_sort(
+        candidates.begin(), candidates.end(), []( const Candidate& lhs, const Candidate& rhs ) {
+            if( lhs.executions != rhs.executions )
+            {
+                return lhs.executions > rhs.executions;
+            }
+            return lhs.calls.size() > rhs.calls.size();
+        } );
+
+    std::size_t budget = m_budget;
+    u64 redirected = 0;
+
+    for( const auto& candidate : candidates )
+    {
+        if( candidate.calls.size() < m_threshold )
+        {
+            break;
+        }
+
+        if( not candidate.rule->context() )
+        {
+            continue;
+        }
+
+        std::string name = candidate.rule->name() + "<";
+        for( std::size_t position = 0; position < candidate.arguments.size(); position++ )
+        {
+            name += ( position > 0 ? ", " : "" ) + display( *candidate.arguments[ position ] );
+        }
+        name += ">";
+
+        const auto size = RuleCloner::size( *candidate.rule );
+        if( size > budget )
+        {
+            log.info( "skipping '" + name + "', exceeds the budget" );
+            continue;
+        }
+        budget -= size;
+
+        // the specialization has no parameters anymore
+        Type::Ptr ruleType = candidate.rule->type().ptr_type();
+        if( isa< RelationType >( ruleType ) )
+        {
+            ruleType = libstdhl::Memory::get< RelationType >( ruleType->ptr_result() );
+        }
+
+        RuleCloner cloner( *candidate.rule, candidate.arguments );
+        Rule::Ptr specialization = specification.add< Rule >( name, ruleType );
+        specialization->setContext( cloner.clone( *candidate.rule->context() ) );
+
+        BranchEliminationPass elimination;
+        const auto eliminated = elimination.optimize( specialization );
+
+        log.info(
+            "specialized '" + name + "', folded " + std::to_string( cloner.folded() ) +
+            " instructions and eliminated " + std::to_string( eliminated ) + " branches" );
+
+        for( const auto call : candidate.calls )
+        {
+            redirect( *call, specialization );
+            redirected++;
+        }
+    }
+
+    return redirected;
+}
+
+void RuleSpecializationPass::setThreshold( const std::size_t threshold )
+{
+    m_threshold = threshold;
+}
+
+std::size_t RuleSpecializationPass::threshold( void ) const
+{
+    return m_threshold;
+}
+
+void RuleSpecializationPass::setBudget( const std::size_t budget )
+{
+    m_budget = budget;
+}
+
+std::size_t RuleSpecializationPass::budget( void ) const
+{
+    return m_budget;
+}
+
+void RuleSpecializationPass::setProfile( const Profile* profile )
+{
+    m_profile = profile;
+}
+
+const Profile* RuleSpecializationPass::profile( void ) const
+{
+    return m_profile;
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//
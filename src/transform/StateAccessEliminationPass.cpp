@@ -0,0 +1,497 @@
+//
+//  Copyright (C) 2015-2021 CASM Organization <https://casm-lang.org>
+//  All rights reserved.
+//
+//  Developed by: Philipp Paulweber
+//                <https://github.com/casm-lang/libcasm-ir>
+//
+//  This file is part of libcasm-ir.
+//
+//  libcasm-ir is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  libcasm-ir is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with libcasm-ir. If not, see <http://www.gnu.org/licenses/>.
+//
+//  Additional permission under GNU GPL version 3 section 7
+//
+//  libcasm-ir is distributed under the terms of the GNU General Public License
+//  with the following clarification and special exception: Linking libcasm-ir
+//  statically or dynamically with other modules is making a combined work
+//  based on libcasm-ir. Thus, the terms and conditions of the GNU General
+//  Public License cover the whole combination. As a special exception,
+//  the copyright holders of libcasm-ir give you permission to link libcasm-ir
+//  with independent modules to produce an executable, regardless of the
+//  license terms of these independent modules, and to copy and distribute
+//  the resulting executable under terms of your choice, provided that you
+//  also meet, for each linked independent module, the terms and conditions
+//  of the license of that module. An independent module is a module which
+//  is not derived from or based on libcasm-ir. If you modify libcasm-ir, you
+//  may extend this exception to your version of the library, but you are
+//  not obliged to do so. If you do not wish to do so, delete this exception
+//  statement from your version.
+//
+
+#include "StateAccessEliminationPass.h"
+
+#include <libcasm-ir/Builtin>
+#include <libcasm-ir/Constant>
+#include <libcasm-ir/Specification>
+#include <libcasm-ir/analyze/ConsistencyCheckPass>
+
+#include <libpass/PassLogger>
+#include <libpass/PassRegistry>
+#include <libpass/PassResult>
+#include <libpass/PassUsage>
+
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace libcasm_ir;
+
+char StateAccessEliminationPass::id = 0;
+
+static libpass::PassRegistration< StateAccessEliminationPass > PASS(
+    "IRStateAccessEliminationPass",
+    "removes redundant lookups and overwritten updates",
+    "ir-sae",
+    0 );
+
+namespace
+{
+    /**
+       known content of a location, the update is set as long as the
+       location was updated and not observed afterwards
+     */
+    struct Access
+    {
+        const Instruction* location;
+        Value::Ptr value;
+        Instruction* update;
+        Statement* statement;
+    };
+
+    using State = std::unordered_map< const Value*, std::vector< Access > >;
+
+    struct Effects
+    {
+        std::unordered_set< const Value* > functions;
+        u1 all = false;
+
+        void merge( const Effects& other )
+        {
+            functions.insert( other.functions.begin(), other.functions.end() );
+            all = all or other.all;
+        }
+    };
+
+    /**
+       identifiers (forall variables and rule parameters) and symbolic
+       constants are constants whose value is unknown at compile-time
+     */
+    static u1 literal( const Value& value )
+    {
+        return isa< Constant >( value ) and not isa< Identifier >( value ) and
+               not isa< SymbolicConstant >( value );
+    }
+
+    static u1 equal( const Value& lhs, const Value& rhs )
+    {
+        return &lhs == &rhs or ( literal( lhs ) and literal( rhs ) and lhs == rhs );
+    }
+
+    static u1 distinct( const Value& lhs, const Value& rhs )
+    {
+        return literal( lhs ) and literal( rhs ) and not( lhs == rhs );
+    }
+
+    static u1 mustAlias( const Instruction& lhs, const Instruction& rhs )
+    {
+        if( &lhs == &rhs )
+        {
+            return true;
+        }
+
+        const auto& a = lhs.operands();
+        const auto& b = rhs.operands();
+
+        if( a.size() != b.size() or a[ 0 ] != b[ 0 ] )
+        {
+            return false;
+        }
+
+        for( std::size_t c = 1; c < a.size(); c++ )
+        {
+            if( not equal( *a[ c ], *b[ c ] ) )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static u1 mayAlias( const Instruction& lhs, const Instruction& rhs )
+    {
+        const auto& a = lhs.operands();
+        const auto& b = rhs.operands();
+
+        if( a.size() != b.size() or a[ 0 ] != b[ 0 ] )
+        {
+            return false;
+        }
+
+        for( std::size_t c = 1; c < a.size(); c++ )
+        {
+            if( distinct( *a[ c ], *b[ c ] ) )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static void observe( State& state )
+    {
+        for( auto& function : state )
+        {
+            for( auto& access : function.second )
+            {
+                access.update = nullptr;
+            }
+        }
+    }
+
+    static void kill( State& state, const Effects& effects )
+    {
+        if( effects.all )
+        {
+            state.clear();
+            return;
+        }
+
+        for( const auto function : effects.functions )
+        {
+            state.erase( function );
+        }
+    }
+
+    class Elimination
+    {
+      public:
+        Elimination( void )
+        : m_dead()
+        , m_count( 0 )
+        {
+        }
+
+        u64 count( void ) const
+        {
+            return m_count;
+        }
+
+        /**
+           the nested block starts with the known content of the outer
+           state, afterwards the outer state forgets the locations which
+           were updated in the block and all pending updates
+         */
+        void eliminate( ExecutionSemanticsBlock& block, State& outer, Effects& effects )
+        {
+            State state = outer;
+            observe( state );
+
+            Effects local;
+
+            if( block.entry() )
+            {
+                eliminate( *block.entry(), state, local );
+            }
+
+            for( const auto& child : block.blocks() )
+            {
+                if( block.parallel() )
+                {
+                    // the updates of parallel children are not visible to
+                    // their siblings
+                    State sibling = state;
+                    eliminate( *child, sibling, local );
+                }
+                else
+                {
+                    eliminate( *child, state, local );
+                }
+            }
+
+            if( block.parallel() )
+            {
+                kill( state, local );
+            }
+
+            if( block.exit() )
+            {
+                eliminate( *block.exit(), state, local );
+            }
+
+            kill( outer, local );
+            observe( outer );
+            effects.merge( local );
+        }
+
+        void eliminate( Block& block, State& state, Effects& effects )
+        {
+            if( isa< ExecutionSemanticsBlock >( block ) )
+            {
+                eliminate( static_cast< ExecutionSemanticsBlock& >( block ), state, effects );
+            }
+            else if( isa< Statement >( block ) )
+            {
+                eliminate( static_cast< Statement& >( block ), state, effects );
+            }
+        }
+
+        /**
+           lookups of a statement observe the state before the statement,
+           its updates are applied after all its instructions and blocks
+         */
+        void eliminate( Statement& statement, State& state, Effects& effects )
+        {
+            std::vector< Instruction* > updates;
+            std::unordered_set< const Instruction* > redundant;
+            u1 clobber = false;
+
+            for( const auto& instruction : statement.instructions() )
+            {
+                if( isa< LookupInstruction >( instruction ) )
+                {
+                    if( lookup( *instruction, state ) )
+                    {
+                        redundant.emplace( instruction.get() );
+                    }
+                }
+                else if( isa< UpdateInstruction >( instruction ) )
+                {
+                    if( isa< LocationInstruction >( instruction->operand( 0 ) ) )
+                    {
+                        updates.emplace_back( instruction.get() );
+                    }
+                    else
+                    {
+                        clobber = true;
+                    }
+                }
+                else if( isa< CallInstruction >( instruction ) )
+                {
+                    const auto callee = instruction->operand( 0 );
+                    if( not isa< Builtin >( callee ) )
+                    {
+                        // derived and rule calls read the state, rule calls
+                        // may additionally update any location
+                        observe( state );
+                        clobber = clobber or not isa< Derived >( callee );
+                    }
+                }
+            }
+
+            if( not redundant.empty() )
+            {
+                m_count += redundant.size();
+
+                statement.remove( [&redundant]( const Instruction& instruction ) {
+                    return redundant.count( &instruction ) > 0;
+                } );
+            }
+
+            for( const auto& block : statement.blocks() )
+            {
+                eliminate( *block, state, effects );
+            }
+
+            for( const auto update : updates )
+            {
+                apply( *update, statement, state, effects );
+            }
+
+            if( clobber )
+            {
+                state.clear();
+                effects.all = true;
+            }
+        }
+
+        /**
+           removes the overwritten updates from their statements
+         */
+        void finalize( void )
+        {
+            for( const auto& dead : m_dead )
+            {
+                const auto& updates = dead.second;
+
+                dead.first->remove( [&updates]( const Instruction& instruction ) {
+                    return updates.count( &instruction ) > 0;
+                } );
+
+                m_count += updates.size();
+            }
+
+            m_dead.clear();
+        }
+
+      private:
+        /**
+           @return true if the lookup was replaced by the known content
+         */
+        u1 lookup( Instruction& instruction, State& state )
+        {
+            const auto& location = instruction.operand( 0 );
+            if( not isa< LocationInstruction >( location ) )
+            {
+                return false;
+            }
+
+            const auto& loc = static_cast< const Instruction& >( *location );
+            auto& accesses = state[ loc.operand( 0 ).get() ];
+
+            Value::Ptr known = nullptr;
+            Access* entry = nullptr;
+
+            for( auto& access : accesses )
+            {
+                if( mustAlias( *access.location, loc ) )
+                {
+                    known = access.value;
+                    entry = &access;
+                }
+
+                if( mayAlias( *access.location, loc ) )
+                {
+                    access.update = nullptr;
+                }
+            }
+
+            if( known )
+            {
+                instruction.replaceAllUsesWith( known );
+                return true;
+            }
+
+            if( entry )
+            {
+                entry->value = instruction.ptr_this< Instruction >();
+            }
+            else
+            {
+                accesses.emplace_back(
+                    Access{ &loc, instruction.ptr_this< Instruction >(), nullptr, nullptr } );
+            }
+
+            return false;
+        }
+
+        void apply( Instruction& update, Statement& statement, State& state, Effects& effects )
+        {
+            const auto& loc = static_cast< const Instruction& >( *update.operand( 0 ) );
+            const auto function = loc.operand( 0 ).get();
+            auto& accesses = state[ function ];
+
+            for( auto access = accesses.begin(); access != accesses.end(); )
+            {
+                if( mustAlias( *access->location, loc ) )
+                {
+                    if( access->update and access->statement != &statement )
+                    {
+                        m_dead[ access->statement->ptr_this< Statement >() ].emplace(
+                            access->update );
+                    }
+
+                    access = accesses.erase( access );
+                }
+                else if( mayAlias( *access->location, loc ) )
+                {
+                    access = accesses.erase( access );
+                }
+                else
+                {
+                    ++access;
+                }
+            }
+
+            accesses.emplace_back( Access{ &loc, update.operand( 1 ), &update, &statement } );
+            effects.functions.emplace( function );
+        }
+
+        std::unordered_map< Statement::Ptr, std::unordered_set< const Instruction* > > m_dead;
+        u64 m_count;
+    };
+}
+
+void StateAccessEliminationPass::usage( libpass::PassUsage& pu )
+{
+    pu.require< ConsistencyCheckPass >();
+}
+
+u1 StateAccessEliminationPass::run( libpass::PassResult& pr )
+{
+    libpass::PassLogger log( &id, stream() );
+
+    const auto& data = pr.input< ConsistencyCheckPass >();
+    const auto& specification = data->specification();
+
+    u64 elimination = 0;
+
+    for( const auto& derived : specification->deriveds() )
+    {
+        elimination += optimize( *derived );
+    }
+
+    for( const auto& rule : specification->rules() )
+    {
+        elimination += optimize( *rule );
+    }
+
+    log.info( "eliminated " + std::to_string( elimination ) + " state accesses" );
+
+    return true;
+}
+
+u64 StateAccessEliminationPass::optimize( Rule& rule )
+{
+    Elimination elimination;
+    State state;
+    Effects effects;
+
+    elimination.eliminate( *rule.context(), state, effects );
+    elimination.finalize();
+
+    return elimination.count();
+}
+
+u64 StateAccessEliminationPass::optimize( Derived& derived )
+{
+    Elimination elimination;
+    State state;
+    Effects effects;
+
+    elimination.eliminate( *derived.context(), state, effects );
+    elimination.finalize();
+
+    return elimination.count();
+}
+
+//
+//  Local variables:
+//  mode: c++
+//  indent-tabs-mode: nil
+//  c-basic-offset: 4
+//  tab-width: 4
+//  End:
+//  vim:noexpandtab:sw=4:ts=4:
+//